@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2017-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -145,6 +145,25 @@ enum mod_clock_round_mode {
     MOD_CLOCK_ROUND_MODE_DOWN,
 };
 
+/*!
+ * \brief Maximum number of clocks in a rate transaction.
+ */
+#define MOD_CLOCK_RATE_TRANSACTION_MAX 8
+
+/*!
+ * \brief Rate change of one clock in a rate transaction.
+ */
+struct mod_clock_rate_request {
+    /*! Clock device identifier */
+    fwk_id_t clock_id;
+
+    /*! The desired frequency in Hertz */
+    uint64_t rate;
+
+    /*! The type of rounding to perform, if required, to achieve the rate */
+    enum mod_clock_round_mode round_mode;
+};
+
 /*!
  * \brief Clock module configuration data.
  */
@@ -204,6 +223,17 @@ struct mod_clock_dev_config {
      * Flag to allow clock to be set to initial rate during initialization.
      */
     bool default_on;
+
+    /*!
+     * \brief Flag indicating the rate and state of the clock can change
+     *     without a request through this module.
+     *
+     * \details The clock module keeps a copy of the last rate and state that
+     *     were set or reported by the driver and serves the get_rate() and
+     *     get_state() requests from it. When this flag is set, every request
+     *     is forwarded to the driver instead.
+     */
+    bool is_volatile;
 };
 
 /*!
@@ -429,6 +459,42 @@ struct mod_clock_drv_api {
         fwk_id_t clock_id,
         uint64_t in_rate,
         uint64_t *out_rate);
+
+    /*!
+     * \brief Signal the start of a rate transaction involving clocks of the
+     *     driver.
+     *
+     * \details The set_rate() calls that follow, up to the call to
+     *     end_rate_transaction(), belong to the same transaction. The driver
+     *     may defer the register updates of clocks sharing the same hardware
+     *     and apply them at once when the transaction ends.
+     *
+     * \note This function is optional. If it is not needed, the pointer may be
+     *     set to NULL. If it is provided, end_rate_transaction() must be
+     *     provided as well.
+     *
+     * \param clock_id Identifier of the first clock of the driver in the
+     *     transaction.
+     *
+     * \retval ::FWK_SUCCESS The operation succeeded.
+     * \return One of the standard framework error codes.
+     */
+    int (*begin_rate_transaction)(fwk_id_t clock_id);
+
+    /*!
+     * \brief Signal the end of a rate transaction involving clocks of the
+     *     driver.
+     *
+     * \details Any register update deferred since begin_rate_transaction() must
+     *     be applied before this function returns.
+     *
+     * \param clock_id Identifier of the first clock of the driver in the
+     *     transaction.
+     *
+     * \retval ::FWK_SUCCESS The operation succeeded.
+     * \return One of the standard framework error codes.
+     */
+    int (*end_rate_transaction)(fwk_id_t clock_id);
 };
 
 /*!
@@ -543,6 +609,38 @@ struct mod_clock_api {
      * \return One of the standard framework error codes.
      */
     int (*get_info)(fwk_id_t clock_id, struct mod_clock_info *info);
+
+    /*!
+     * \brief Change the rate of several clocks in a single transaction.
+     *
+     * \details The clocks are programmed parents first when they belong to
+     *     the same clock tree, whatever the order of the requests. Drivers
+     *     implementing the rate transaction functions are told about the
+     *     transaction so that they can merge the register updates of clocks
+     *     sharing the same hardware.
+     *
+     * \note Asynchronous drivers are not supported.
+     *
+     * \param requests Table of clock rate changes.
+     *
+     * \param count Number of entries in the table, at most
+     *      ::MOD_CLOCK_RATE_TRANSACTION_MAX.
+     *
+     * \retval ::FWK_SUCCESS The operation succeeded.
+     * \retval ::FWK_E_PARAM An invalid parameter was encountered:
+     *      - The `requests` parameter was a null pointer value.
+     *      - The `count` parameter was 0 or too large.
+     *      - A clock identifier was not a valid system entity identifier.
+     *      - A clock identifier appeared more than once in the table.
+     * \retval ::FWK_E_BUSY A request is on-going for one of the clocks.
+     * \retval ::FWK_E_SUPPORT The driver of one of the clocks deferred the
+     *      request.
+     * \return One of the standard framework error codes. The rate changes
+     *      after the first failure are not performed.
+     */
+    int (*set_rates)(
+        const struct mod_clock_rate_request *requests,
+        unsigned int count);
 };
 
 /*!
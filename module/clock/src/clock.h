@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2019-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2019-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -42,8 +42,26 @@ struct clock_dev_ctx {
 
         /* Cookie for the response event */
         uint32_t cookie;
+
+        /* Identifier of the request event */
+        fwk_id_t event_id;
     } request;
 
+    /* Last rate and state set or reported by the driver */
+    struct {
+        /* The cached rate is valid */
+        bool rate_valid;
+
+        /* The cached state is valid */
+        bool state_valid;
+
+        /* Clock rate in Hertz */
+        uint64_t rate;
+
+        /* Clock state */
+        enum mod_clock_state state;
+    } cache;
+
 #ifdef BUILD_HAS_CLOCK_TREE_MGMT
     /* Identifier of the clock */
     fwk_id_t id;
@@ -119,6 +137,12 @@ enum clock_state_transition_stage {
 /* Get context helper function */
 void clock_get_ctx(fwk_id_t clock_id, struct clock_dev_ctx **ctx);
 
+/* Update the cached rate of a clock */
+void clock_cache_rate(struct clock_dev_ctx *ctx, uint64_t rate);
+
+/* Update the cached state of a clock */
+void clock_cache_state(struct clock_dev_ctx *ctx, enum mod_clock_state state);
+
 /* Clock request complete function */
 void clock_request_complete(
     fwk_id_t dev_id,
@@ -136,6 +160,12 @@ int clock_management_process_rate(const struct fwk_event *event);
  */
 bool clock_is_single_node(struct clock_dev_ctx *ctx);
 
+/* Get the number of ancestors of a clock in the clock tree */
+unsigned int clock_get_depth(struct clock_dev_ctx *ctx);
+
+/* Check whether a clock is an ancestor of another clock in the clock tree */
+bool clock_is_ancestor(struct clock_dev_ctx *ctx, struct clock_dev_ctx *other);
+
 /* Connect clock tree interconnecting parent to children nodes */
 int clock_connect_tree(struct clock_ctx *module_ctx);
 #endif
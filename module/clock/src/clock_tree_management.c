@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2021-2022, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2021-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -107,6 +107,10 @@ static int clk_mgmt_complete_transition(
             "[CLOCK] Async drivers not supported with clock tree mgmt");
         return FWK_E_SUPPORT;
     }
+    if (status == FWK_SUCCESS) {
+        clock_cache_state(
+            ctx, (enum mod_clock_state)event_params->target_state);
+    }
     event_params->caller_status = status;
     return status;
 }
@@ -292,12 +296,14 @@ int clock_management_process_rate(const struct fwk_event *event)
         &ctx->children_list, c_node, struct clock_dev_ctx, child_node, child)
     {
         if (child->api->update_input_rate != NULL) {
+            child->cache.rate_valid = false;
             status = child->api->update_input_rate(
                 child->config->driver_id, in_rate, &out_rate);
             if (status != FWK_SUCCESS) {
                 return status;
             }
 
+            clock_cache_rate(child, out_rate);
             event_params->input_rate = out_rate;
             clk_mgmt_send_event_rate(event_params, child->id);
         }
@@ -311,6 +317,33 @@ bool clock_is_single_node(struct clock_dev_ctx *ctx)
         fwk_list_is_empty(&ctx->children_list);
 }
 
+unsigned int clock_get_depth(struct clock_dev_ctx *ctx)
+{
+    unsigned int depth = 0;
+    struct clock_dev_ctx *parent = ctx;
+
+    while (!fwk_id_is_equal(parent->parent_id, FWK_ID_NONE)) {
+        clock_get_ctx(parent->parent_id, &parent);
+        depth++;
+    }
+
+    return depth;
+}
+
+bool clock_is_ancestor(struct clock_dev_ctx *ctx, struct clock_dev_ctx *other)
+{
+    struct clock_dev_ctx *parent = other;
+
+    while (!fwk_id_is_equal(parent->parent_id, FWK_ID_NONE)) {
+        clock_get_ctx(parent->parent_id, &parent);
+        if (parent == ctx) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 /* Sub-routine of 'clock_start()' Build the clock tree */
 int clock_connect_tree(struct clock_ctx *module_ctx)
 {
@@ -346,6 +379,8 @@ int clock_connect_tree(struct clock_ctx *module_ctx)
             return status;
         }
 
+        clock_cache_state(clk, current_state);
+
         if (current_state != MOD_CLOCK_STATE_STOPPED) {
             parent->ref_count++;
         }
@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2017-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -15,6 +15,7 @@
 #include <fwk_event.h>
 #include <fwk_id.h>
 #include <fwk_list.h>
+#include <fwk_log.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
@@ -31,6 +32,45 @@ static struct clock_ctx mod_clock_ctx;
  * Utility functions
  */
 
+void clock_cache_rate(struct clock_dev_ctx *ctx, uint64_t rate)
+{
+    ctx->cache.rate = rate;
+    ctx->cache.rate_valid = true;
+}
+
+void clock_cache_state(struct clock_dev_ctx *ctx, enum mod_clock_state state)
+{
+    ctx->cache.state = state;
+    ctx->cache.state_valid = true;
+}
+
+/*
+ * Keep the cache in line with the value returned by an asynchronous driver.
+ * The value returned for a set request is not necessarily the one the clock
+ * ends up with, the next get request reads it back from the driver.
+ */
+static void update_cache_from_response(
+    struct clock_dev_ctx *ctx,
+    const struct mod_clock_driver_resp_params *response)
+{
+    if (fwk_id_is_equal(
+            ctx->request.event_id, mod_clock_event_id_get_rate_request) &&
+        (response->status == FWK_SUCCESS)) {
+        clock_cache_rate(ctx, response->value.rate);
+    } else if (
+        fwk_id_is_equal(
+            ctx->request.event_id, mod_clock_event_id_get_state_request) &&
+        (response->status == FWK_SUCCESS)) {
+        clock_cache_state(ctx, response->value.state);
+    } else if (fwk_id_is_equal(
+                   ctx->request.event_id,
+                   mod_clock_event_id_set_state_request)) {
+        ctx->cache.state_valid = false;
+    } else {
+        ctx->cache.rate_valid = false;
+    }
+}
+
 static int process_response_event(const struct fwk_event *event)
 {
     int status;
@@ -54,6 +94,8 @@ static int process_response_event(const struct fwk_event *event)
     resp_params->value = event_params->value;
     ctx->request.is_ongoing = false;
 
+    update_cache_from_response(ctx, event_params);
+
     return fwk_put_event(&resp_event);
 }
 
@@ -91,6 +133,7 @@ static int create_async_request(
     }
 
     ctx->request.is_ongoing = true;
+    ctx->request.event_id = event_id;
 
     /*
      * Signal the result of the request is pending and will arrive later
@@ -149,17 +192,30 @@ static struct mod_clock_driver_response_api clock_driver_response_api = {
  * Module API functions
  */
 
+#ifdef BUILD_HAS_CLOCK_TREE_MGMT
+/* Propagate the new rate of a clock to its children */
+static int clock_propagate_rate(fwk_id_t clock_id, uint64_t rate)
+{
+    struct fwk_event event;
+    struct clock_set_rate_params *event_params;
+
+    event = (struct fwk_event){
+        .target_id = clock_id,
+        .id = mod_clock_event_id_set_rate_pre_request,
+    };
+    event_params = (struct clock_set_rate_params *)event.params;
+    event_params->input_rate = rate;
+
+    return fwk_put_event(&event);
+}
+#endif
+
 static int clock_set_rate(fwk_id_t clock_id, uint64_t rate,
                           enum mod_clock_round_mode round_mode)
 {
     int status;
     struct clock_dev_ctx *ctx;
 
-#ifdef BUILD_HAS_CLOCK_TREE_MGMT
-    struct fwk_event event;
-    struct clock_set_rate_params *event_params;
-#endif
-
     clock_get_ctx(clock_id, &ctx);
 
     /* Concurrency is not supported */
@@ -167,6 +223,8 @@ static int clock_set_rate(fwk_id_t clock_id, uint64_t rate,
         return FWK_E_BUSY;
     }
 
+    ctx->cache.rate_valid = false;
+
 #ifdef BUILD_HAS_CLOCK_TREE_MGMT
 
     status = ctx->api->set_rate(ctx->config->driver_id, rate, round_mode);
@@ -174,18 +232,15 @@ static int clock_set_rate(fwk_id_t clock_id, uint64_t rate,
         return create_async_request(
             ctx, clock_id, mod_clock_event_id_set_rate_request);
     }
+    /* Without rounding, the clock runs at exactly the requested rate */
+    if ((status == FWK_SUCCESS) && (round_mode == MOD_CLOCK_ROUND_MODE_NONE)) {
+        clock_cache_rate(ctx, rate);
+    }
     if (clock_is_single_node(ctx)) {
         return status;
     }
 
-    event = (struct fwk_event){
-        .target_id = clock_id,
-        .id = mod_clock_event_id_set_rate_pre_request,
-    };
-    event_params = (struct clock_set_rate_params *)event.params;
-    event_params->input_rate = rate;
-
-    return fwk_put_event(&event);
+    return clock_propagate_rate(clock_id, rate);
 #else
     status = ctx->api->set_rate(ctx->config->driver_id, rate, round_mode);
     if (status == FWK_PENDING) {
@@ -194,6 +249,10 @@ static int clock_set_rate(fwk_id_t clock_id, uint64_t rate,
             clock_id,
             mod_clock_event_id_set_rate_request);
     }
+    /* Without rounding, the clock runs at exactly the requested rate */
+    if ((status == FWK_SUCCESS) && (round_mode == MOD_CLOCK_ROUND_MODE_NONE)) {
+        clock_cache_rate(ctx, rate);
+    }
     return status;
 #endif
 }
@@ -214,15 +273,23 @@ static int clock_get_rate(fwk_id_t clock_id, uint64_t *rate)
         return FWK_E_BUSY;
     }
 
+    if (ctx->cache.rate_valid && !ctx->config->is_volatile) {
+        *rate = ctx->cache.rate;
+        return FWK_SUCCESS;
+    }
+
     status = ctx->api->get_rate(ctx->config->driver_id, rate);
     if (status == FWK_PENDING) {
         return create_async_request(
             ctx,
             clock_id,
             mod_clock_event_id_get_rate_request);
-    } else {
-        return status;
     }
+    if (status == FWK_SUCCESS) {
+        clock_cache_rate(ctx, *rate);
+    }
+
+    return status;
 }
 
 static int clock_get_rate_from_index(fwk_id_t clock_id, unsigned int rate_index,
@@ -261,12 +328,17 @@ static int clock_set_state(fwk_id_t clock_id, enum mod_clock_state state)
         return FWK_E_BUSY;
     }
 
+    ctx->cache.state_valid = false;
+
     if (clock_is_single_node(ctx)) {
         status = ctx->api->set_state(ctx->config->driver_id, state);
         if (status == FWK_PENDING) {
             return create_async_request(
                 ctx, clock_id, mod_clock_event_id_set_state_request);
         }
+        if (status == FWK_SUCCESS) {
+            clock_cache_state(ctx, state);
+        }
         return status;
     }
 
@@ -289,11 +361,16 @@ static int clock_set_state(fwk_id_t clock_id, enum mod_clock_state state)
     }
     return FWK_PENDING;
 #else
+    ctx->cache.state_valid = false;
+
     status = ctx->api->set_state(ctx->config->driver_id, state);
     if (status == FWK_PENDING) {
         return create_async_request(
             ctx, clock_id, mod_clock_event_id_set_state_request);
     }
+    if (status == FWK_SUCCESS) {
+        clock_cache_state(ctx, state);
+    }
     return status;
 #endif
 }
@@ -314,15 +391,23 @@ static int clock_get_state(fwk_id_t clock_id, enum mod_clock_state *state)
         return FWK_E_BUSY;
     }
 
+    if (ctx->cache.state_valid && !ctx->config->is_volatile) {
+        *state = ctx->cache.state;
+        return FWK_SUCCESS;
+    }
+
     status = ctx->api->get_state(ctx->config->driver_id, state);
     if (status == FWK_PENDING) {
         return create_async_request(
             ctx,
             clock_id,
             mod_clock_event_id_get_state_request);
-    } else {
-        return status;
     }
+    if (status == FWK_SUCCESS) {
+        clock_cache_state(ctx, *state);
+    }
+
+    return status;
 }
 
 static int clock_get_info(fwk_id_t clock_id, struct mod_clock_info *info)
@@ -346,6 +431,163 @@ static int clock_get_info(fwk_id_t clock_id, struct mod_clock_info *info)
     return FWK_SUCCESS;
 }
 
+/*
+ * Call the rate transaction function of each driver involved in a transaction
+ * once, with the first clock of the driver in the transaction.
+ */
+static int clock_notify_rate_transaction(
+    const struct mod_clock_rate_request *requests,
+    const unsigned int *order,
+    unsigned int count,
+    bool begin)
+{
+    int status = FWK_SUCCESS;
+    int drv_status;
+    unsigned int i, j;
+    struct clock_dev_ctx *ctx;
+    struct clock_dev_ctx *prev_ctx;
+    int (*transaction_fn)(fwk_id_t clock_id);
+
+    for (i = 0; i < count; i++) {
+        clock_get_ctx(requests[order[i]].clock_id, &ctx);
+
+        for (j = 0; j < i; j++) {
+            clock_get_ctx(requests[order[j]].clock_id, &prev_ctx);
+            if (prev_ctx->api == ctx->api) {
+                break;
+            }
+        }
+        if (j < i) {
+            /* The driver has already been notified */
+            continue;
+        }
+
+        transaction_fn = begin ? ctx->api->begin_rate_transaction :
+                                 ctx->api->end_rate_transaction;
+        if (transaction_fn == NULL) {
+            continue;
+        }
+
+        drv_status = transaction_fn(ctx->config->driver_id);
+        if (status == FWK_SUCCESS) {
+            status = drv_status;
+        }
+    }
+
+    return status;
+}
+
+static int clock_set_rates(
+    const struct mod_clock_rate_request *requests,
+    unsigned int count)
+{
+    int status;
+    int end_status;
+    unsigned int i, j;
+    unsigned int order[MOD_CLOCK_RATE_TRANSACTION_MAX];
+    struct clock_dev_ctx *ctx;
+#ifdef BUILD_HAS_CLOCK_TREE_MGMT
+    unsigned int depth[MOD_CLOCK_RATE_TRANSACTION_MAX];
+    unsigned int idx;
+    struct clock_dev_ctx *other;
+#endif
+
+    if ((requests == NULL) || (count == 0) ||
+        (count > MOD_CLOCK_RATE_TRANSACTION_MAX)) {
+        return FWK_E_PARAM;
+    }
+
+    for (i = 0; i < count; i++) {
+        if (!fwk_module_is_valid_element_id(requests[i].clock_id)) {
+            return FWK_E_PARAM;
+        }
+
+        /* A clock can only be programmed once per transaction */
+        for (j = 0; j < i; j++) {
+            if (fwk_id_is_equal(requests[j].clock_id, requests[i].clock_id)) {
+                return FWK_E_PARAM;
+            }
+        }
+
+        clock_get_ctx(requests[i].clock_id, &ctx);
+
+        /* Concurrency is not supported */
+        if (ctx->request.is_ongoing) {
+            return FWK_E_BUSY;
+        }
+
+        order[i] = i;
+
+#ifdef BUILD_HAS_CLOCK_TREE_MGMT
+        depth[i] = clock_get_depth(ctx);
+
+        /* Program the parents before their children */
+        for (j = i; (j > 0) && (depth[order[j - 1]] > depth[i]); j--) {
+            order[j] = order[j - 1];
+        }
+        order[j] = i;
+#endif
+    }
+
+    status = clock_notify_rate_transaction(requests, order, count, true);
+
+    for (i = 0; (i < count) && (status == FWK_SUCCESS); i++) {
+        clock_get_ctx(requests[order[i]].clock_id, &ctx);
+
+        ctx->cache.rate_valid = false;
+
+        status = ctx->api->set_rate(
+            ctx->config->driver_id,
+            requests[order[i]].rate,
+            requests[order[i]].round_mode);
+        if (status == FWK_PENDING) {
+            FWK_LOG_WARN(
+                "[CLOCK] Async drivers not supported with rate transactions");
+            status = FWK_E_SUPPORT;
+        } else if (
+            (status == FWK_SUCCESS) &&
+            (requests[order[i]].round_mode == MOD_CLOCK_ROUND_MODE_NONE)) {
+            clock_cache_rate(ctx, requests[order[i]].rate);
+        }
+    }
+
+    /* Let the drivers apply the deferred updates even after a failure */
+    end_status = clock_notify_rate_transaction(requests, order, count, false);
+    if (status == FWK_SUCCESS) {
+        status = end_status;
+    }
+
+#ifdef BUILD_HAS_CLOCK_TREE_MGMT
+    /*
+     * Only the topmost clocks of the transaction propagate their rate, the
+     * propagation reaches the other clocks of the transaction through them.
+     */
+    for (i = 0; (i < count) && (status == FWK_SUCCESS); i++) {
+        idx = order[i];
+        clock_get_ctx(requests[idx].clock_id, &ctx);
+
+        if (fwk_list_is_empty(&ctx->children_list)) {
+            continue;
+        }
+
+        for (j = 0; j < i; j++) {
+            clock_get_ctx(requests[order[j]].clock_id, &other);
+            if (clock_is_ancestor(other, ctx)) {
+                break;
+            }
+        }
+        if (j < i) {
+            continue;
+        }
+
+        status =
+            clock_propagate_rate(requests[idx].clock_id, requests[idx].rate);
+    }
+#endif
+
+    return status;
+}
+
 static const struct mod_clock_api clock_api = {
     .set_rate = clock_set_rate,
     .get_rate = clock_get_rate,
@@ -353,6 +595,7 @@ static const struct mod_clock_api clock_api = {
     .set_state = clock_set_state,
     .get_state = clock_get_state,
     .get_info = clock_get_info,
+    .set_rates = clock_set_rates,
 };
 
 /*
@@ -637,6 +880,10 @@ static int clock_process_pd_transition_notification(
     status = ctx->api->process_power_transition(
         ctx->config->driver_id, pd_params->state);
 
+    /* The driver may have reprogrammed the clock along with its domain */
+    ctx->cache.rate_valid = false;
+    ctx->cache.state_valid = false;
+
     if (status != FWK_SUCCESS) {
         return status;
     }
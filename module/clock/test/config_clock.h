@@ -0,0 +1,38 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2024, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <mod_clock.h>
+
+#include <fwk_element.h>
+#include <fwk_id.h>
+#include <fwk_module_idx.h>
+
+enum clock_idx {
+    CLOCK_IDX_CLK0,
+    CLOCK_IDX_CLK1,
+    CLOCK_IDX_COUNT,
+};
+
+static const struct fwk_element clock_element_table[] = {
+    [CLOCK_IDX_CLK0] = {
+        .name = "CLK0",
+        .data = &((struct mod_clock_dev_config) {
+            .driver_id = FWK_ID_ELEMENT_INIT(
+                FWK_MODULE_IDX_FAKE_DRIVER, CLOCK_IDX_CLK0),
+            .api_id = FWK_ID_API_INIT(FWK_MODULE_IDX_FAKE_DRIVER, 0),
+        }),
+    },
+    [CLOCK_IDX_CLK1] = {
+        .name = "CLK1",
+        .data = &((struct mod_clock_dev_config) {
+            .driver_id = FWK_ID_ELEMENT_INIT(
+                FWK_MODULE_IDX_FAKE_DRIVER, CLOCK_IDX_CLK1),
+            .api_id = FWK_ID_API_INIT(FWK_MODULE_IDX_FAKE_DRIVER, 0),
+        }),
+    },
+    [CLOCK_IDX_COUNT] = { 0 },
+};
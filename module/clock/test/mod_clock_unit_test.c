@@ -0,0 +1,200 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2024, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "scp_unity.h"
+#include "unity.h"
+
+#include <Mockfwk_module.h>
+
+#include <mod_clock.h>
+
+#include <fwk_element.h>
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_module_idx.h>
+
+#include <string.h>
+
+#include UNIT_TEST_SRC
+#include "config_clock.h"
+
+#define CLOCK_ID(idx) FWK_ID_ELEMENT(FWK_MODULE_IDX_CLOCK, idx)
+
+/* Driver calls, recorded in order */
+enum driver_call {
+    DRIVER_CALL_BEGIN,
+    DRIVER_CALL_SET_RATE_CLK0,
+    DRIVER_CALL_SET_RATE_CLK1,
+    DRIVER_CALL_END,
+};
+
+static enum driver_call driver_calls[8];
+static unsigned int driver_call_count;
+
+static struct clock_dev_ctx dev_ctx_table[CLOCK_IDX_COUNT];
+
+static void record_driver_call(enum driver_call call)
+{
+    TEST_ASSERT_LESS_THAN(FWK_ARRAY_SIZE(driver_calls), driver_call_count);
+    driver_calls[driver_call_count++] = call;
+}
+
+static int fake_set_rate(
+    fwk_id_t clock_id,
+    uint64_t rate,
+    enum mod_clock_round_mode round_mode)
+{
+    record_driver_call(
+        (fwk_id_get_element_idx(clock_id) == CLOCK_IDX_CLK0) ?
+            DRIVER_CALL_SET_RATE_CLK0 :
+            DRIVER_CALL_SET_RATE_CLK1);
+
+    return FWK_SUCCESS;
+}
+
+static int fake_begin_rate_transaction(fwk_id_t clock_id)
+{
+    record_driver_call(DRIVER_CALL_BEGIN);
+
+    return FWK_SUCCESS;
+}
+
+static int fake_end_rate_transaction(fwk_id_t clock_id)
+{
+    record_driver_call(DRIVER_CALL_END);
+
+    return FWK_SUCCESS;
+}
+
+static struct mod_clock_drv_api fake_driver_api = {
+    .set_rate = fake_set_rate,
+    .begin_rate_transaction = fake_begin_rate_transaction,
+    .end_rate_transaction = fake_end_rate_transaction,
+};
+
+static bool is_valid_element_id_callback(fwk_id_t id, int cmock_num_calls)
+{
+    return fwk_id_get_element_idx(id) < CLOCK_IDX_COUNT;
+}
+
+void setUp(void)
+{
+    unsigned int clock_idx;
+
+    memset(dev_ctx_table, 0, sizeof(dev_ctx_table));
+    mod_clock_ctx.dev_ctx_table = dev_ctx_table;
+    mod_clock_ctx.dev_count = CLOCK_IDX_COUNT;
+
+    for (clock_idx = 0; clock_idx < CLOCK_IDX_COUNT; clock_idx++) {
+        dev_ctx_table[clock_idx].config = clock_element_table[clock_idx].data;
+        dev_ctx_table[clock_idx].api = &fake_driver_api;
+    }
+
+    driver_call_count = 0;
+
+    fwk_module_is_valid_element_id_Stub(is_valid_element_id_callback);
+}
+
+void tearDown(void)
+{
+    Mockfwk_module_Destroy();
+}
+
+void test_clock_set_rates(void)
+{
+    int status;
+    struct mod_clock_rate_request requests[] = {
+        {
+            .clock_id = CLOCK_ID(CLOCK_IDX_CLK0),
+            .rate = 100 * FWK_MHZ,
+            .round_mode = MOD_CLOCK_ROUND_MODE_NONE,
+        },
+        {
+            .clock_id = CLOCK_ID(CLOCK_IDX_CLK1),
+            .rate = 200 * FWK_MHZ,
+            .round_mode = MOD_CLOCK_ROUND_MODE_NONE,
+        },
+    };
+
+    status = clock_set_rates(requests, FWK_ARRAY_SIZE(requests));
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+
+    /* The driver of both clocks is told about the transaction once */
+    TEST_ASSERT_EQUAL(4, driver_call_count);
+    TEST_ASSERT_EQUAL(DRIVER_CALL_BEGIN, driver_calls[0]);
+    TEST_ASSERT_EQUAL(DRIVER_CALL_SET_RATE_CLK0, driver_calls[1]);
+    TEST_ASSERT_EQUAL(DRIVER_CALL_SET_RATE_CLK1, driver_calls[2]);
+    TEST_ASSERT_EQUAL(DRIVER_CALL_END, driver_calls[3]);
+
+    TEST_ASSERT_TRUE(dev_ctx_table[CLOCK_IDX_CLK0].cache.rate_valid);
+    TEST_ASSERT_EQUAL_UINT64(
+        100 * FWK_MHZ, dev_ctx_table[CLOCK_IDX_CLK0].cache.rate);
+    TEST_ASSERT_TRUE(dev_ctx_table[CLOCK_IDX_CLK1].cache.rate_valid);
+    TEST_ASSERT_EQUAL_UINT64(
+        200 * FWK_MHZ, dev_ctx_table[CLOCK_IDX_CLK1].cache.rate);
+}
+
+void test_clock_set_rates_duplicate_clock(void)
+{
+    int status;
+    struct mod_clock_rate_request requests[] = {
+        {
+            .clock_id = CLOCK_ID(CLOCK_IDX_CLK0),
+            .rate = 100 * FWK_MHZ,
+        },
+        {
+            .clock_id = CLOCK_ID(CLOCK_IDX_CLK1),
+            .rate = 200 * FWK_MHZ,
+        },
+        {
+            .clock_id = CLOCK_ID(CLOCK_IDX_CLK0),
+            .rate = 300 * FWK_MHZ,
+        },
+    };
+
+    status = clock_set_rates(requests, FWK_ARRAY_SIZE(requests));
+    TEST_ASSERT_EQUAL(FWK_E_PARAM, status);
+    TEST_ASSERT_EQUAL(0, driver_call_count);
+}
+
+void test_clock_set_rates_invalid_param(void)
+{
+    int status;
+    struct mod_clock_rate_request request = {
+        .clock_id = CLOCK_ID(CLOCK_IDX_CLK0),
+        .rate = 100 * FWK_MHZ,
+    };
+
+    status = clock_set_rates(NULL, 1);
+    TEST_ASSERT_EQUAL(FWK_E_PARAM, status);
+
+    status = clock_set_rates(&request, 0);
+    TEST_ASSERT_EQUAL(FWK_E_PARAM, status);
+
+    status = clock_set_rates(&request, MOD_CLOCK_RATE_TRANSACTION_MAX + 1);
+    TEST_ASSERT_EQUAL(FWK_E_PARAM, status);
+
+    TEST_ASSERT_EQUAL(0, driver_call_count);
+}
+
+int clock_test_main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_clock_set_rates);
+    RUN_TEST(test_clock_set_rates_duplicate_clock);
+    RUN_TEST(test_clock_set_rates_invalid_param);
+
+    return UNITY_END();
+}
+
+#if !defined(TEST_ON_TARGET)
+int main(void)
+{
+    return clock_test_main();
+}
+#endif
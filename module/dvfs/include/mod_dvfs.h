@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2017-2021, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -12,6 +12,7 @@
 #include <fwk_macros.h>
 #include <fwk_module_idx.h>
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -36,6 +37,93 @@ struct mod_dvfs_opp {
     uint32_t power; /*!< Power draw in milliwatts (mW) */
 };
 
+/*!
+ * \brief Number of buckets of the transition latency histograms.
+ */
+#define MOD_DVFS_LATENCY_BUCKET_COUNT 17
+
+/*!
+ * \brief Steps of an operating point transition.
+ */
+enum mod_dvfs_transition_phase {
+    /*! Reading the voltage of the power supply */
+    MOD_DVFS_PHASE_GET_VOLTAGE,
+
+    /*! Setting the voltage of the power supply */
+    MOD_DVFS_PHASE_SET_VOLTAGE,
+
+    /*! Setting the clock rate */
+    MOD_DVFS_PHASE_SET_FREQUENCY,
+
+    /*! Number of phases */
+    MOD_DVFS_PHASE_COUNT,
+};
+
+/*!
+ * \brief Directions of an operating point transition.
+ */
+enum mod_dvfs_transition_dir {
+    /*! Transition to a higher level */
+    MOD_DVFS_TRANSITION_UP,
+
+    /*! Transition to a lower level */
+    MOD_DVFS_TRANSITION_DOWN,
+
+    /*! Number of directions */
+    MOD_DVFS_TRANSITION_DIR_COUNT,
+};
+
+/*!
+ * \brief Latency statistics.
+ */
+struct mod_dvfs_latency_stats {
+    /*! Number of measurements */
+    uint32_t count;
+
+    /*! Moving average of the latency in microseconds */
+    uint32_t avg_us;
+
+    /*! Maximum latency in microseconds */
+    uint32_t max_us;
+};
+
+/*!
+ * \brief Transition latency statistics of a domain.
+ */
+struct mod_dvfs_transition_stats {
+    /*! Statistics of each phase of the transitions */
+    struct mod_dvfs_latency_stats phase[MOD_DVFS_PHASE_COUNT];
+
+    /*! Statistics of the complete transitions in each direction */
+    struct mod_dvfs_latency_stats transition[MOD_DVFS_TRANSITION_DIR_COUNT];
+
+    /*!
+     * \brief Log2 histogram of the complete transitions in each direction.
+     *
+     * \details Bucket \c n counts the transitions that took between
+     *      <tt>2^(n-1)</tt> and <tt>2^n</tt> microseconds. Bucket 0 counts
+     *      the transitions of less than one microsecond and the last bucket
+     *      also counts all the slower transitions.
+     */
+    uint32_t histogram[MOD_DVFS_TRANSITION_DIR_COUNT]
+                      [MOD_DVFS_LATENCY_BUCKET_COUNT];
+
+    /*!
+     * \brief Number of requests replaced by a later request before they were
+     *      started.
+     */
+    uint32_t requests_merged;
+
+    /*!
+     * \brief Number of requests discarded because they matched the pending or
+     *      current operating point.
+     */
+    uint32_t requests_dropped;
+
+    /*! Number of requests delayed by the rate limits of the domain */
+    uint32_t requests_deferred;
+};
+
 /*!
  * \}
  */
@@ -66,16 +154,62 @@ struct mod_dvfs_domain_config {
     /*!
      * \brief Alarm identifier.
      *
+     * \details Required when \c retry_ms, \c min_dwell_ms or
+     *      \c max_transition_rate is not zero.
+     *
      * \warning This identifier must refer to an alarm of the \c timer module.
      */
     fwk_id_t alarm_id;
 
+#ifdef BUILD_HAS_MOD_POWER_DOMAIN
+    /*!
+     * \brief Power domain identifier.
+     *
+     * \details Optional. When defined, the cached voltage of the domain is
+     *      dropped on each transition of this power domain, and the voltage
+     *      is read back from the power supply by the next request.
+     *
+     * \warning This identifier must refer to an element of the
+     *      \c power_domain module.
+     */
+    fwk_optional_id_t pd_id;
+#endif
+
     /*! Delay in milliseconds before retrying a request */
     uint16_t retry_ms;
 
     /*! Worst-case transition latency in microseconds */
     uint16_t latency;
 
+    /*!
+     * \brief Report the measured transition latency.
+     *
+     * \details When true, the 99th percentile of the measured transition
+     *      latencies is reported instead of \c latency once transitions have
+     *      been measured. The framework time driver is required.
+     */
+    bool report_measured_latency;
+
+    /*!
+     * \brief Minimum time in milliseconds spent at an operating point before
+     *      the next transition starts.
+     *
+     * \details Zero if no minimum applies. Requests received in the meantime
+     *      are merged and only the latest one is started once the time has
+     *      elapsed. The framework time driver is required.
+     */
+    uint16_t min_dwell_ms;
+
+    /*!
+     * \brief Maximum number of transitions started per second.
+     *
+     * \details Zero if unlimited. Bursts of up to this number of transitions
+     *      are allowed. Requests exceeding the rate are merged and only the
+     *      latest one is started once allowed. The framework time driver is
+     *      required.
+     */
+    uint16_t max_transition_rate;
+
     /*! Sustained operating point index */
     size_t sustained_idx;
 
@@ -164,6 +298,35 @@ struct mod_dvfs_domain_api {
      * \param level Requested level.
      */
     int (*set_level)(fwk_id_t domain_id, uintptr_t cookie, uint32_t level);
+
+    /*!
+     * \brief Get the transition latency statistics of a domain.
+     *
+     * \param domain_id Element identifier of the domain.
+     * \param [out] stats Transition latency statistics.
+     *
+     * \retval ::FWK_SUCCESS The statistics have been returned.
+     * \retval ::FWK_E_PARAM An invalid parameter was encountered.
+     */
+    int (*get_transition_stats)(
+        fwk_id_t domain_id,
+        struct mod_dvfs_transition_stats *stats);
+
+    /*!
+     * \brief Invalidate the cached voltage of a domain.
+     *
+     * \details The voltage applied by the DVFS module is cached to avoid
+     *      reading it back from the power supply on each transition. This
+     *      function must be called when the voltage of the domain may have
+     *      changed without the DVFS module being involved. Domains with a
+     *      \c pd_id are invalidated on each power domain transition.
+     *
+     * \param domain_id Element identifier of the domain.
+     *
+     * \retval ::FWK_SUCCESS The cached voltage has been invalidated.
+     * \retval ::FWK_E_PARAM The domain identifier is not valid.
+     */
+    int (*invalidate_opp)(fwk_id_t domain_id);
 };
 
 /*!
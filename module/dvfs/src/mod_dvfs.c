@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2017-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -11,16 +11,24 @@
 #include <mod_scmi_perf.h>
 #include <mod_timer.h>
 
+#ifdef BUILD_HAS_MOD_POWER_DOMAIN
+#    include <mod_power_domain.h>
+#endif
+
 #include <fwk_assert.h>
 #include <fwk_core.h>
 #include <fwk_event.h>
 #include <fwk_id.h>
 #include <fwk_interrupt.h>
 #include <fwk_log.h>
+#include <fwk_macros.h>
+#include <fwk_math.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
+#include <fwk_notification.h>
 #include <fwk_status.h>
+#include <fwk_time.h>
 
 #include <stdbool.h>
 
@@ -29,6 +37,11 @@
  */
 #define DVFS_MAX_RETRIES 4
 
+/*
+ * Weight of the previous average in the moving average of the latencies
+ */
+#define DVFS_LATENCY_AVG_WEIGHT 8
+
 enum mod_dvfs_internal_event_idx {
     /* retry request */
     MOD_DVFS_INTERNAL_EVENT_IDX_RETRY = MOD_DVFS_EVENT_IDX_COUNT,
@@ -111,9 +124,45 @@ struct mod_dvfs_domain_ctx {
     /* Number of operating points */
     size_t opp_count;
 
+    /* Operating points are sorted by strictly increasing level */
+    bool opps_sorted;
+
+    /* Operating points are sorted by increasing voltage */
+    bool voltages_sorted;
+
+    /* Distance between two consecutive levels if they are evenly spaced */
+    uint32_t level_step;
+
     /* Current operating point */
     struct mod_dvfs_opp current_opp;
 
+    /* Last voltage read from or applied to the power supply */
+    uint32_t voltage;
+
+    /* The cached voltage matches the power supply */
+    bool voltage_valid;
+
+    /* Next domain supplied by the same power supply, this domain if none */
+    struct mod_dvfs_domain_ctx *next_rail_domain;
+
+    /* Voltage of the power supply for the request in progress */
+    uint32_t rail_voltage;
+
+    /* Start of the transition in progress */
+    fwk_timestamp_t transition_timestamp;
+
+    /* Start of the current phase of the transition in progress */
+    fwk_timestamp_t phase_timestamp;
+
+    /* Transition latency statistics */
+    struct mod_dvfs_transition_stats stats;
+
+    /* End of the last transition, from which the dwell time is counted */
+    fwk_timestamp_t opp_timestamp;
+
+    /* Start of the next transition if they were evenly spaced at max rate */
+    fwk_timestamp_t rate_timestamp;
+
     /* Current request details */
     struct mod_dvfs_request request;
 
@@ -169,44 +218,391 @@ static size_t count_opps(const struct mod_dvfs_opp *opps)
     return (size_t)(opp - &opps[0]);
 }
 
+/*
+ * Inspect the operating points of a domain to select how they are looked up.
+ * The operating points are usually given by increasing level and voltage, in
+ * which case they are bisected. Evenly spaced levels are indexed directly.
+ */
+static void init_opp_lookup(struct mod_dvfs_domain_ctx *ctx)
+{
+    const struct mod_dvfs_opp *opps = ctx->config->opps;
+    uint32_t step;
+    size_t opp_idx;
+
+    ctx->opps_sorted = true;
+    ctx->voltages_sorted = true;
+
+    for (opp_idx = 1; opp_idx < ctx->opp_count; opp_idx++) {
+        if (opps[opp_idx].level <= opps[opp_idx - 1].level) {
+            ctx->opps_sorted = false;
+        }
+
+        if (opps[opp_idx].voltage < opps[opp_idx - 1].voltage) {
+            ctx->voltages_sorted = false;
+        }
+    }
+
+    ctx->level_step = 0;
+
+    if (!ctx->opps_sorted || (ctx->opp_count < 2)) {
+        return;
+    }
+
+    step = opps[1].level - opps[0].level;
+
+    for (opp_idx = 2; opp_idx < ctx->opp_count; opp_idx++) {
+        if ((opps[opp_idx].level - opps[opp_idx - 1].level) != step) {
+            return;
+        }
+    }
+
+    ctx->level_step = step;
+}
+
+static bool find_level_idx(
+    const struct mod_dvfs_domain_ctx *ctx,
+    uint32_t level,
+    size_t *level_idx)
+{
+    const struct mod_dvfs_opp *opps = ctx->config->opps;
+    size_t low, high, mid;
+    uint32_t offset;
+
+    if (ctx->level_step != 0) {
+        if (level < opps[0].level) {
+            return false;
+        }
+
+        offset = level - opps[0].level;
+        if ((offset % ctx->level_step) != 0) {
+            return false;
+        }
+
+        mid = offset / ctx->level_step;
+        if (mid >= ctx->opp_count) {
+            return false;
+        }
+
+        *level_idx = mid;
+        return true;
+    }
+
+    if (!ctx->opps_sorted) {
+        for (mid = 0; mid < ctx->opp_count; mid++) {
+            if (opps[mid].level == level) {
+                *level_idx = mid;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    low = 0;
+    high = ctx->opp_count;
+
+    while (low < high) {
+        mid = low + ((high - low) / 2);
+
+        if (opps[mid].level < level) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    if ((low == ctx->opp_count) || (opps[low].level != level)) {
+        return false;
+    }
+
+    *level_idx = low;
+    return true;
+}
+
 static const struct mod_dvfs_opp *get_opp_for_level(
     const struct mod_dvfs_domain_ctx *ctx,
     uint32_t level)
 {
-    const struct mod_dvfs_opp *opp;
     size_t opp_idx;
 
-    for (opp_idx = 0; opp_idx < ctx->opp_count; opp_idx++) {
-        opp = &ctx->config->opps[opp_idx];
+    if (!find_level_idx(ctx, level, &opp_idx)) {
+        return NULL;
+    }
+
+    return &ctx->config->opps[opp_idx];
+}
 
-        if (opp->level != level) {
-            continue;
+static const struct mod_dvfs_opp *get_opp_for_voltage(
+    const struct mod_dvfs_domain_ctx *ctx,
+    uint32_t voltage)
+{
+    const struct mod_dvfs_opp *opps = ctx->config->opps;
+    size_t low, high, mid;
+
+    if (!ctx->voltages_sorted) {
+        for (mid = 0; mid < ctx->opp_count; mid++) {
+            if (opps[mid].voltage == voltage) {
+                return &opps[mid];
+            }
+        }
+
+        return NULL;
+    }
+
+    /* Several operating points may share a voltage, the first one is used */
+    low = 0;
+    high = ctx->opp_count;
+
+    while (low < high) {
+        mid = low + ((high - low) / 2);
+
+        if (opps[mid].voltage < voltage) {
+            low = mid + 1;
+        } else {
+            high = mid;
         }
+    }
 
-        return opp;
+    if ((low == ctx->opp_count) || (opps[low].voltage != voltage)) {
+        return NULL;
     }
 
-    return NULL;
+    return &opps[low];
 }
 
-static const struct mod_dvfs_opp *get_opp_for_voltage(
+/*
+ * DVFS is the only writer of the voltage of its power supply, so the voltage
+ * can be trusted once it has been read or successfully applied. The cache is
+ * dropped when a power supply request fails or is still in progress.
+ */
+static void dvfs_update_voltage_cache(
+    struct mod_dvfs_domain_ctx *ctx,
+    int status,
+    uint32_t voltage)
+{
+    struct mod_dvfs_domain_ctx *member = ctx;
+
+    /* The cache is shared by all the domains of a power supply */
+    do {
+        member->voltage = voltage;
+        member->voltage_valid = (status == FWK_SUCCESS);
+        member = member->next_rail_domain;
+    } while ((member != NULL) && (member != ctx));
+}
+
+static void dvfs_invalidate_voltage_cache(struct mod_dvfs_domain_ctx *ctx)
+{
+    struct mod_dvfs_domain_ctx *member = ctx;
+
+    do {
+        member->voltage_valid = false;
+        member = member->next_rail_domain;
+    } while ((member != NULL) && (member != ctx));
+}
+
+/*
+ * Domains supplied by the same power supply are linked in a ring so their
+ * transitions can be coordinated.
+ */
+static void dvfs_rail_init(struct mod_dvfs_domain_ctx *ctx)
+{
+    struct mod_dvfs_domain_ctx *other;
+    unsigned int idx;
+
+    ctx->next_rail_domain = ctx;
+
+    for (idx = 0; idx < fwk_id_get_element_idx(ctx->domain_id); idx++) {
+        other = &(*dvfs_ctx.domain_ctx)[idx];
+
+        if (fwk_id_is_equal(other->config->psu_id, ctx->config->psu_id)) {
+            ctx->next_rail_domain = other->next_rail_domain;
+            other->next_rail_domain = ctx;
+            return;
+        }
+    }
+}
+
+/*
+ * Only one domain of a power supply can be in a transition at a time, the
+ * requests of the other domains are kept pending until it completes.
+ */
+static bool dvfs_rail_is_busy(const struct mod_dvfs_domain_ctx *ctx)
+{
+    const struct mod_dvfs_domain_ctx *member;
+
+    for (member = ctx->next_rail_domain; (member != NULL) && (member != ctx);
+         member = member->next_rail_domain) {
+        if ((member->state != DVFS_DOMAIN_STATE_IDLE) &&
+            (member->state != DVFS_DOMAIN_STATE_RETRY)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Voltage of the power supply needed by the request in progress. The power
+ * supply must also satisfy the current and pending operating points of the
+ * other domains it supplies. Raising it to the highest voltage of the pending
+ * requests at once allows them to only change their frequency afterwards.
+ */
+static uint32_t dvfs_get_rail_voltage(
     const struct mod_dvfs_domain_ctx *ctx,
     uint32_t voltage)
 {
-    size_t opp_idx;
-    const struct mod_dvfs_opp *opp;
+    const struct mod_dvfs_domain_ctx *member;
+    uint32_t rail_voltage = ctx->request.new_opp.voltage;
+
+    for (member = ctx->next_rail_domain; (member != NULL) && (member != ctx);
+         member = member->next_rail_domain) {
+        if (member->current_opp.voltage == 0) {
+            /* Unknown operating point, the voltage must not be decreased */
+            rail_voltage = FWK_MAX(rail_voltage, voltage);
+        }
+
+        rail_voltage = FWK_MAX(rail_voltage, member->current_opp.voltage);
+
+        if (member->request_pending) {
+            rail_voltage =
+                FWK_MAX(rail_voltage, member->pending_request.new_opp.voltage);
+        }
+    }
+
+    return rail_voltage;
+}
+
+/*
+ * Transition latency measurement. The timestamps are all zero when no time
+ * driver is available.
+ */
+static uint32_t dvfs_elapsed_us(fwk_timestamp_t start, fwk_timestamp_t now)
+{
+    fwk_duration_us_t elapsed_us;
+
+    if (now <= start) {
+        return 0;
+    }
 
-    for (opp_idx = 0; opp_idx < ctx->opp_count; opp_idx++) {
-        opp = &ctx->config->opps[opp_idx];
+    elapsed_us = fwk_time_duration_us(fwk_time_duration(start, now));
 
-        if (opp->voltage != voltage) {
+    return (uint32_t)FWK_MIN(elapsed_us, (fwk_duration_us_t)UINT32_MAX);
+}
+
+static unsigned int dvfs_latency_bucket(uint32_t latency_us)
+{
+    unsigned int bucket;
+
+    if (latency_us == 0) {
+        return 0;
+    }
+
+    bucket = fwk_math_log2(latency_us) + 1u;
+
+    return FWK_MIN(bucket, MOD_DVFS_LATENCY_BUCKET_COUNT - 1u);
+}
+
+static void dvfs_latency_stats_update(
+    struct mod_dvfs_latency_stats *stats,
+    uint32_t latency_us)
+{
+    if (stats->count == 0) {
+        stats->avg_us = latency_us;
+    } else if (latency_us > stats->avg_us) {
+        stats->avg_us += (latency_us - stats->avg_us) / DVFS_LATENCY_AVG_WEIGHT;
+    } else {
+        stats->avg_us -= (stats->avg_us - latency_us) / DVFS_LATENCY_AVG_WEIGHT;
+    }
+
+    stats->max_us = FWK_MAX(stats->max_us, latency_us);
+
+    if (stats->count < UINT32_MAX) {
+        stats->count++;
+    }
+}
+
+static void dvfs_stats_count(uint32_t *counter)
+{
+    if (*counter < UINT32_MAX) {
+        (*counter)++;
+    }
+}
+
+static void dvfs_transition_start(struct mod_dvfs_domain_ctx *ctx)
+{
+    ctx->transition_timestamp = fwk_time_current();
+    ctx->phase_timestamp = ctx->transition_timestamp;
+}
+
+static void dvfs_phase_end(
+    struct mod_dvfs_domain_ctx *ctx,
+    enum mod_dvfs_transition_phase phase)
+{
+    fwk_timestamp_t now = fwk_time_current();
+
+    dvfs_latency_stats_update(
+        &ctx->stats.phase[phase], dvfs_elapsed_us(ctx->phase_timestamp, now));
+
+    ctx->phase_timestamp = now;
+}
+
+/*
+ * The SET_OPP() request has completed successfully.
+ */
+static void dvfs_set_opp_done(struct mod_dvfs_domain_ctx *ctx)
+{
+    enum mod_dvfs_transition_dir dir;
+    uint32_t latency_us;
+
+    dir = (ctx->request.new_opp.level >= ctx->current_opp.level) ?
+        MOD_DVFS_TRANSITION_UP :
+        MOD_DVFS_TRANSITION_DOWN;
+
+    ctx->opp_timestamp = fwk_time_current();
+    latency_us = dvfs_elapsed_us(ctx->transition_timestamp, ctx->opp_timestamp);
+
+    dvfs_latency_stats_update(&ctx->stats.transition[dir], latency_us);
+
+    dvfs_stats_count(
+        &ctx->stats.histogram[dir][dvfs_latency_bucket(latency_us)]);
+
+    ctx->current_opp = ctx->request.new_opp;
+}
+
+/*
+ * 99th percentile of the measured transition latencies in both directions. The
+ * result is the upper bound of the histogram bucket holding the percentile,
+ * and zero if no transition has been measured.
+ */
+static uint32_t dvfs_get_measured_latency(const struct mod_dvfs_domain_ctx *ctx)
+{
+    const struct mod_dvfs_latency_stats *stats;
+    uint32_t latency_us = 0;
+    uint32_t threshold, total;
+    unsigned int dir, bucket;
+
+    for (dir = 0; dir < MOD_DVFS_TRANSITION_DIR_COUNT; dir++) {
+        stats = &ctx->stats.transition[dir];
+        if (stats->max_us == 0) {
             continue;
         }
 
-        return opp;
+        threshold = stats->count - (stats->count / 100u);
+        total = 0;
+
+        for (bucket = 0; bucket < (MOD_DVFS_LATENCY_BUCKET_COUNT - 1u);
+             bucket++) {
+            total += ctx->stats.histogram[dir][bucket];
+            if (total >= threshold) {
+                break;
+            }
+        }
+
+        latency_us = FWK_MAX(
+            latency_us, FWK_MIN((uint32_t)(1u << bucket), stats->max_us));
     }
 
-    return NULL;
+    return latency_us;
 }
 
 /*
@@ -241,6 +637,135 @@ static void dvfs_cleanup_request(struct mod_dvfs_domain_ctx *ctx)
     ctx->state = DVFS_DOMAIN_STATE_IDLE;
 }
 
+static void alarm_callback(uintptr_t param)
+{
+    struct mod_dvfs_domain_ctx *ctx = (struct mod_dvfs_domain_ctx *)param;
+    struct fwk_event_light req;
+    int status;
+
+    req = (struct fwk_event_light){
+        .target_id = ctx->domain_id,
+        .source_id = ctx->domain_id,
+        .id = mod_dvfs_event_id_retry,
+        .response_requested = ctx->pending_request.response_required,
+    };
+
+    status = fwk_put_event(&req);
+    if (status != FWK_SUCCESS) {
+        FWK_LOG_DEBUG("[DVFS] %s @%d", __func__, __LINE__);
+    }
+}
+
+/*
+ * Rate limiting. A transition starts once the domain has dwelt at its current
+ * operating point for the minimum time, and as long as the transitions stay
+ * within the maximum rate. The rate timestamp is the start of the next
+ * transition if they were evenly spaced at the maximum rate. It may run ahead
+ * of the current time by a burst of transitions.
+ *
+ * The timestamps are all zero when no time driver is available, in which case
+ * no limit is enforced.
+ */
+static uint32_t dvfs_rate_limit_delay_ms(
+    const struct mod_dvfs_domain_ctx *ctx,
+    fwk_timestamp_t now)
+{
+    const struct mod_dvfs_domain_config *config = ctx->config;
+    fwk_timestamp_t start = now;
+    fwk_duration_ns_t interval, burst;
+
+    if (now == 0) {
+        return 0;
+    }
+
+    if ((config->min_dwell_ms > 0) && (ctx->opp_timestamp != 0)) {
+        start =
+            FWK_MAX(start, ctx->opp_timestamp + FWK_MS(config->min_dwell_ms));
+    }
+
+    if (config->max_transition_rate > 0) {
+        interval = FWK_S(1) / config->max_transition_rate;
+        burst = interval * (config->max_transition_rate - 1u);
+
+        if (ctx->rate_timestamp > burst) {
+            start = FWK_MAX(start, ctx->rate_timestamp - burst);
+        }
+    }
+
+    if (start <= now) {
+        return 0;
+    }
+
+    /* Round up so that the transition is allowed once the alarm fires */
+    return (uint32_t)((start - now + FWK_MS(1) - 1u) / FWK_MS(1));
+}
+
+static void dvfs_rate_limit_account(
+    struct mod_dvfs_domain_ctx *ctx,
+    fwk_timestamp_t now)
+{
+    if ((ctx->config->max_transition_rate == 0) || (now == 0)) {
+        return;
+    }
+
+    ctx->rate_timestamp = FWK_MAX(ctx->rate_timestamp, now) +
+        (FWK_S(1) / ctx->config->max_transition_rate);
+}
+
+/*
+ * Delay a request that would exceed the rate limits of the domain. The request
+ * becomes the pending request, which later requests replace, and is started
+ * by the retry event once the alarm fires.
+ */
+static bool dvfs_rate_limit_defer(
+    struct mod_dvfs_domain_ctx *ctx,
+    uintptr_t cookie,
+    const struct mod_dvfs_opp *new_opp,
+    bool retry_request,
+    uint8_t num_retries)
+{
+    int status;
+    uint32_t delay_ms;
+    fwk_timestamp_t now;
+
+    if ((ctx->config->min_dwell_ms == 0) &&
+        (ctx->config->max_transition_rate == 0)) {
+        return false;
+    }
+
+    now = fwk_time_current();
+    delay_ms = dvfs_rate_limit_delay_ms(ctx, now);
+
+    if (delay_ms > 0) {
+        status = ctx->apis.alarm_api->start(
+            ctx->config->alarm_id,
+            delay_ms,
+            MOD_TIMER_ALARM_TYPE_ONCE,
+            alarm_callback,
+            (uintptr_t)ctx);
+        if (status == FWK_SUCCESS) {
+            ctx->pending_request = (struct mod_dvfs_request){
+                .new_opp = *new_opp,
+                .cookie = cookie,
+                .retry_request = retry_request,
+                .num_retries = num_retries,
+            };
+            ctx->request_pending = true;
+            ctx->state = DVFS_DOMAIN_STATE_RETRY;
+            dvfs_stats_count(&ctx->stats.requests_deferred);
+
+            return true;
+        }
+
+        /* Rather than losing the request, start it right away */
+        FWK_LOG_DEBUG("[DVFS] %s @%d", __func__, __LINE__);
+    }
+
+    dvfs_rate_limit_account(ctx, now);
+
+    return false;
+}
+
 static int dvfs_set_level_start(
     struct mod_dvfs_domain_ctx *ctx,
     uintptr_t cookie,
@@ -261,6 +786,11 @@ static int dvfs_set_level_start(
         return FWK_SUCCESS;
     }
 
+    if (dvfs_rate_limit_defer(
+            ctx, cookie, new_opp, retry_request, num_retries)) {
+        return FWK_SUCCESS;
+    }
+
     ctx->request.cookie = cookie, ctx->request.new_opp = *new_opp;
     ctx->request.retry_request = retry_request;
     ctx->request.response_required = false;
@@ -279,38 +809,49 @@ static int dvfs_set_level_start(
 static void dvfs_flush_pending_request(struct mod_dvfs_domain_ctx *ctx)
 {
     int status;
+    struct mod_dvfs_request request = ctx->pending_request;
+
+    /* Cleared first, the request may be deferred again */
+    ctx->pending_request = (struct mod_dvfs_request){ 0 };
 
     if (ctx->request_pending) {
         ctx->request_pending = false;
         status = dvfs_set_level_start(
             ctx,
-            ctx->pending_request.cookie,
-            &ctx->pending_request.new_opp,
-            ctx->pending_request.retry_request,
-            ctx->pending_request.num_retries);
+            request.cookie,
+            &request.new_opp,
+            request.retry_request,
+            request.num_retries);
         if (status != FWK_SUCCESS) {
             FWK_LOG_DEBUG("[DVFS] %s @%d", __func__, __LINE__);
         }
     }
-    ctx->pending_request = (struct mod_dvfs_request){ 0 };
 }
 
-static void alarm_callback(uintptr_t param)
+/*
+ * Start the pending request of another domain of the power supply, once the
+ * power supply is no longer used by this domain.
+ */
+static void dvfs_rail_flush_pending_request(struct mod_dvfs_domain_ctx *ctx)
 {
-    struct mod_dvfs_domain_ctx *ctx = (struct mod_dvfs_domain_ctx *)param;
-    struct fwk_event_light req;
-    int status;
+    struct mod_dvfs_domain_ctx *member;
 
-    req = (struct fwk_event_light){
-        .target_id = ctx->domain_id,
-        .source_id = ctx->domain_id,
-        .id = mod_dvfs_event_id_retry,
-        .response_requested = ctx->pending_request.response_required,
-    };
+    if ((ctx->state != DVFS_DOMAIN_STATE_IDLE) &&
+        (ctx->state != DVFS_DOMAIN_STATE_RETRY)) {
+        return;
+    }
 
-    status = fwk_put_event(&req);
-    if (status != FWK_SUCCESS) {
-        FWK_LOG_DEBUG("[DVFS] %s @%d", __func__, __LINE__);
+    for (member = ctx->next_rail_domain; (member != NULL) && (member != ctx);
+         member = member->next_rail_domain) {
+        if (!member->request_pending ||
+            (member->state != DVFS_DOMAIN_STATE_IDLE)) {
+            continue;
+        }
+
+        dvfs_flush_pending_request(member);
+        if (member->state != DVFS_DOMAIN_STATE_IDLE) {
+            return;
+        }
     }
 }
 
@@ -351,11 +892,16 @@ static void dvfs_create_pending_level_request(
     if (ctx->request_pending) {
         if ((new_opp->frequency == ctx->pending_request.new_opp.frequency) &&
             (new_opp->voltage == ctx->pending_request.new_opp.voltage)) {
+            dvfs_stats_count(&ctx->stats.requests_dropped);
             return;
         }
+
+        /* The latest request replaces the pending one */
+        dvfs_stats_count(&ctx->stats.requests_merged);
     } else {
         if ((new_opp->frequency == ctx->current_opp.frequency) &&
             (new_opp->voltage == ctx->current_opp.voltage)) {
+            dvfs_stats_count(&ctx->stats.requests_dropped);
             return;
         }
 
@@ -430,27 +976,17 @@ static int dvfs_get_level_id(
     size_t *level_id)
 {
     const struct mod_dvfs_domain_ctx *ctx;
-    size_t idx;
 
     ctx = get_domain_ctx(domain_id);
     if (ctx == NULL) {
         return FWK_E_PARAM;
     }
 
-    /*
-     * When the setup code forces platform to provide frequency array
-     * sorted, then this code can be changed to bisect search in order
-     * to speed-up.
-     */
-    for (idx = 0; idx < ctx->opp_count; idx++) {
-        const struct mod_dvfs_opp *opp = &ctx->config->opps[idx];
-        if (opp->level == level) {
-            *level_id = idx;
-            return FWK_SUCCESS;
-        }
+    if (!find_level_idx(ctx, level, level_id)) {
+        return FWK_E_PARAM;
     }
 
-    return FWK_E_PARAM;
+    return FWK_SUCCESS;
 }
 
 static int dvfs_get_opp_count(fwk_id_t domain_id, size_t *opp_count)
@@ -474,6 +1010,7 @@ static int dvfs_get_opp_count(fwk_id_t domain_id, size_t *opp_count)
 static int dvfs_get_latency(fwk_id_t domain_id, uint16_t *latency)
 {
     const struct mod_dvfs_domain_ctx *ctx;
+    uint32_t measured_latency;
 
     if (latency == NULL) {
         return FWK_E_PARAM;
@@ -486,6 +1023,34 @@ static int dvfs_get_latency(fwk_id_t domain_id, uint16_t *latency)
 
     *latency = ctx->config->latency;
 
+    if (ctx->config->report_measured_latency) {
+        measured_latency = dvfs_get_measured_latency(ctx);
+        if (measured_latency != 0) {
+            *latency =
+                (uint16_t)FWK_MIN(measured_latency, (uint32_t)UINT16_MAX);
+        }
+    }
+
+    return FWK_SUCCESS;
+}
+
+static int dvfs_get_transition_stats(
+    fwk_id_t domain_id,
+    struct mod_dvfs_transition_stats *stats)
+{
+    const struct mod_dvfs_domain_ctx *ctx;
+
+    if (stats == NULL) {
+        return FWK_E_PARAM;
+    }
+
+    ctx = get_domain_ctx(domain_id);
+    if (ctx == NULL) {
+        return FWK_E_PARAM;
+    }
+
+    *stats = ctx->stats;
+
     return FWK_SUCCESS;
 }
 
@@ -513,7 +1078,7 @@ static int dvfs_get_current_opp(fwk_id_t domain_id, struct mod_dvfs_opp *opp)
         return FWK_SUCCESS;
     }
 
-    if (ctx->state != DVFS_DOMAIN_STATE_IDLE) {
+    if ((ctx->state != DVFS_DOMAIN_STATE_IDLE) || dvfs_rail_is_busy(ctx)) {
         return FWK_E_BUSY;
     }
 
@@ -551,7 +1116,7 @@ static int dvfs_set_level(fwk_id_t domain_id, uintptr_t cookie, uint32_t level)
         return FWK_E_RANGE;
     }
 
-    if (ctx->state != DVFS_DOMAIN_STATE_IDLE) {
+    if ((ctx->state != DVFS_DOMAIN_STATE_IDLE) || dvfs_rail_is_busy(ctx)) {
         dvfs_create_pending_level_request(ctx, cookie, new_opp, false);
 
         return FWK_SUCCESS;
@@ -569,6 +1134,21 @@ static int dvfs_set_level(fwk_id_t domain_id, uintptr_t cookie, uint32_t level)
     return dvfs_set_level_start(ctx, cookie, new_opp, false, 0);
 }
 
+static int dvfs_invalidate_opp(fwk_id_t domain_id)
+{
+    struct mod_dvfs_domain_ctx *ctx;
+
+    ctx = get_domain_ctx(domain_id);
+    if (ctx == NULL) {
+        return FWK_E_PARAM;
+    }
+
+    /* The next request reads the voltage back from the power supply */
+    dvfs_invalidate_voltage_cache(ctx);
+
+    return FWK_SUCCESS;
+}
+
 static const struct mod_dvfs_domain_api dvfs_domain_api = {
     .get_current_opp = dvfs_get_current_opp,
     .get_sustained_opp = dvfs_get_sustained_opp,
@@ -577,6 +1157,8 @@ static const struct mod_dvfs_domain_api dvfs_domain_api = {
     .get_opp_count = dvfs_get_opp_count,
     .get_latency = dvfs_get_latency,
     .set_level = dvfs_set_level,
+    .get_transition_stats = dvfs_get_transition_stats,
+    .invalidate_opp = dvfs_invalidate_opp,
 };
 
 /*
@@ -687,9 +1269,41 @@ static int dvfs_complete(
         dvfs_cleanup_request(ctx);
     }
 
+    dvfs_rail_flush_pending_request(ctx);
+
     return req_status;
 }
 
+static int dvfs_set_voltage(struct mod_dvfs_domain_ctx *ctx)
+{
+    int status;
+
+    status = ctx->apis.psu->set_voltage(ctx->config->psu_id, ctx->rail_voltage);
+    dvfs_update_voltage_cache(ctx, status, ctx->rail_voltage);
+
+    if (status == FWK_SUCCESS) {
+        dvfs_phase_end(ctx, MOD_DVFS_PHASE_SET_VOLTAGE);
+    }
+
+    return status;
+}
+
+static int dvfs_set_frequency(struct mod_dvfs_domain_ctx *ctx)
+{
+    int status;
+
+    status = ctx->apis.clock->set_rate(
+        ctx->config->clock_id,
+        (uint64_t)ctx->request.new_opp.frequency * FWK_KHZ,
+        MOD_CLOCK_ROUND_MODE_NONE);
+
+    if (status == FWK_SUCCESS) {
+        dvfs_phase_end(ctx, MOD_DVFS_PHASE_SET_FREQUENCY);
+    }
+
+    return status;
+}
+
 /*
  * The SET_OPP() request has successfully completed the first step,
  * reading the voltage.
@@ -700,12 +1314,13 @@ static int dvfs_handle_set_opp(
 {
     int status = FWK_SUCCESS;
 
-    if (ctx->request.new_opp.voltage > voltage) {
+    ctx->rail_voltage = dvfs_get_rail_voltage(ctx, voltage);
+
+    if (ctx->rail_voltage > voltage) {
         /*
          * Current < request, increase voltage then set frequency
          */
-        status = ctx->apis.psu->set_voltage(
-            ctx->config->psu_id, ctx->request.new_opp.voltage);
+        status = dvfs_set_voltage(ctx);
 
         if (status == FWK_PENDING) {
             ctx->state = DVFS_DOMAIN_SET_FREQUENCY;
@@ -719,23 +1334,17 @@ static int dvfs_handle_set_opp(
         /*
          * Voltage set successsfully, continue to set the frequency
          */
-        status = ctx->apis.clock->set_rate(
-            ctx->config->clock_id,
-            (uint64_t)ctx->request.new_opp.frequency * FWK_KHZ,
-            MOD_CLOCK_ROUND_MODE_NONE);
+        status = dvfs_set_frequency(ctx);
 
         if (status == FWK_PENDING) {
             ctx->state = DVFS_DOMAIN_SET_OPP_DONE;
             return status;
         }
-    } else if (ctx->request.new_opp.voltage < voltage) {
+    } else if (ctx->rail_voltage < voltage) {
         /*
          * Current > request, decrease frequency then set voltage
          */
-        status = ctx->apis.clock->set_rate(
-            ctx->config->clock_id,
-            (uint64_t)ctx->request.new_opp.frequency * FWK_KHZ,
-            MOD_CLOCK_ROUND_MODE_NONE);
+        status = dvfs_set_frequency(ctx);
 
         if (status == FWK_PENDING) {
             ctx->state = DVFS_DOMAIN_SET_VOLTAGE;
@@ -749,23 +1358,20 @@ static int dvfs_handle_set_opp(
         /*
          * Clock set_rate() completed successfully, continue to set_voltage()
          */
-        status = ctx->apis.psu->set_voltage(
-            ctx->config->psu_id, ctx->request.new_opp.voltage);
+        status = dvfs_set_voltage(ctx);
 
         if (status == FWK_PENDING) {
             ctx->state = DVFS_DOMAIN_SET_OPP_DONE;
             return status;
         }
-    } else if (ctx->current_opp.frequency == 0) {
+    } else if (ctx->current_opp.frequency != ctx->request.new_opp.frequency) {
         /*
-         * At startup the voltage may be set without the frequency having
-         * been set. In this case we must set the frequency regardless of
-         * the voltage.
+         * The power supply already provides the requested voltage. This is
+         * the case at startup when the voltage was set without the frequency
+         * having been set, or when the power supply is shared with another
+         * domain requiring a higher voltage. Only the frequency is set.
          */
-        status = ctx->apis.clock->set_rate(
-            ctx->config->clock_id,
-            (uint64_t)ctx->request.new_opp.frequency * FWK_KHZ,
-            MOD_CLOCK_ROUND_MODE_NONE);
+        status = dvfs_set_frequency(ctx);
 
         if (status == FWK_PENDING) {
             ctx->state = DVFS_DOMAIN_SET_OPP_DONE;
@@ -777,7 +1383,7 @@ static int dvfs_handle_set_opp(
      * SET_OPP() completed, return to caller.
      */
     if (status == FWK_SUCCESS) {
-        ctx->current_opp = ctx->request.new_opp;
+        dvfs_set_opp_done(ctx);
     }
 
     return dvfs_complete(ctx, NULL, status);
@@ -797,6 +1403,8 @@ static int dvfs_handle_psu_get_voltage_resp(
 {
     const struct mod_dvfs_opp *opp;
 
+    dvfs_update_voltage_cache(ctx, req_status, voltage);
+
     if (req_status != FWK_SUCCESS) {
         return dvfs_complete(ctx, resp_event, req_status);
     }
@@ -839,15 +1447,16 @@ static int dvfs_handle_psu_set_voltage_resp(
     struct mod_psu_driver_response *psu_response =
         (struct mod_psu_driver_response *)event->params;
 
+    dvfs_update_voltage_cache(ctx, psu_response->status, ctx->rail_voltage);
+
     if (psu_response->status != FWK_SUCCESS) {
         return dvfs_complete(ctx, NULL, psu_response->status);
     }
 
+    dvfs_phase_end(ctx, MOD_DVFS_PHASE_SET_VOLTAGE);
+
     if (ctx->state == DVFS_DOMAIN_SET_FREQUENCY) {
-        status = ctx->apis.clock->set_rate(
-            ctx->config->clock_id,
-            (uint64_t)ctx->request.new_opp.frequency * FWK_KHZ,
-            MOD_CLOCK_ROUND_MODE_NONE);
+        status = dvfs_set_frequency(ctx);
         if (status == FWK_PENDING) {
             ctx->state = DVFS_DOMAIN_SET_OPP_DONE;
             return status;
@@ -862,7 +1471,7 @@ static int dvfs_handle_psu_set_voltage_resp(
      * SET_OPP() completed, return to caller.
      */
     if (status == FWK_SUCCESS) {
-        ctx->current_opp = ctx->request.new_opp;
+        dvfs_set_opp_done(ctx);
     }
 
     return dvfs_complete(ctx, NULL, status);
@@ -884,12 +1493,13 @@ static int dvfs_handle_clk_set_freq_resp(
         return dvfs_complete(ctx, NULL, clock_response->status);
     }
 
+    dvfs_phase_end(ctx, MOD_DVFS_PHASE_SET_FREQUENCY);
+
     if (ctx->state == DVFS_DOMAIN_SET_VOLTAGE) {
         /*
          * Clock set_rate() completed successfully, continue to set_voltage()
          */
-        status = ctx->apis.psu->set_voltage(
-            ctx->config->psu_id, ctx->request.new_opp.voltage);
+        status = dvfs_set_voltage(ctx);
         if (status == FWK_PENDING) {
             ctx->state = DVFS_DOMAIN_SET_OPP_DONE;
             return status;
@@ -905,7 +1515,7 @@ static int dvfs_handle_clk_set_freq_resp(
      * SET_OPP() completed, return to caller.
      */
     if (status == FWK_SUCCESS) {
-        ctx->current_opp = ctx->request.new_opp;
+        dvfs_set_opp_done(ctx);
     }
 
     return dvfs_complete(ctx, NULL, status);
@@ -922,6 +1532,7 @@ static int mod_dvfs_process_event(
     int status;
     struct mod_dvfs_domain_ctx *ctx;
     struct mod_psu_driver_response *psu_response;
+    struct mod_dvfs_request request;
     uint32_t voltage;
 
     ctx = get_domain_ctx(event->target_id);
@@ -936,6 +1547,7 @@ static int mod_dvfs_process_event(
         status = ctx->apis.psu->get_voltage(
             ctx->config->psu_id, &ctx->request.new_opp.voltage);
         if (status == FWK_PENDING) {
+            ctx->voltage_valid = false;
             ctx->cookie = event->cookie;
             resp_event->is_delayed_response = true;
             return FWK_SUCCESS;
@@ -956,14 +1568,21 @@ static int mod_dvfs_process_event(
      * local DVFS event from dvfs_set_level()
      */
     if (fwk_id_is_equal(event->id, mod_dvfs_event_id_set)) {
-        if (ctx->current_opp.voltage != 0) {
-            voltage = ctx->current_opp.voltage;
+        dvfs_transition_start(ctx);
+
+        if (ctx->voltage_valid) {
+            voltage = ctx->voltage;
             status = FWK_SUCCESS;
         } else {
             status = ctx->apis.psu->get_voltage(ctx->config->psu_id, &voltage);
             if (status == FWK_PENDING) {
+                ctx->voltage_valid = false;
                 return FWK_SUCCESS;
             }
+
+            if (status == FWK_SUCCESS) {
+                dvfs_phase_end(ctx, MOD_DVFS_PHASE_GET_VOLTAGE);
+            }
         }
 
         /*
@@ -981,16 +1600,22 @@ static int mod_dvfs_process_event(
      * dvfs_handle_pending_request() fires
      */
     if (fwk_id_is_equal(event->id, mod_dvfs_event_id_retry)) {
+        if (dvfs_rail_is_busy(ctx)) {
+            /* Started once the power supply is no longer in use */
+            ctx->state = DVFS_DOMAIN_STATE_IDLE;
+            return FWK_SUCCESS;
+        }
+
         ctx->request.set_source_id = false;
+        request = ctx->pending_request;
+        ctx->pending_request = (struct mod_dvfs_request){ 0 };
         ctx->request_pending = false;
-        status = dvfs_set_level_start(
+        return dvfs_set_level_start(
             ctx,
-            ctx->pending_request.cookie,
-            &ctx->pending_request.new_opp,
-            ctx->pending_request.retry_request,
-            ctx->pending_request.num_retries);
-        ctx->pending_request = (struct mod_dvfs_request){ 0 };
-        return status;
+            request.cookie,
+            &request.new_opp,
+            request.retry_request,
+            request.num_retries);
     }
 
     /*
@@ -1002,6 +1627,11 @@ static int mod_dvfs_process_event(
          * above so we can safely discard the resp_event.
          */
         psu_response = (struct mod_psu_driver_response *)event->params;
+        if ((ctx->state == DVFS_DOMAIN_SET_OPP) &&
+            (psu_response->status == FWK_SUCCESS)) {
+            dvfs_phase_end(ctx, MOD_DVFS_PHASE_GET_VOLTAGE);
+        }
+
         status = dvfs_handle_psu_get_voltage_resp(
             ctx, NULL, psu_response->status, psu_response->voltage);
         if (status == FWK_PENDING) {
@@ -1057,9 +1687,32 @@ static int dvfs_start(fwk_id_t id)
         return FWK_SUCCESS;
     }
 
+#ifdef BUILD_HAS_MOD_POWER_DOMAIN
+    /*
+     * The voltage of the domain may change behind DVFS while the power domain
+     * transitions, so the cached voltage is dropped on each transition.
+     */
+    ctx = get_domain_ctx(id);
+    if (fwk_optional_id_is_defined(ctx->config->pd_id)) {
+        status = fwk_notification_subscribe(
+            mod_pd_notification_id_power_state_transition,
+            ctx->config->pd_id,
+            id);
+        if (status != FWK_SUCCESS) {
+            return status;
+        }
+    }
+#endif
+
     status = dvfs_get_sustained_opp(id, &sustained_opp);
     if (status == FWK_SUCCESS) {
         ctx = get_domain_ctx(id);
+
+        if (dvfs_rail_is_busy(ctx)) {
+            dvfs_create_pending_level_request(ctx, 0, &sustained_opp, true);
+            return FWK_SUCCESS;
+        }
+
         ctx->request.set_source_id = true;
         status = dvfs_set_level_start(ctx, 0, &sustained_opp, true, 0);
     }
@@ -1067,6 +1720,30 @@ static int dvfs_start(fwk_id_t id)
     return status;
 }
 
+#ifdef BUILD_HAS_MOD_POWER_DOMAIN
+static int dvfs_process_notification(
+    const struct fwk_event *event,
+    struct fwk_event *resp_event)
+{
+    struct mod_dvfs_domain_ctx *ctx;
+
+    if (!fwk_id_is_equal(
+            event->id, mod_pd_notification_id_power_state_transition)) {
+        return FWK_E_PARAM;
+    }
+
+    ctx = get_domain_ctx(event->target_id);
+    if (ctx == NULL) {
+        return FWK_E_PARAM;
+    }
+
+    /* The next request reads the voltage back from the power supply */
+    dvfs_invalidate_voltage_cache(ctx);
+
+    return FWK_SUCCESS;
+}
+#endif
+
 static int dvfs_init(
     fwk_id_t module_id,
     unsigned int element_count,
@@ -1100,6 +1777,10 @@ static int dvfs_element_init(
     ctx->opp_count = count_opps(ctx->config->opps);
     fwk_assert(ctx->opp_count > 0);
 
+    init_opp_lookup(ctx);
+
+    dvfs_rail_init(ctx);
+
     return FWK_SUCCESS;
 }
 
@@ -1125,7 +1806,8 @@ static int dvfs_bind_element(fwk_id_t domain_id, unsigned int round)
     }
 
     /* Bind to the alarm HAL if required */
-    if (ctx->config->retry_ms > 0) {
+    if ((ctx->config->retry_ms > 0) || (ctx->config->min_dwell_ms > 0) ||
+        (ctx->config->max_transition_rate > 0)) {
 #ifdef BUILD_HAS_MOD_TIMER
         status = fwk_module_bind(
             ctx->config->alarm_id,
@@ -1198,6 +1880,9 @@ const struct fwk_module module_dvfs = {
     .bind = dvfs_bind,
     .process_bind_request = dvfs_process_bind_request,
     .process_event = mod_dvfs_process_event,
+#ifdef BUILD_HAS_MOD_POWER_DOMAIN
+    .process_notification = dvfs_process_notification,
+#endif
     .api_count = (unsigned int)MOD_DVFS_API_IDX_COUNT,
     .event_count = (unsigned int)MOD_DVFS_INTERNAL_EVENT_IDX_COUNT,
 };
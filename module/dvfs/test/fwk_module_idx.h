@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2023-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -17,6 +17,7 @@ enum fwk_module_idx {
     FWK_MODULE_IDX_TIMER,
     FWK_MODULE_IDX_CLOCK,
     FWK_MODULE_IDX_PSU,
+    FWK_MODULE_IDX_POWER_DOMAIN,
     FWK_MODULE_IDX_COUNT,
 };
 
@@ -32,4 +33,7 @@ static const fwk_id_t fwk_module_id_dvfs =
 static const fwk_id_t fwk_module_id_timer =
     FWK_ID_MODULE_INIT(FWK_MODULE_IDX_TIMER);
 
+static const fwk_id_t fwk_module_id_power_domain =
+    FWK_ID_MODULE_INIT(FWK_MODULE_IDX_POWER_DOMAIN);
+
 #endif /* TEST_FWK_MODULE_MODULE_IDX_H */
@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2023-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -125,6 +125,99 @@ void utest_dvfs_get_opp_for_level_with_non_existing_level(void)
     TEST_ASSERT_EQUAL(NULL, return_opp);
 }
 
+void utest_dvfs_init_opp_lookup_evenly_spaced_levels(void)
+{
+    struct mod_dvfs_opp opps[] = {
+        { .level = 100, .voltage = 10 },
+        { .level = 200, .voltage = 20 },
+        { .level = 300, .voltage = 20 },
+        { .level = 400, .voltage = 30 },
+    };
+    struct mod_dvfs_domain_config config = {
+        .opps = &opps[0],
+    };
+    struct mod_dvfs_domain_ctx dvfs_domain_ctx = {
+        .config = &config,
+        .opp_count = FWK_ARRAY_SIZE(opps),
+    };
+
+    init_opp_lookup(&dvfs_domain_ctx);
+
+    TEST_ASSERT_TRUE(dvfs_domain_ctx.opps_sorted);
+    TEST_ASSERT_TRUE(dvfs_domain_ctx.voltages_sorted);
+    TEST_ASSERT_EQUAL(100, dvfs_domain_ctx.level_step);
+
+    TEST_ASSERT_EQUAL(&opps[2], get_opp_for_level(&dvfs_domain_ctx, 300));
+    TEST_ASSERT_EQUAL(&opps[3], get_opp_for_level(&dvfs_domain_ctx, 400));
+    TEST_ASSERT_EQUAL(NULL, get_opp_for_level(&dvfs_domain_ctx, 50));
+    TEST_ASSERT_EQUAL(NULL, get_opp_for_level(&dvfs_domain_ctx, 250));
+    TEST_ASSERT_EQUAL(NULL, get_opp_for_level(&dvfs_domain_ctx, 500));
+
+    /* The first operating point of a shared voltage is returned */
+    TEST_ASSERT_EQUAL(&opps[1], get_opp_for_voltage(&dvfs_domain_ctx, 20));
+    TEST_ASSERT_EQUAL(NULL, get_opp_for_voltage(&dvfs_domain_ctx, 15));
+}
+
+void utest_dvfs_init_opp_lookup_sorted_levels(void)
+{
+    struct mod_dvfs_opp opps[] = {
+        { .level = 100, .voltage = 10 }, { .level = 150, .voltage = 20 },
+        { .level = 300, .voltage = 30 }, { .level = 320, .voltage = 40 },
+        { .level = 900, .voltage = 50 },
+    };
+    struct mod_dvfs_domain_config config = {
+        .opps = &opps[0],
+    };
+    struct mod_dvfs_domain_ctx dvfs_domain_ctx = {
+        .config = &config,
+        .opp_count = FWK_ARRAY_SIZE(opps),
+    };
+    size_t opp_idx;
+
+    init_opp_lookup(&dvfs_domain_ctx);
+
+    TEST_ASSERT_TRUE(dvfs_domain_ctx.opps_sorted);
+    TEST_ASSERT_EQUAL(0, dvfs_domain_ctx.level_step);
+
+    for (opp_idx = 0; opp_idx < FWK_ARRAY_SIZE(opps); opp_idx++) {
+        TEST_ASSERT_EQUAL(
+            &opps[opp_idx],
+            get_opp_for_level(&dvfs_domain_ctx, opps[opp_idx].level));
+        TEST_ASSERT_EQUAL(
+            &opps[opp_idx],
+            get_opp_for_voltage(&dvfs_domain_ctx, opps[opp_idx].voltage));
+    }
+
+    TEST_ASSERT_EQUAL(NULL, get_opp_for_level(&dvfs_domain_ctx, 99));
+    TEST_ASSERT_EQUAL(NULL, get_opp_for_level(&dvfs_domain_ctx, 310));
+    TEST_ASSERT_EQUAL(NULL, get_opp_for_level(&dvfs_domain_ctx, 1000));
+}
+
+void utest_dvfs_init_opp_lookup_unsorted_levels(void)
+{
+    struct mod_dvfs_opp opps[] = {
+        { .level = 300, .voltage = 30 },
+        { .level = 100, .voltage = 10 },
+        { .level = 200, .voltage = 20 },
+    };
+    struct mod_dvfs_domain_config config = {
+        .opps = &opps[0],
+    };
+    struct mod_dvfs_domain_ctx dvfs_domain_ctx = {
+        .config = &config,
+        .opp_count = FWK_ARRAY_SIZE(opps),
+    };
+
+    init_opp_lookup(&dvfs_domain_ctx);
+
+    TEST_ASSERT_FALSE(dvfs_domain_ctx.opps_sorted);
+    TEST_ASSERT_FALSE(dvfs_domain_ctx.voltages_sorted);
+    TEST_ASSERT_EQUAL(0, dvfs_domain_ctx.level_step);
+
+    TEST_ASSERT_EQUAL(&opps[1], get_opp_for_level(&dvfs_domain_ctx, 100));
+    TEST_ASSERT_EQUAL(&opps[0], get_opp_for_voltage(&dvfs_domain_ctx, 30));
+}
+
 void utest_dvfs_get_opp_for_voltage_with_existing_voltage(void)
 {
     struct mod_dvfs_domain_config config;
@@ -568,6 +661,7 @@ void utest_dvfs_get_latency(void)
     dvfs_ctx.domain_ctx = &dvfs_domain_ctx;
 
     config.latency = 3;
+    config.report_measured_latency = false;
     dvfs_domain_ctx[0].config = &config;
 
     fwk_id_get_element_idx_ExpectAndReturn(dvfs_id, 0);
@@ -578,6 +672,315 @@ void utest_dvfs_get_latency(void)
     TEST_ASSERT_EQUAL(3, latency);
 }
 
+void utest_dvfs_update_voltage_cache(void)
+{
+    struct mod_dvfs_domain_ctx dvfs_domain_ctx = { 0 };
+
+    dvfs_update_voltage_cache(&dvfs_domain_ctx, FWK_SUCCESS, 800);
+    TEST_ASSERT_TRUE(dvfs_domain_ctx.voltage_valid);
+    TEST_ASSERT_EQUAL(800, dvfs_domain_ctx.voltage);
+
+    dvfs_update_voltage_cache(&dvfs_domain_ctx, FWK_PENDING, 900);
+    TEST_ASSERT_FALSE(dvfs_domain_ctx.voltage_valid);
+
+    dvfs_update_voltage_cache(&dvfs_domain_ctx, FWK_SUCCESS, 900);
+    dvfs_update_voltage_cache(&dvfs_domain_ctx, FWK_E_DEVICE, 1000);
+    TEST_ASSERT_FALSE(dvfs_domain_ctx.voltage_valid);
+}
+
+void utest_dvfs_invalidate_opp(void)
+{
+    fwk_id_t dvfs_id = { 0 };
+    struct mod_dvfs_domain_ctx dvfs_domain_ctx[1] = {
+        {
+            .current_opp = {
+                .level = 1,
+                .voltage = 2,
+                .frequency = 3,
+            },
+            .voltage = 2,
+            .voltage_valid = true,
+        },
+    };
+    int status;
+
+    dvfs_ctx.dvfs_domain_element_count = 1;
+    dvfs_ctx.domain_ctx = &dvfs_domain_ctx;
+
+    fwk_id_get_element_idx_ExpectAndReturn(dvfs_id, 0);
+
+    status = dvfs_invalidate_opp(dvfs_id);
+
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+    TEST_ASSERT_FALSE(dvfs_domain_ctx[0].voltage_valid);
+    TEST_ASSERT_EQUAL(1, dvfs_domain_ctx[0].current_opp.level);
+    TEST_ASSERT_EQUAL(2, dvfs_domain_ctx[0].current_opp.voltage);
+    TEST_ASSERT_EQUAL(3, dvfs_domain_ctx[0].current_opp.frequency);
+}
+
+void utest_dvfs_invalidate_opp_invalid_dvfs_id(void)
+{
+    fwk_id_t dvfs_id = { 0 };
+    struct mod_dvfs_domain_ctx dvfs_domain_ctx[1];
+    int status;
+
+    dvfs_ctx.dvfs_domain_element_count = 1;
+    dvfs_ctx.domain_ctx = &dvfs_domain_ctx;
+
+    fwk_id_get_element_idx_ExpectAndReturn(dvfs_id, 2);
+
+    status = dvfs_invalidate_opp(dvfs_id);
+
+    TEST_ASSERT_EQUAL(FWK_E_PARAM, status);
+}
+
+void utest_dvfs_process_notification_pd_transition(void)
+{
+    struct mod_dvfs_domain_ctx dvfs_domain_ctx[2] = {
+        {
+            .current_opp = {
+                .level = 1,
+                .voltage = 2,
+                .frequency = 3,
+            },
+            .voltage = 2,
+            .voltage_valid = true,
+        },
+        {
+            .voltage = 2,
+            .voltage_valid = true,
+        },
+    };
+    struct fwk_event event = {
+        .id = mod_pd_notification_id_power_state_transition,
+        .source_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_POWER_DOMAIN, 0),
+        .target_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_DVFS, 0),
+    };
+    struct mod_pd_power_state_transition_notification_params *params =
+        (struct mod_pd_power_state_transition_notification_params *)
+            event.params;
+    int status;
+
+    /* Both domains are supplied by the same power supply */
+    dvfs_domain_ctx[0].next_rail_domain = &dvfs_domain_ctx[1];
+    dvfs_domain_ctx[1].next_rail_domain = &dvfs_domain_ctx[0];
+
+    dvfs_ctx.dvfs_domain_element_count = 2;
+    dvfs_ctx.domain_ctx = &dvfs_domain_ctx;
+
+    params->state = MOD_PD_STATE_OFF;
+
+    fwk_id_is_equal_ExpectAndReturn(
+        event.id, mod_pd_notification_id_power_state_transition, true);
+    fwk_id_get_element_idx_ExpectAndReturn(event.target_id, 0);
+
+    status = dvfs_process_notification(&event, NULL);
+
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+    TEST_ASSERT_FALSE(dvfs_domain_ctx[0].voltage_valid);
+    TEST_ASSERT_FALSE(dvfs_domain_ctx[1].voltage_valid);
+    TEST_ASSERT_EQUAL(1, dvfs_domain_ctx[0].current_opp.level);
+    TEST_ASSERT_EQUAL(2, dvfs_domain_ctx[0].current_opp.voltage);
+    TEST_ASSERT_EQUAL(3, dvfs_domain_ctx[0].current_opp.frequency);
+}
+
+void utest_dvfs_process_notification_unknown_notification(void)
+{
+    struct mod_dvfs_domain_ctx dvfs_domain_ctx[1] = {
+        {
+            .voltage = 2,
+            .voltage_valid = true,
+        },
+    };
+    struct fwk_event event = {
+        .id = mod_pd_notification_id_power_state_pre_transition,
+        .target_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_DVFS, 0),
+    };
+    int status;
+
+    dvfs_ctx.dvfs_domain_element_count = 1;
+    dvfs_ctx.domain_ctx = &dvfs_domain_ctx;
+
+    fwk_id_is_equal_ExpectAndReturn(
+        event.id, mod_pd_notification_id_power_state_transition, false);
+
+    status = dvfs_process_notification(&event, NULL);
+
+    TEST_ASSERT_EQUAL(FWK_E_PARAM, status);
+    TEST_ASSERT_TRUE(dvfs_domain_ctx[0].voltage_valid);
+}
+
+void utest_dvfs_get_rail_voltage(void)
+{
+    struct mod_dvfs_domain_ctx dvfs_domain_ctx[3] = { 0 };
+
+    /* Three domains supplied by the same power supply */
+    dvfs_domain_ctx[0].next_rail_domain = &dvfs_domain_ctx[1];
+    dvfs_domain_ctx[1].next_rail_domain = &dvfs_domain_ctx[2];
+    dvfs_domain_ctx[2].next_rail_domain = &dvfs_domain_ctx[0];
+
+    dvfs_domain_ctx[0].request.new_opp.voltage = 700;
+    dvfs_domain_ctx[1].current_opp.voltage = 800;
+    dvfs_domain_ctx[2].current_opp.voltage = 600;
+
+    TEST_ASSERT_EQUAL(800, dvfs_get_rail_voltage(&dvfs_domain_ctx[0], 900));
+
+    /* A pending request is satisfied at once */
+    dvfs_domain_ctx[2].request_pending = true;
+    dvfs_domain_ctx[2].pending_request.new_opp.voltage = 1000;
+    TEST_ASSERT_EQUAL(1000, dvfs_get_rail_voltage(&dvfs_domain_ctx[0], 900));
+
+    /* The voltage is not decreased below an unknown operating point */
+    dvfs_domain_ctx[2].request_pending = false;
+    dvfs_domain_ctx[1].current_opp.voltage = 0;
+    TEST_ASSERT_EQUAL(900, dvfs_get_rail_voltage(&dvfs_domain_ctx[0], 900));
+}
+
+void utest_dvfs_rail_is_busy(void)
+{
+    struct mod_dvfs_domain_ctx dvfs_domain_ctx[2] = { 0 };
+
+    dvfs_domain_ctx[0].next_rail_domain = &dvfs_domain_ctx[1];
+    dvfs_domain_ctx[1].next_rail_domain = &dvfs_domain_ctx[0];
+
+    TEST_ASSERT_FALSE(dvfs_rail_is_busy(&dvfs_domain_ctx[0]));
+
+    dvfs_domain_ctx[0].state = DVFS_DOMAIN_SET_VOLTAGE;
+    TEST_ASSERT_FALSE(dvfs_rail_is_busy(&dvfs_domain_ctx[0]));
+    TEST_ASSERT_TRUE(dvfs_rail_is_busy(&dvfs_domain_ctx[1]));
+
+    dvfs_domain_ctx[0].state = DVFS_DOMAIN_STATE_RETRY;
+    TEST_ASSERT_FALSE(dvfs_rail_is_busy(&dvfs_domain_ctx[1]));
+}
+
+void utest_dvfs_latency_stats_update(void)
+{
+    struct mod_dvfs_latency_stats stats = { 0 };
+
+    dvfs_latency_stats_update(&stats, 80);
+    TEST_ASSERT_EQUAL(1, stats.count);
+    TEST_ASSERT_EQUAL(80, stats.avg_us);
+    TEST_ASSERT_EQUAL(80, stats.max_us);
+
+    dvfs_latency_stats_update(&stats, 160);
+    TEST_ASSERT_EQUAL(2, stats.count);
+    TEST_ASSERT_EQUAL(90, stats.avg_us);
+    TEST_ASSERT_EQUAL(160, stats.max_us);
+
+    dvfs_latency_stats_update(&stats, 10);
+    TEST_ASSERT_EQUAL(80, stats.avg_us);
+    TEST_ASSERT_EQUAL(160, stats.max_us);
+}
+
+void utest_dvfs_get_latency_measured(void)
+{
+    fwk_id_t dvfs_id;
+    struct mod_dvfs_domain_ctx dvfs_domain_ctx[1] = { 0 };
+    struct mod_dvfs_domain_config config = {
+        .latency = 3,
+        .report_measured_latency = true,
+    };
+    int status;
+    uint16_t latency;
+
+    dvfs_ctx.dvfs_domain_element_count = 1;
+    dvfs_ctx.domain_ctx = &dvfs_domain_ctx;
+    dvfs_domain_ctx[0].config = &config;
+
+    /* The configured latency is used until transitions are measured */
+    fwk_id_get_element_idx_ExpectAndReturn(dvfs_id, 0);
+    status = dvfs_get_latency(dvfs_id, &latency);
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+    TEST_ASSERT_EQUAL(3, latency);
+
+    /* 99 transitions of [32, 64) us and a single slow one */
+    dvfs_domain_ctx[0].stats.transition[MOD_DVFS_TRANSITION_UP].count = 100;
+    dvfs_domain_ctx[0].stats.transition[MOD_DVFS_TRANSITION_UP].max_us = 5000;
+    dvfs_domain_ctx[0].stats.histogram[MOD_DVFS_TRANSITION_UP][6] = 99;
+    dvfs_domain_ctx[0].stats.histogram[MOD_DVFS_TRANSITION_UP][13] = 1;
+
+    /* A single transition down of [8, 16) us */
+    dvfs_domain_ctx[0].stats.transition[MOD_DVFS_TRANSITION_DOWN].count = 1;
+    dvfs_domain_ctx[0].stats.transition[MOD_DVFS_TRANSITION_DOWN].max_us = 12;
+    dvfs_domain_ctx[0].stats.histogram[MOD_DVFS_TRANSITION_DOWN][4] = 1;
+
+    fwk_id_get_element_idx_ExpectAndReturn(dvfs_id, 0);
+    status = dvfs_get_latency(dvfs_id, &latency);
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+    TEST_ASSERT_EQUAL(64, latency);
+}
+
+void utest_dvfs_rate_limit_delay_ms(void)
+{
+    struct mod_dvfs_domain_ctx dvfs_domain_ctx = { 0 };
+    struct mod_dvfs_domain_config config = {
+        .min_dwell_ms = 5,
+    };
+    fwk_timestamp_t now = FWK_MS(100);
+
+    dvfs_domain_ctx.config = &config;
+
+    /* No limit without a time driver or before the first transition */
+    TEST_ASSERT_EQUAL(0, dvfs_rate_limit_delay_ms(&dvfs_domain_ctx, 0));
+    TEST_ASSERT_EQUAL(0, dvfs_rate_limit_delay_ms(&dvfs_domain_ctx, now));
+
+    /* The remaining dwell time is rounded up */
+    dvfs_domain_ctx.opp_timestamp = now - FWK_US(2500);
+    TEST_ASSERT_EQUAL(3, dvfs_rate_limit_delay_ms(&dvfs_domain_ctx, now));
+
+    dvfs_domain_ctx.opp_timestamp = now - FWK_MS(5);
+    TEST_ASSERT_EQUAL(0, dvfs_rate_limit_delay_ms(&dvfs_domain_ctx, now));
+}
+
+void utest_dvfs_rate_limit_max_rate(void)
+{
+    struct mod_dvfs_domain_ctx dvfs_domain_ctx = { 0 };
+    struct mod_dvfs_domain_config config = {
+        .max_transition_rate = 2,
+    };
+    fwk_timestamp_t now = FWK_S(10);
+
+    dvfs_domain_ctx.config = &config;
+
+    /* A burst of two transitions is allowed, the third one waits */
+    TEST_ASSERT_EQUAL(0, dvfs_rate_limit_delay_ms(&dvfs_domain_ctx, now));
+    dvfs_rate_limit_account(&dvfs_domain_ctx, now);
+    TEST_ASSERT_EQUAL(0, dvfs_rate_limit_delay_ms(&dvfs_domain_ctx, now));
+    dvfs_rate_limit_account(&dvfs_domain_ctx, now);
+    TEST_ASSERT_EQUAL(500, dvfs_rate_limit_delay_ms(&dvfs_domain_ctx, now));
+
+    TEST_ASSERT_EQUAL(
+        0, dvfs_rate_limit_delay_ms(&dvfs_domain_ctx, now + FWK_MS(500)));
+}
+
+void utest_dvfs_create_pending_level_request_counters(void)
+{
+    struct mod_dvfs_domain_ctx dvfs_domain_ctx = { 0 };
+    struct mod_dvfs_opp opps[2] = {
+        { .level = 1, .voltage = 100, .frequency = 10 },
+        { .level = 2, .voltage = 200, .frequency = 20 },
+    };
+
+    dvfs_domain_ctx.current_opp = opps[0];
+
+    /* Same as the current operating point */
+    dvfs_create_pending_level_request(&dvfs_domain_ctx, 0, &opps[0], false);
+    TEST_ASSERT_FALSE(dvfs_domain_ctx.request_pending);
+    TEST_ASSERT_EQUAL(1, dvfs_domain_ctx.stats.requests_dropped);
+
+    dvfs_create_pending_level_request(&dvfs_domain_ctx, 0, &opps[1], false);
+    TEST_ASSERT_TRUE(dvfs_domain_ctx.request_pending);
+
+    /* Same as the pending request */
+    dvfs_create_pending_level_request(&dvfs_domain_ctx, 0, &opps[1], false);
+    TEST_ASSERT_EQUAL(2, dvfs_domain_ctx.stats.requests_dropped);
+
+    /* The latest request wins */
+    dvfs_create_pending_level_request(&dvfs_domain_ctx, 0, &opps[0], false);
+    TEST_ASSERT_EQUAL(1, dvfs_domain_ctx.stats.requests_merged);
+    TEST_ASSERT_EQUAL(1, dvfs_domain_ctx.pending_request.new_opp.level);
+}
+
 int dvfs_test_main(void)
 {
     UNITY_BEGIN();
@@ -590,6 +993,10 @@ int dvfs_test_main(void)
     RUN_TEST(utest_dvfs_get_opp_for_level_with_existing_level);
     RUN_TEST(utest_dvfs_get_opp_for_level_with_non_existing_level);
 
+    RUN_TEST(utest_dvfs_init_opp_lookup_evenly_spaced_levels);
+    RUN_TEST(utest_dvfs_init_opp_lookup_sorted_levels);
+    RUN_TEST(utest_dvfs_init_opp_lookup_unsorted_levels);
+
     RUN_TEST(utest_dvfs_get_opp_for_voltage_with_existing_voltage);
     RUN_TEST(utest_dvfs_get_opp_for_voltage_with_none_existing_voltage);
 
@@ -615,6 +1022,21 @@ int dvfs_test_main(void)
     RUN_TEST(utest_dvfs_get_latency_null_latency);
     RUN_TEST(utest_dvfs_get_latency_invalid_dvfs_id);
     RUN_TEST(utest_dvfs_get_latency);
+    RUN_TEST(utest_dvfs_get_latency_measured);
+    RUN_TEST(utest_dvfs_latency_stats_update);
+
+    RUN_TEST(utest_dvfs_update_voltage_cache);
+    RUN_TEST(utest_dvfs_invalidate_opp);
+    RUN_TEST(utest_dvfs_invalidate_opp_invalid_dvfs_id);
+
+    RUN_TEST(utest_dvfs_process_notification_pd_transition);
+    RUN_TEST(utest_dvfs_process_notification_unknown_notification);
+    RUN_TEST(utest_dvfs_get_rail_voltage);
+    RUN_TEST(utest_dvfs_rail_is_busy);
+
+    RUN_TEST(utest_dvfs_rate_limit_delay_ms);
+    RUN_TEST(utest_dvfs_rate_limit_max_rate);
+    RUN_TEST(utest_dvfs_create_pending_level_request_counters);
 
     return UNITY_END();
 }
@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2023-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -12,6 +12,7 @@
 
 #include <fwk_macros.h>
 
+#include <stdbool.h>
 #include <stdint.h>
 
 /*!
@@ -42,12 +43,40 @@ enum mod_fch_polled_api_idx {
     MOD_FCH_POLLED_API_IDX_COUNT,
 };
 
+/*!
+ * \brief Fast Channel change detection hook.
+ *
+ * \details Called on each poll when adaptive polling is enabled to find
+ *      whether the agent has written the fast channel since the previous
+ *      poll.
+ *
+ * \param fch_addr Fast Channel description structure.
+ * \param[in, out] last_value Value recorded by the previous call. The hook is
+ *      free to record any value it needs to detect the next change.
+ *
+ * \retval true The fast channel has been written.
+ * \retval false The fast channel is unchanged.
+ */
+typedef bool (*mod_fch_polled_change_hook_t)(
+    const struct mod_transport_fast_channel_addr *fch_addr,
+    uint64_t *last_value);
+
 /*!
  * \brief Platform FCH Driver Channel configuration
  */
 struct mod_fch_polled_channel_config {
     /*! Fast Channel description structure */
     struct mod_transport_fast_channel_addr fch_addr;
+
+    /*!
+     * \brief Change detection hook used by adaptive polling.
+     *
+     * \details When NULL, the first (up to) 64 bits of the fast channel are
+     *      compared with their value on the previous poll. Channels that
+     *      should not affect the polling period, for instance the ones only
+     *      written by the platform, can provide a hook always returning false.
+     */
+    mod_fch_polled_change_hook_t has_changed;
 };
 
 /*!
@@ -57,9 +86,25 @@ struct mod_fch_polled_config {
     /*! Fast Channel alarm ID */
     fwk_id_t fch_alarm_id;
 
-    /*! Fast Channel polling rate */
+    /*!
+     * \brief Fast Channel polling rate in microseconds.
+     *
+     * \details Bounded by ::FCH_MIN_POLL_RATE_US. This is the polling period
+     *      used when a fast channel has just been written.
+     */
     uint32_t fch_poll_rate;
 
+    /*!
+     * \brief Maximum Fast Channel polling period in microseconds.
+     *
+     * \details When not zero, polling is adaptive: the polling period is
+     *      doubled, up to this value, each time no fast channel has been
+     *      written since the previous poll. It goes back to `fch_poll_rate`
+     *      as soon as a write is detected. When zero, the fast channels are
+     *      polled at `fch_poll_rate`.
+     */
+    uint32_t fch_poll_rate_max;
+
     /*! Fast channel rate limit */
     uint32_t rate_limit;
 
@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2023-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -27,6 +27,9 @@ struct mod_fch_polled_channel_ctx {
     uintptr_t param;
 
     void (*fch_callback)(uintptr_t param);
+
+    /* Value recorded by the change detection hook on the previous poll */
+    uint64_t last_value;
 };
 
 /* Platform FCH context */
@@ -42,40 +45,130 @@ struct mod_fch_polled_ctx {
 
     /* Fast channel configuration */
     struct mod_fch_polled_config *fch_config;
+
+    /* Current polling period in microseconds when polling is adaptive */
+    uint32_t poll_period;
 };
 
 static struct mod_fch_polled_ctx fch_polled_ctx;
 
-static void fast_channel_alarm_callback(uintptr_t ch_ctx)
+static void fast_channel_alarm_callback(uintptr_t ch_ctx);
+
+static uint32_t get_min_poll_period(void)
 {
-    struct mod_fch_polled_channel_ctx *channel_ctx;
+    return FWK_MAX(
+        (uint32_t)FCH_MIN_POLL_RATE_US,
+        (uint32_t)fch_polled_ctx.fch_config->fch_poll_rate);
+}
 
-    channel_ctx = (struct mod_fch_polled_channel_ctx *)ch_ctx;
+static bool is_adaptive_polling(void)
+{
+    return fch_polled_ctx.fch_config->fch_poll_rate_max != 0;
+}
 
-    /* Call the callback function that has been registered for this channel */
-    channel_ctx->fch_callback(channel_ctx->param);
+/* Default change detection, compare the fast channel with its last value */
+static bool fch_value_has_changed(
+    const struct mod_transport_fast_channel_addr *fch_addr,
+    uint64_t *last_value)
+{
+    uint64_t value;
+
+    if (fch_addr->length >= sizeof(uint64_t)) {
+        value = *(volatile uint64_t *)fch_addr->local_view_address;
+    } else {
+        value = *(volatile uint32_t *)fch_addr->local_view_address;
+    }
+
+    if (value == *last_value) {
+        return false;
+    }
+
+    *last_value = value;
+
+    return true;
+}
+
+static bool fast_channels_have_changed(void)
+{
+    struct mod_fch_polled_channel_ctx *channel_ctx;
+    mod_fch_polled_change_hook_t has_changed;
+    unsigned int index;
+    bool changed = false;
+
+    /* All the hooks are called so that each of them records its last value */
+    for (index = 0; index < fch_polled_ctx.channel_count; index++) {
+        channel_ctx = &fch_polled_ctx.channel_ctx_table[index];
+
+        has_changed = channel_ctx->config->has_changed;
+        if (has_changed == NULL) {
+            has_changed = fch_value_has_changed;
+        }
+
+        if (has_changed(
+                &channel_ctx->config->fch_addr, &channel_ctx->last_value)) {
+            changed = true;
+        }
+    }
+
+    return changed;
 }
 
 static int start_alarm(struct mod_fch_polled_channel_ctx *channel_ctx)
 {
     uint32_t fch_interval_msecs;
-
-    /* Set the fast channel polling rate */
-    fch_interval_msecs =
-        FWK_MAX(
-            (uint32_t)FCH_MIN_POLL_RATE_US,
-            (uint32_t)fch_polled_ctx.fch_config->fch_poll_rate) /
-        1000;
+    enum mod_timer_alarm_type alarm_type;
+
+    if (is_adaptive_polling()) {
+        /* The alarm is restarted with the next period on each poll */
+        fch_interval_msecs = fch_polled_ctx.poll_period / 1000;
+        alarm_type = MOD_TIMER_ALARM_TYPE_ONCE;
+    } else {
+        /* Set the fast channel polling rate */
+        fch_interval_msecs = get_min_poll_period() / 1000;
+        alarm_type = MOD_TIMER_ALARM_TYPE_PERIODIC;
+    }
 
     /* Start the alarm */
     return fch_polled_ctx.fch_alarm_api->start(
         fch_polled_ctx.fch_config->fch_alarm_id,
         fch_interval_msecs,
-        MOD_TIMER_ALARM_TYPE_PERIODIC,
+        alarm_type,
         fast_channel_alarm_callback,
         (uintptr_t)channel_ctx);
 }
 
+static void fast_channel_alarm_callback(uintptr_t ch_ctx)
+{
+    struct mod_fch_polled_channel_ctx *channel_ctx;
+    int status;
+
+    channel_ctx = (struct mod_fch_polled_channel_ctx *)ch_ctx;
+
+    if (is_adaptive_polling()) {
+        /*
+         * Go back to the shortest period as soon as a fast channel is
+         * written, back off exponentially while they are left unchanged.
+         */
+        if (fast_channels_have_changed()) {
+            fch_polled_ctx.poll_period = get_min_poll_period();
+        } else {
+            fch_polled_ctx.poll_period = FWK_MIN(
+                fch_polled_ctx.poll_period * 2,
+                fch_polled_ctx.fch_config->fch_poll_rate_max);
+        }
+    }
+
+    /* Call the callback function that has been registered for this channel */
+    channel_ctx->fch_callback(channel_ctx->param);
+
+    if (is_adaptive_polling()) {
+        status = start_alarm(channel_ctx);
+        if (status != FWK_SUCCESS) {
+            FWK_LOG_ERR("%sError while restarting the poll alarm", MOD_NAME);
+        }
+    }
+}
+
 /*
  * Transport Driver API
  */
@@ -149,6 +242,9 @@ static int mod_fch_polled_register_callback(
     /* Store the callback function pointer */
     channel_ctx->fch_callback = fch_callback;
 
+    /* Start polling with the shortest period */
+    fch_polled_ctx.poll_period = get_min_poll_period();
+
     /* Start the alarm */
     return start_alarm(channel_ctx);
 }
@@ -188,6 +284,12 @@ static int mod_fch_polled_init(
         return FWK_E_DATA;
     }
 
+    if (is_adaptive_polling() &&
+        (fch_polled_ctx.fch_config->fch_poll_rate_max <
+         get_min_poll_period())) {
+        return FWK_E_DATA;
+    }
+
     return FWK_SUCCESS;
 }
 
@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2023-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -45,6 +45,15 @@ static struct mod_fch_polled_config fake_fch_config_2 = {
     .rate_limit = FAKE_RATE_LIMIT,
 };
 
+#define FAKE_FCH_POLL_RATE_MAX_US (FCH_MIN_POLL_RATE_US * 8)
+
+static struct mod_fch_polled_config fake_fch_config_adaptive = {
+    .fch_alarm_id = FWK_ID_SUB_ELEMENT_INIT(FWK_MODULE_IDX_TIMER, 0, 0),
+    .fch_poll_rate = FCH_MIN_POLL_RATE_US,
+    .fch_poll_rate_max = FAKE_FCH_POLL_RATE_MAX_US,
+    .rate_limit = FAKE_RATE_LIMIT,
+};
+
 /*!
  *\brief Fast Channels in shared memory. Similar to mod_scmi_perf
  */
@@ -109,6 +118,12 @@ static const struct fwk_element fake_fch_polled_element_table[] = {
 
 };
 
+/* Fake fast channels used by the adaptive polling tests */
+static uint32_t fake_fch_memory[FAKE_FCH_POLLED_COUNT];
+
+static struct mod_fch_polled_channel_config
+    fake_fch_adaptive_channel_config[FAKE_FCH_POLLED_COUNT];
+
 static const struct fwk_element *fch_polled_get_element_table(
     fwk_id_t module_id)
 {
@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2023-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -130,6 +130,107 @@ void utest_start_alarm_less_than_min_poll_rate()
     TEST_ASSERT_EQUAL(status, FWK_SUCCESS);
 }
 
+/* Point the channels to fake fast channels for adaptive polling tests */
+static void setup_adaptive_polling(void)
+{
+    unsigned int index;
+
+    fch_polled_ctx.fch_config = &fake_fch_config_adaptive;
+
+    for (index = 0; index < FAKE_FCH_POLLED_COUNT; index++) {
+        fake_fch_adaptive_channel_config[index].fch_addr.local_view_address =
+            (uintptr_t)&fake_fch_memory[index];
+        fake_fch_adaptive_channel_config[index].fch_addr.length =
+            sizeof(fake_fch_memory[index]);
+        fch_polled_ctx.channel_ctx_table[index].config =
+            &fake_fch_adaptive_channel_config[index];
+        fch_polled_ctx.channel_ctx_table[index].last_value =
+            fake_fch_memory[index];
+    }
+}
+
+void fake_fch_adaptive_callback(uintptr_t param)
+{
+}
+
+/* Test fast_channel_alarm_callback() backs off when nothing is written */
+void utest_fast_channel_callback_adaptive_backoff()
+{
+    struct mod_fch_polled_channel_ctx *channel_ctx;
+
+    setup_adaptive_polling();
+
+    channel_ctx = &fch_polled_ctx.channel_ctx_table[FAKE_FCH_POLLED_0];
+    channel_ctx->fch_callback = fake_fch_adaptive_callback;
+    fch_polled_ctx.poll_period = FCH_MIN_POLL_RATE_US;
+
+    fch_polled_extra_alarm_start_ExpectAndReturn(
+        fake_fch_config_adaptive.fch_alarm_id,
+        (FCH_MIN_POLL_RATE_US * 2) / 1000,
+        MOD_TIMER_ALARM_TYPE_ONCE,
+        fast_channel_alarm_callback,
+        (uintptr_t)channel_ctx,
+        FWK_SUCCESS);
+
+    fast_channel_alarm_callback((uintptr_t)channel_ctx);
+
+    TEST_ASSERT_EQUAL(FCH_MIN_POLL_RATE_US * 2, fch_polled_ctx.poll_period);
+}
+
+/* Test fast_channel_alarm_callback() does not exceed the maximum period */
+void utest_fast_channel_callback_adaptive_max_period()
+{
+    struct mod_fch_polled_channel_ctx *channel_ctx;
+
+    setup_adaptive_polling();
+
+    channel_ctx = &fch_polled_ctx.channel_ctx_table[FAKE_FCH_POLLED_0];
+    channel_ctx->fch_callback = fake_fch_adaptive_callback;
+    fch_polled_ctx.poll_period = FAKE_FCH_POLL_RATE_MAX_US;
+
+    fch_polled_extra_alarm_start_ExpectAndReturn(
+        fake_fch_config_adaptive.fch_alarm_id,
+        FAKE_FCH_POLL_RATE_MAX_US / 1000,
+        MOD_TIMER_ALARM_TYPE_ONCE,
+        fast_channel_alarm_callback,
+        (uintptr_t)channel_ctx,
+        FWK_SUCCESS);
+
+    fast_channel_alarm_callback((uintptr_t)channel_ctx);
+
+    TEST_ASSERT_EQUAL(FAKE_FCH_POLL_RATE_MAX_US, fch_polled_ctx.poll_period);
+}
+
+/* Test fast_channel_alarm_callback() goes back to the minimum on a write */
+void utest_fast_channel_callback_adaptive_write()
+{
+    struct mod_fch_polled_channel_ctx *channel_ctx;
+
+    setup_adaptive_polling();
+
+    channel_ctx = &fch_polled_ctx.channel_ctx_table[FAKE_FCH_POLLED_0];
+    channel_ctx->fch_callback = fake_fch_adaptive_callback;
+    fch_polled_ctx.poll_period = FAKE_FCH_POLL_RATE_MAX_US;
+
+    /* The agent writes the second fast channel */
+    fake_fch_memory[FAKE_FCH_POLLED_1]++;
+
+    fch_polled_extra_alarm_start_ExpectAndReturn(
+        fake_fch_config_adaptive.fch_alarm_id,
+        FCH_MIN_POLL_RATE_US / 1000,
+        MOD_TIMER_ALARM_TYPE_ONCE,
+        fast_channel_alarm_callback,
+        (uintptr_t)channel_ctx,
+        FWK_SUCCESS);
+
+    fast_channel_alarm_callback((uintptr_t)channel_ctx);
+
+    TEST_ASSERT_EQUAL(FCH_MIN_POLL_RATE_US, fch_polled_ctx.poll_period);
+    TEST_ASSERT_EQUAL(
+        fake_fch_memory[FAKE_FCH_POLLED_1],
+        fch_polled_ctx.channel_ctx_table[FAKE_FCH_POLLED_1].last_value);
+}
+
 /* Test mod_fch_polled_get_fch() to get address */
 void utest_mod_fch_polled_get_fch_addr()
 {
@@ -207,11 +308,10 @@ void utest_mod_fch_polled_init()
     fwk_id_t module_id = FWK_ID_MODULE_INIT(FWK_MODULE_IDX_FCH_POLLED);
     int status;
 
-    struct mod_fch_polled_config *config =
-        (struct mod_fch_polled_config *)&config_fake_fch_polled.data;
+    const struct mod_fch_polled_config *config = config_fake_fch_polled.data;
 
     fwk_id_type_is_valid_ExpectAndReturn(config->fch_alarm_id, true);
-    status = mod_fch_polled_init(module_id, 2, &config_fake_fch_polled.data);
+    status = mod_fch_polled_init(module_id, 2, config_fake_fch_polled.data);
 
     TEST_ASSERT_EQUAL(status, FWK_SUCCESS);
 }
@@ -261,6 +361,25 @@ void utest_mod_fch_polled_init_invalid_alarm_id_config()
     TEST_ASSERT_EQUAL(status, FWK_E_DATA);
 }
 
+/* Test mod_fch_polled_init() for a maximum poll rate below the minimum */
+void utest_mod_fch_polled_init_invalid_poll_rate_max_config()
+{
+    fwk_id_t module_id = FWK_ID_MODULE_INIT(FWK_MODULE_IDX_FCH_POLLED);
+    int status;
+    struct mod_fch_polled_config config_invalid_poll_rate_max = {
+        .fch_alarm_id = FWK_ID_SUB_ELEMENT_INIT(FWK_MODULE_IDX_TIMER, 0, 0),
+        .fch_poll_rate = FCH_MIN_POLL_RATE_US * 2,
+        .fch_poll_rate_max = FCH_MIN_POLL_RATE_US, /* Invalid, below min */
+    };
+
+    fwk_id_type_is_valid_ExpectAndReturn(
+        config_invalid_poll_rate_max.fch_alarm_id, true);
+
+    status = mod_fch_polled_init(module_id, 2, &config_invalid_poll_rate_max);
+
+    TEST_ASSERT_EQUAL(status, FWK_E_DATA);
+}
+
 /* Test mod_fch_polled_channel_init() for success case  */
 void utest_mod_fch_polled_channel_init()
 {
@@ -409,6 +528,9 @@ int fch_polled_test_main(void)
     RUN_TEST(utest_fast_channel_callback);
     RUN_TEST(utest_start_alarm);
     RUN_TEST(utest_start_alarm_less_than_min_poll_rate);
+    RUN_TEST(utest_fast_channel_callback_adaptive_backoff);
+    RUN_TEST(utest_fast_channel_callback_adaptive_max_period);
+    RUN_TEST(utest_fast_channel_callback_adaptive_write);
     RUN_TEST(utest_mod_fch_polled_get_fch_addr);
     RUN_TEST(utest_mod_fch_polled_get_fch_intr_type);
     RUN_TEST(utest_mod_fch_polled_get_fch_doorbell_info);
@@ -418,6 +540,7 @@ int fch_polled_test_main(void)
     RUN_TEST(utest_mod_fch_polled_init_zero_elements);
     RUN_TEST(utest_mod_fch_polled_init_invalid_poll_rate_config);
     RUN_TEST(utest_mod_fch_polled_init_invalid_alarm_id_config);
+    RUN_TEST(utest_mod_fch_polled_init_invalid_poll_rate_max_config);
     RUN_TEST(utest_mod_fch_polled_channel_init);
     RUN_TEST(utest_mod_fch_polled_channel_init_invalid_data);
     RUN_TEST(utest_mod_fch_polled_bind_round_0);
@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2022, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2022-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -16,6 +16,15 @@
 
 #define MHU3_MAX_DOORBELL_CHANNELS UINT32_C(128)
 
+/* Number of interrupt status bits held by a single status register */
+#define MHU3_INT_ST_BITS UINT32_C(32)
+
+/* Number of MBX_DBCH_INT_ST<n> registers */
+#define MHU3_DBCH_INT_ST_COUNT (MHU3_MAX_DOORBELL_CHANNELS / MHU3_INT_ST_BITS)
+
+/* Maximum number of Fast Channel Groups */
+#define MHU3_MAX_FCH_GROUPS UINT32_C(32)
+
 /*
  * Useful macros
  */
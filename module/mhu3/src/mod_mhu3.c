@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2022-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2022-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -16,11 +16,13 @@
 #include <fwk_id.h>
 #include <fwk_interrupt.h>
 #include <fwk_log.h>
+#include <fwk_macros.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
 #include <fwk_status.h>
 
+#include <limits.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -37,6 +39,15 @@
  */
 #define MHU_DOORBELL_CHANNEL_COUNT_MAX 6
 
+/*
+ * Maximum span of the IRQ numbers of the devices covered by the IRQ to device
+ * table. Devices with more widely separated IRQ numbers are searched linearly.
+ */
+#define MHU3_IRQ_DEVICE_MAP_SPAN_MAX 64U
+
+/* Channel index marking the end of a list of channels */
+#define MHU3_CHANNEL_IDX_NONE UINT_MAX
+
 /* MHU channel context */
 struct mhu3_channel_ctx {
     /* ID of the transport channel the MHUv3 channel is bound to */
@@ -49,6 +60,11 @@ struct mhu3_channel_ctx {
     uintptr_t callback_param;
     /*! Fast Channel Callback on isr */
     void (*callback)(uintptr_t param);
+    /*
+     * Index of the next channel signalled by the same interrupt status bit,
+     * MHU3_CHANNEL_IDX_NONE if none.
+     */
+    unsigned int next_channel_idx;
 };
 
 /* MHU device context */
@@ -59,6 +75,26 @@ struct mhu3_device_ctx {
     struct mhu3_channel_ctx *channel_ctx_table;
     /* Number of channels (represented by sub-elements) */
     unsigned int channels_count;
+
+    /* Number of MBX_DBCH_INT_ST<n> registers with a configured channel */
+    unsigned int dbch_int_st_count;
+    /* Configured doorbell channels in each MBX_DBCH_INT_ST<n> register */
+    uint32_t dbch_int_mask[MHU3_DBCH_INT_ST_COUNT];
+    /*
+     * First channel signalled by each doorbell channel interrupt, indexed by
+     * the mailbox doorbell channel number.
+     */
+    unsigned int *dbch_channel_map;
+
+    /* Fast Channel Groups with a configured channel */
+    uint32_t fcg_int_mask;
+    /* Configured channels in each MBX_FCH_GRP_INT_ST<n> register */
+    uint32_t *fch_int_mask;
+    /*
+     * First channel signalled by each Fast Channel interrupt, indexed by
+     * (group number * MHU3_INT_ST_BITS + Fast Channel index).
+     */
+    unsigned int *fch_channel_map;
 };
 
 /* MHU context */
@@ -67,101 +103,170 @@ struct mod_mhu3_ctx {
     struct mhu3_device_ctx *device_ctx_table;
     /* Number of devices in the device context table */
     unsigned int device_count;
+    /* Lowest IRQ number of the devices */
+    unsigned int irq_min;
+    /* Number of entries in the IRQ to device table */
+    unsigned int irq_count;
+    /*
+     * Index of the device of each IRQ number, offset by irq_min, or
+     * device_count if no device uses the IRQ. NULL when the devices are
+     * searched linearly.
+     */
+    unsigned int *irq_device_map;
 };
 
 static struct mod_mhu3_ctx mhu3_ctx;
 
+static struct mhu3_device_ctx *mhu3_get_device_ctx(unsigned int interrupt)
+{
+    unsigned int device_idx;
+
+    if (mhu3_ctx.irq_device_map == NULL) {
+        for (device_idx = 0U; device_idx < mhu3_ctx.device_count;
+             device_idx++) {
+            if (mhu3_ctx.device_ctx_table[device_idx].config->irq ==
+                interrupt) {
+                return &mhu3_ctx.device_ctx_table[device_idx];
+            }
+        }
+
+        return NULL;
+    }
+
+    if ((interrupt < mhu3_ctx.irq_min) ||
+        ((interrupt - mhu3_ctx.irq_min) >= mhu3_ctx.irq_count)) {
+        return NULL;
+    }
+
+    device_idx = mhu3_ctx.irq_device_map[interrupt - mhu3_ctx.irq_min];
+    if (device_idx >= mhu3_ctx.device_count) {
+        return NULL;
+    }
+
+    return &mhu3_ctx.device_ctx_table[device_idx];
+}
+
+static void mhu3_dbch_isr(
+    struct mhu3_device_ctx *device_ctx,
+    struct mhu3_mbx_mdbcw_reg *mdbcw_reg,
+    unsigned int channel_idx)
+{
+    struct mod_mhu3_channel_config *channel;
+    struct mhu3_channel_ctx *channel_ctx;
+
+    for (; channel_idx != MHU3_CHANNEL_IDX_NONE;
+         channel_idx = channel_ctx->next_channel_idx) {
+        channel = &(device_ctx->config->channels[channel_idx]);
+        channel_ctx = &(device_ctx->channel_ctx_table[channel_idx]);
+
+        /*
+         * Clear Doorbell flag, we should clear only the flag(bit) which is
+         * set. However, we are using only one flag(bit) of corresponding
+         * doorbell channel for communication.
+         */
+        mdbcw_reg[channel->dbch.mbx_channel].MDBCW_CLR |=
+            (1UL << channel->dbch.mbx_flag_pos);
+        if (channel_ctx->transport_id_bound) {
+            channel_ctx->transport_api->signal_message(
+                channel_ctx->transport_id);
+        }
+    }
+}
+
+static void mhu3_fch_isr(
+    struct mhu3_device_ctx *device_ctx,
+    unsigned int channel_idx)
+{
+    struct mhu3_channel_ctx *channel_ctx;
+
+    for (; channel_idx != MHU3_CHANNEL_IDX_NONE;
+         channel_idx = channel_ctx->next_channel_idx) {
+        channel_ctx = &(device_ctx->channel_ctx_table[channel_idx]);
+
+        /*
+         * We only check for whether the callback is NULL as the register
+         * callback function checks for both callback and callback_param
+         * before registering so that we can save a few cycles here.
+         */
+        if (channel_ctx->callback != NULL) {
+            channel_ctx->callback(channel_ctx->callback_param);
+        }
+    }
+}
+
 static void mhu3_isr(void)
 {
     int status;
     unsigned int interrupt;
-    unsigned int device_idx;
+    unsigned int word;
+    unsigned int bit;
+    unsigned int grp_num;
+    uint32_t pending;
+    uint32_t pending_groups;
     struct mhu3_device_ctx *device_ctx;
-    struct mod_mhu3_channel_config *channel;
-    struct mhu3_channel_ctx *channel_ctx;
     struct mhu3_mbx_reg *mbx_reg;
     struct mhu3_mbx_mdbcw_reg *mdbcw_reg;
-    unsigned int pending = 0U;
 
     status = fwk_interrupt_get_current(&interrupt);
     if (status != FWK_SUCCESS) {
         return;
     }
 
-    for (device_idx = 0U; device_idx < mhu3_ctx.device_count; device_idx++) {
-        device_ctx = &mhu3_ctx.device_ctx_table[device_idx];
-        if (device_ctx->config->irq == interrupt) {
-            break;
-        }
-    }
-
-    if (device_idx >= mhu3_ctx.device_count) {
+    device_ctx = mhu3_get_device_ctx(interrupt);
+    if (device_ctx == NULL) {
         return;
     }
+
     mbx_reg = (struct mhu3_mbx_reg *)device_ctx->config->in;
-    /*
-     * In case we need to use it for doorbell. This way we don't have to assign
-     * it every time we have a doorbell channel inside the loop
-     */
     mdbcw_reg = (struct mhu3_mbx_mdbcw_reg
                      *)((uint8_t *)mbx_reg + MHU3_MBX_MDBCW_PAGE_OFFSET);
 
-    while (pending < device_ctx->channels_count) {
-        channel = &(device_ctx->config->channels[pending]);
-        channel_ctx = &(device_ctx->channel_ctx_table[pending]);
-        switch (channel->type) {
-        case MOD_MHU3_CHANNEL_TYPE_DBCH:
-            /*
-             * This implementation will not work if configured hardware(MHU3)
-             * requires to support more than 32 doorbell channels.
-             *
-             * Status of the interrupts of doorbell channel
-             * is read using MBX_DBCH_INT_ST<n> register where
-             * n = 0..3, that is, each 32 bits of MBX_DBCH_INT_ST<n> will
-             * indicate status of each corresponding doorbell channel
-             * 0b1 indicates interrupt pending.
-             *
-             * NOTE: We only check MBX_DBCH_INT_ST[0] because
-             * although MHUv3 supports upto 128 channels, it is not
-             * expected hardware to be configured more than 32 channels.
-             */
-            if (((1u << channel->dbch.mbx_channel) &
-                 mbx_reg->MBX_DBCH_INT_ST[0]) != 0u) {
-                /*
-                 * Clear Doorbell flag, we should clear only the flag(bit) which
-                 * is set. However, we are using only one flag(bit) of
-                 * corresponding doorbell channel for communication.
-                 */
-                mdbcw_reg[channel->dbch.mbx_channel].MDBCW_CLR |=
-                    (1UL << channel->dbch.mbx_flag_pos);
-                if (channel_ctx->transport_id_bound) {
-                    channel_ctx->transport_api->signal_message(
-                        channel_ctx->transport_id);
-                }
-            }
-            break;
+    /*
+     * Status of the interrupts of doorbell channels is read using the
+     * MBX_DBCH_INT_ST<n> registers where n = 0..3, each bit of a register
+     * indicating whether an interrupt is pending for the corresponding
+     * doorbell channel. Each register holding a configured channel is read
+     * once and only the channels with a pending interrupt are handled.
+     */
+    for (word = 0U; word < device_ctx->dbch_int_st_count; word++) {
+        if (device_ctx->dbch_int_mask[word] == 0U) {
+            continue;
+        }
 
-        case MOD_MHU3_CHANNEL_TYPE_FCH:
-            if (((mbx_reg->MBX_FCH_GRP_INT_ST[channel->fch.grp_num] >>
-                  channel->fch.idx) &
-                 1u) != 0u) {
-                channel_ctx = &(device_ctx->channel_ctx_table[pending]);
-                /*
-                 * We only check for whether the callback is NULL as the
-                 * register callback function checks for both callback and
-                 * callback_param before registering so that we can save a few
-                 * cycles here.
-                 */
-                if (channel_ctx->callback != NULL) {
-                    channel_ctx->callback(channel_ctx->callback_param);
-                }
-            }
-            break;
+        pending = mbx_reg->MBX_DBCH_INT_ST[word] &
+            device_ctx->dbch_int_mask[word];
+        while (pending != 0U) {
+            bit = (unsigned int)__builtin_ctz(pending);
+            pending &= pending - 1U;
 
-        default:
-            break;
+            mhu3_dbch_isr(
+                device_ctx,
+                mdbcw_reg,
+                device_ctx->dbch_channel_map[word * MHU3_INT_ST_BITS + bit]);
+        }
+    }
+
+    if (device_ctx->fcg_int_mask == 0U) {
+        return;
+    }
+
+    /* Only the Fast Channel Groups with a pending interrupt are read */
+    pending_groups = mbx_reg->MBX_FCG_INT_ST & device_ctx->fcg_int_mask;
+    while (pending_groups != 0U) {
+        grp_num = (unsigned int)__builtin_ctz(pending_groups);
+        pending_groups &= pending_groups - 1U;
+
+        pending = mbx_reg->MBX_FCH_GRP_INT_ST[grp_num] &
+            device_ctx->fch_int_mask[grp_num];
+        while (pending != 0U) {
+            bit = (unsigned int)__builtin_ctz(pending);
+            pending &= pending - 1U;
+
+            mhu3_fch_isr(
+                device_ctx,
+                device_ctx
+                    ->fch_channel_map[grp_num * MHU3_INT_ST_BITS + bit]);
         }
-        pending++;
     }
 }
 
@@ -346,6 +451,113 @@ static struct mod_transport_driver_api mhu3_mod_transport_driver_api = {
 #endif
 };
 
+/*
+ * Build the tables used by the interrupt handler to find the channels
+ * signalled by each bit of the interrupt status registers of a device.
+ */
+static int mhu3_channel_maps_init(struct mhu3_device_ctx *device_ctx)
+{
+    struct mod_mhu3_channel_config *channel;
+    struct mhu3_channel_ctx *channel_ctx;
+    unsigned int *map_entry;
+    unsigned int channel_idx;
+    unsigned int map_size;
+    unsigned int fcg_count = 0U;
+    unsigned int i;
+
+    for (channel_idx = 0U; channel_idx < device_ctx->channels_count;
+         channel_idx++) {
+        channel = &(device_ctx->config->channels[channel_idx]);
+
+        switch (channel->type) {
+        case MOD_MHU3_CHANNEL_TYPE_DBCH:
+            if (channel->dbch.mbx_channel >= MHU3_MAX_DOORBELL_CHANNELS) {
+                return FWK_E_PARAM;
+            }
+            device_ctx->dbch_int_st_count = FWK_MAX(
+                device_ctx->dbch_int_st_count,
+                (channel->dbch.mbx_channel / MHU3_INT_ST_BITS) + 1U);
+            break;
+
+        case MOD_MHU3_CHANNEL_TYPE_FCH:
+            if (channel->fch.grp_num >= MHU3_MAX_FCH_GROUPS) {
+                return FWK_E_PARAM;
+            }
+            fcg_count = FWK_MAX(fcg_count, channel->fch.grp_num + 1U);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    if (device_ctx->dbch_int_st_count != 0U) {
+        map_size = device_ctx->dbch_int_st_count * MHU3_INT_ST_BITS;
+        device_ctx->dbch_channel_map =
+            fwk_mm_alloc(map_size, sizeof(device_ctx->dbch_channel_map[0]));
+        for (i = 0U; i < map_size; i++) {
+            device_ctx->dbch_channel_map[i] = MHU3_CHANNEL_IDX_NONE;
+        }
+    }
+
+    if (fcg_count != 0U) {
+        map_size = fcg_count * MHU3_INT_ST_BITS;
+        device_ctx->fch_int_mask =
+            fwk_mm_calloc(fcg_count, sizeof(device_ctx->fch_int_mask[0]));
+        device_ctx->fch_channel_map =
+            fwk_mm_alloc(map_size, sizeof(device_ctx->fch_channel_map[0]));
+        for (i = 0U; i < map_size; i++) {
+            device_ctx->fch_channel_map[i] = MHU3_CHANNEL_IDX_NONE;
+        }
+    }
+
+    /*
+     * Channels sharing a status bit are chained in the order of their
+     * configuration, hence the reverse iteration.
+     */
+    for (channel_idx = device_ctx->channels_count; channel_idx > 0U;
+         channel_idx--) {
+        channel = &(device_ctx->config->channels[channel_idx - 1U]);
+        channel_ctx = &(device_ctx->channel_ctx_table[channel_idx - 1U]);
+        channel_ctx->next_channel_idx = MHU3_CHANNEL_IDX_NONE;
+
+        switch (channel->type) {
+        case MOD_MHU3_CHANNEL_TYPE_DBCH:
+            device_ctx->dbch_int_mask
+                [channel->dbch.mbx_channel / MHU3_INT_ST_BITS] |=
+                (UINT32_C(1) << (channel->dbch.mbx_channel % MHU3_INT_ST_BITS));
+            map_entry =
+                &device_ctx->dbch_channel_map[channel->dbch.mbx_channel];
+            break;
+
+        case MOD_MHU3_CHANNEL_TYPE_FCH:
+            /*
+             * The interrupt of a Fast Channel is reported in the status
+             * register of its group, a channel with an index beyond its
+             * width cannot be signalled.
+             */
+            if (channel->fch.idx >= MHU3_INT_ST_BITS) {
+                continue;
+            }
+            device_ctx->fcg_int_mask |= UINT32_C(1) << channel->fch.grp_num;
+            device_ctx->fch_int_mask[channel->fch.grp_num] |= UINT32_C(1)
+                << channel->fch.idx;
+            map_entry = &device_ctx->fch_channel_map
+                             [channel->fch.grp_num * MHU3_INT_ST_BITS +
+                              channel->fch.idx];
+            break;
+
+        default:
+            continue;
+        }
+
+        channel_ctx->next_channel_idx = *map_entry;
+        *map_entry = channel_idx - 1U;
+    }
+
+    return FWK_SUCCESS;
+}
+
 /*
  * Framework handlers
  */
@@ -469,7 +681,58 @@ static int mhu3_device_init(
         }
     }
 
-    return status;
+    if (status != FWK_SUCCESS) {
+        return status;
+    }
+
+    return mhu3_channel_maps_init(device_ctx);
+}
+
+static int mhu3_post_init(fwk_id_t module_id)
+{
+    unsigned int device_idx;
+    unsigned int irq;
+    unsigned int irq_max = 0U;
+    unsigned int i;
+
+    mhu3_ctx.irq_min = 0U;
+    mhu3_ctx.irq_count = 0U;
+    mhu3_ctx.irq_device_map = NULL;
+
+    if (mhu3_ctx.device_count == 0U) {
+        return FWK_SUCCESS;
+    }
+
+    /*
+     * Build the IRQ to device table used by the interrupt handler, unless the
+     * receive interrupts of the MHU devices are too far apart. The devices
+     * are then searched linearly.
+     */
+    mhu3_ctx.irq_min = UINT_MAX;
+    for (device_idx = 0U; device_idx < mhu3_ctx.device_count; device_idx++) {
+        irq = mhu3_ctx.device_ctx_table[device_idx].config->irq;
+        mhu3_ctx.irq_min = FWK_MIN(mhu3_ctx.irq_min, irq);
+        irq_max = FWK_MAX(irq_max, irq);
+    }
+
+    if ((irq_max - mhu3_ctx.irq_min) >= MHU3_IRQ_DEVICE_MAP_SPAN_MAX) {
+        return FWK_SUCCESS;
+    }
+
+    mhu3_ctx.irq_count = irq_max - mhu3_ctx.irq_min + 1U;
+    mhu3_ctx.irq_device_map = fwk_mm_alloc(
+        mhu3_ctx.irq_count, sizeof(mhu3_ctx.irq_device_map[0]));
+    for (i = 0U; i < mhu3_ctx.irq_count; i++) {
+        mhu3_ctx.irq_device_map[i] = mhu3_ctx.device_count;
+    }
+
+    /* The first device using an IRQ handles it */
+    for (device_idx = mhu3_ctx.device_count; device_idx > 0U; device_idx--) {
+        irq = mhu3_ctx.device_ctx_table[device_idx - 1U].config->irq;
+        mhu3_ctx.irq_device_map[irq - mhu3_ctx.irq_min] = device_idx - 1U;
+    }
+
+    return FWK_SUCCESS;
 }
 
 static int mhu3_bind(fwk_id_t id, unsigned int round)
@@ -597,6 +860,7 @@ const struct fwk_module module_mhu3 = {
     .api_count = (unsigned int)MOD_MHU3_API_IDX_COUNT,
     .init = mhu3_init,
     .element_init = mhu3_device_init,
+    .post_init = mhu3_post_init,
     .bind = mhu3_bind,
     .start = mhu3_start,
     .process_bind_request = mhu3_process_bind_request,
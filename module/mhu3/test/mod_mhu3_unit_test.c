@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2022-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2022-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -34,6 +34,28 @@ struct mhu3_pbx_pdbcw_reg *fake_device_1_pdbcw;
 struct mhu3_mbx_reg *fake_device_1_mbx_base;
 struct mhu3_mbx_mdbcw_reg *fake_device_1_mdbcw;
 
+static unsigned int fake_signal_message_count;
+
+static int fake_signal_message(fwk_id_t channel_id)
+{
+    fake_signal_message_count++;
+    return FWK_SUCCESS;
+}
+
+static const struct mod_transport_driver_input_api fake_transport_api = {
+    .signal_message = fake_signal_message,
+};
+
+/* Helper function to set the interrupt status of the fake MBX */
+static void mhu3_fake_set_int_st(uint32_t dbch_int_st, uint32_t fch_grp_int_st)
+{
+    *((uint32_t *)&fake_device_1_mbx_base->MBX_DBCH_INT_ST[0]) = dbch_int_st;
+    *((uint32_t *)&fake_device_1_mbx_base->MBX_FCG_INT_ST) =
+        (fch_grp_int_st != 0U) ? 1U : 0U;
+    *((uint32_t *)&fake_device_1_mbx_base->MBX_FCH_GRP_INT_ST[0]) =
+        fch_grp_int_st;
+}
+
 void setUp(void)
 {
 }
@@ -444,8 +466,11 @@ void test_mhu3_get_fch_interrupt_type_valid(void)
     TEST_ASSERT(fch_interrupt_type == MOD_TRANSPORT_FCH_INTERRUPT_TYPE_HW);
 }
 
+static unsigned int fch_callback_count;
+
 void fch_callback_test(uintptr_t param)
 {
+    fch_callback_count++;
 }
 void test_mhu3_fch_register_callback_valid(void)
 {
@@ -501,6 +526,148 @@ void test_mhu3_fch_register_callback_null_callback_addr(void)
     TEST_ASSERT(status == FWK_E_PARAM);
 }
 
+/*!
+ * \brief mhu3 unit test: mhu3_isr(), pending doorbell channel.
+ *
+ *  \details Handle case where a doorbell channel interrupt is pending and the
+ *      bound transport channel is signalled.
+ */
+void test_mhu3_isr_dbch_pending(void)
+{
+    unsigned int interrupt = MHU3_FAKE_IRQ_COMBINED;
+    struct mhu3_device_ctx *device_ctx;
+    struct mhu3_channel_ctx *channel_ctx;
+
+    device_ctx = &mhu3_ctx.device_ctx_table[MHU3_DEVICE_IDX_DEVICE_1];
+    channel_ctx =
+        &device_ctx->channel_ctx_table[FAKE_DEVICE_1_CHANNEL_DBCH_0_IDX];
+    channel_ctx->transport_id_bound = true;
+    channel_ctx->transport_api = &fake_transport_api;
+
+    mhu3_fake_set_int_st(1U << FAKE_DEVICE_1_CHANNEL_DBCH_0, 0U);
+    fake_signal_message_count = 0U;
+    fch_callback_count = 0U;
+
+    fwk_interrupt_get_current_ExpectAnyArgsAndReturn(FWK_SUCCESS);
+    fwk_interrupt_get_current_ReturnThruPtr_interrupt(&interrupt);
+    mhu3_isr();
+
+    TEST_ASSERT_EQUAL(1, fake_signal_message_count);
+    TEST_ASSERT_EQUAL(0, fch_callback_count);
+
+    channel_ctx->transport_id_bound = false;
+}
+
+/*!
+ * \brief mhu3 unit test: mhu3_isr(), pending fast channel.
+ *
+ *  \details Handle case where a fast channel interrupt is pending and the
+ *      callbacks of all the channels sharing its status bit are called.
+ */
+void test_mhu3_isr_fch_pending(void)
+{
+    unsigned int interrupt = MHU3_FAKE_IRQ_COMBINED;
+    struct mhu3_device_ctx *device_ctx;
+    struct mhu3_channel_ctx *channel_ctx_in;
+    struct mhu3_channel_ctx *channel_ctx_out;
+
+    device_ctx = &mhu3_ctx.device_ctx_table[MHU3_DEVICE_IDX_DEVICE_1];
+    channel_ctx_in =
+        &device_ctx->channel_ctx_table[FAKE_DEVICE_1_CHANNEL_FCH_0_IN_IDX];
+    channel_ctx_out =
+        &device_ctx->channel_ctx_table[FAKE_DEVICE_1_CHANNEL_FCH_0_OUT_IDX];
+    channel_ctx_in->callback = fch_callback_test;
+    channel_ctx_out->callback = fch_callback_test;
+
+    mhu3_fake_set_int_st(0U, 1U << FAKE_DEVICE_CHANNEL_FCH_0);
+    fake_signal_message_count = 0U;
+    fch_callback_count = 0U;
+
+    fwk_interrupt_get_current_ExpectAnyArgsAndReturn(FWK_SUCCESS);
+    fwk_interrupt_get_current_ReturnThruPtr_interrupt(&interrupt);
+    mhu3_isr();
+
+    TEST_ASSERT_EQUAL(0, fake_signal_message_count);
+    TEST_ASSERT_EQUAL(2, fch_callback_count);
+
+    channel_ctx_in->callback = NULL;
+    channel_ctx_out->callback = NULL;
+}
+
+/*!
+ * \brief mhu3 unit test: mhu3_isr(), interrupt of no device.
+ *
+ *  \details Handle case where the current interrupt is not the receive
+ *      interrupt of a device and no channel is signalled.
+ */
+void test_mhu3_isr_unknown_irq(void)
+{
+    unsigned int interrupt = MHU3_FAKE_IRQ_PBX;
+    struct mhu3_device_ctx *device_ctx;
+    struct mhu3_channel_ctx *channel_ctx;
+
+    device_ctx = &mhu3_ctx.device_ctx_table[MHU3_DEVICE_IDX_DEVICE_1];
+    channel_ctx =
+        &device_ctx->channel_ctx_table[FAKE_DEVICE_1_CHANNEL_DBCH_0_IDX];
+    channel_ctx->transport_id_bound = true;
+    channel_ctx->transport_api = &fake_transport_api;
+
+    mhu3_fake_set_int_st(1U << FAKE_DEVICE_1_CHANNEL_DBCH_0, 0U);
+    fake_signal_message_count = 0U;
+
+    fwk_interrupt_get_current_ExpectAnyArgsAndReturn(FWK_SUCCESS);
+    fwk_interrupt_get_current_ReturnThruPtr_interrupt(&interrupt);
+    mhu3_isr();
+
+    TEST_ASSERT_EQUAL(0, fake_signal_message_count);
+
+    channel_ctx->transport_id_bound = false;
+}
+
+/*!
+ * \brief mhu3 unit test: mhu3_post_init(), no device.
+ *
+ *  \details Handle case where the module has no device, no IRQ to device
+ *      table is built.
+ */
+void test_mhu3_post_init_no_device(void)
+{
+    int status;
+    unsigned int device_count = mhu3_ctx.device_count;
+    fwk_id_t module_id = FWK_ID_MODULE(FWK_MODULE_IDX_MHU3);
+
+    mhu3_ctx.device_count = 0U;
+    status = mhu3_post_init(module_id);
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+    TEST_ASSERT_EQUAL(0U, mhu3_ctx.irq_count);
+    TEST_ASSERT_NULL(mhu3_ctx.irq_device_map);
+    TEST_ASSERT_NULL(mhu3_get_device_ctx(MHU3_FAKE_IRQ_COMBINED));
+
+    mhu3_ctx.device_count = device_count;
+    status = mhu3_post_init(module_id);
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+}
+
+/*!
+ * \brief mhu3 unit test: mhu3_get_device_ctx(), linear search.
+ *
+ *  \details Handle case where the IRQ numbers of the devices are too far
+ *      apart for the IRQ to device table and the devices are searched.
+ */
+void test_mhu3_get_device_ctx_linear_search(void)
+{
+    unsigned int *irq_device_map = mhu3_ctx.irq_device_map;
+
+    mhu3_ctx.irq_device_map = NULL;
+
+    TEST_ASSERT_EQUAL_PTR(
+        &mhu3_ctx.device_ctx_table[MHU3_DEVICE_IDX_DEVICE_1],
+        mhu3_get_device_ctx(MHU3_FAKE_IRQ_COMBINED));
+    TEST_ASSERT_NULL(mhu3_get_device_ctx(MHU3_FAKE_IRQ_PBX));
+
+    mhu3_ctx.irq_device_map = irq_device_map;
+}
+
 /* Helper function to setup values for unit tests */
 static int mhu3_fake_init(void)
 {
@@ -561,6 +728,12 @@ static int mhu3_fake_init(void)
         return -1;
     }
 
+    status = mhu3_post_init(module_id);
+    if (status != FWK_SUCCESS) {
+        printf("[MHU3 UT] Can not execute test cases mhu3_post_init failed\n");
+        return -1;
+    }
+
     return 0;
 }
 
@@ -599,6 +772,11 @@ int mhu3_test_main(void)
     RUN_TEST(test_mhu3_fch_register_callback_invalid_sub_element_id);
     RUN_TEST(test_mhu3_fch_register_callback_null_param);
     RUN_TEST(test_mhu3_fch_register_callback_null_callback_addr);
+    RUN_TEST(test_mhu3_isr_dbch_pending);
+    RUN_TEST(test_mhu3_isr_fch_pending);
+    RUN_TEST(test_mhu3_isr_unknown_irq);
+    RUN_TEST(test_mhu3_post_init_no_device);
+    RUN_TEST(test_mhu3_get_device_ctx_linear_search);
 
     return UNITY_END();
 }
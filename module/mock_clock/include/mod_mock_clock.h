@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2020-2021, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2020-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -22,6 +22,9 @@
  *      alongside the `clock` interface on systems that do not provide a real
  *      clock driver.
  *
+ *      The rates set during a rate transaction are only applied when the
+ *      transaction ends.
+ *
  * \warning When using this module to mock a pre-existing driver
  *      for any reason, this driver must be forced to bind to the
  *      ::MOD_MOCK_CLOCK_API_TYPE_RESPONSE_DRIVER API through its module
@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2020-2021, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2020-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -29,8 +29,17 @@ static struct mod_mock_clock_element_ctx {
      * in any specific state.
      */
     bool rate_initialized;
+
+    /* A rate set during a rate transaction is pending until it ends */
+    bool rate_pending;
+    unsigned int pending_rate_index;
 } * elements_ctx;
 
+static unsigned int elements_count;
+
+/* Whether a rate transaction is on-going */
+static bool rate_transaction_ongoing;
+
 static struct mod_mock_clock_element_ctx *mod_mock_clock_get_ctx(
     fwk_id_t element_id)
 {
@@ -89,6 +98,14 @@ static int mod_mock_clock_set_rate(
         return FWK_E_PARAM;
     }
 
+    if (rate_transaction_ongoing) {
+        ctx->pending_rate_index =
+            (unsigned int)(rate_entry - ctx->config->rate_table);
+        ctx->rate_pending = true;
+
+        return FWK_SUCCESS;
+    }
+
     ctx->current_rate_index =
         (unsigned int)(rate_entry - ctx->config->rate_table);
 
@@ -212,6 +229,44 @@ static int mod_mock_clock_update_input_rate(
     return mod_mock_clock_get_rate(clock_id, output_rate);
 }
 
+static int mod_mock_clock_begin_rate_transaction(fwk_id_t clock_id)
+{
+    if (rate_transaction_ongoing) {
+        return FWK_E_STATE;
+    }
+
+    rate_transaction_ongoing = true;
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * All the rates set during the transaction are applied at once, as a driver
+ * sharing a register between several clocks would do.
+ */
+static int mod_mock_clock_end_rate_transaction(fwk_id_t clock_id)
+{
+    unsigned int element_idx;
+    struct mod_mock_clock_element_ctx *ctx;
+
+    if (!rate_transaction_ongoing) {
+        return FWK_E_STATE;
+    }
+
+    for (element_idx = 0; element_idx < elements_count; element_idx++) {
+        ctx = &elements_ctx[element_idx];
+        if (ctx->rate_pending) {
+            ctx->current_rate_index = ctx->pending_rate_index;
+            ctx->rate_initialized = true;
+            ctx->rate_pending = false;
+        }
+    }
+
+    rate_transaction_ongoing = false;
+
+    return FWK_SUCCESS;
+}
+
 static const struct mod_clock_drv_api mod_mock_clock_driver_api = {
     .set_rate = mod_mock_clock_set_rate,
     .get_rate = mod_mock_clock_get_rate,
@@ -221,6 +276,8 @@ static const struct mod_clock_drv_api mod_mock_clock_driver_api = {
     .get_range = mod_mock_clock_get_range,
     .process_power_transition = mod_mock_clock_process_power_transition,
     .update_input_rate = mod_mock_clock_update_input_rate,
+    .begin_rate_transaction = mod_mock_clock_begin_rate_transaction,
+    .end_rate_transaction = mod_mock_clock_end_rate_transaction,
 };
 
 static const struct mod_clock_driver_response_api
@@ -234,6 +291,7 @@ static int mod_mock_clock_init(
     fwk_check(data == NULL);
 
     elements_ctx = fwk_mm_calloc(element_count, sizeof(elements_ctx[0]));
+    elements_count = element_count;
 
     return FWK_SUCCESS;
 }
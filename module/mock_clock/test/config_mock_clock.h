@@ -0,0 +1,43 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2024, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <mod_mock_clock.h>
+
+#include <fwk_element.h>
+#include <fwk_macros.h>
+
+enum clock_idx {
+    CLOCK_IDX_CLK0,
+    CLOCK_IDX_CLK1,
+    CLOCK_IDX_COUNT,
+};
+
+static const struct mod_mock_clock_rate rate_table[] = {
+    { .rate = 100 * FWK_MHZ, .divider = 4 },
+    { .rate = 200 * FWK_MHZ, .divider = 2 },
+    { .rate = 400 * FWK_MHZ, .divider = 1 },
+};
+
+static const struct fwk_element mock_clock_element_table[] = {
+    [CLOCK_IDX_CLK0] = {
+        .name = "CLK0",
+        .data = &((struct mod_mock_clock_element_cfg) {
+            .rate_table = rate_table,
+            .rate_count = FWK_ARRAY_SIZE(rate_table),
+            .default_rate = 100 * FWK_MHZ,
+        }),
+    },
+    [CLOCK_IDX_CLK1] = {
+        .name = "CLK1",
+        .data = &((struct mod_mock_clock_element_cfg) {
+            .rate_table = rate_table,
+            .rate_count = FWK_ARRAY_SIZE(rate_table),
+            .default_rate = 100 * FWK_MHZ,
+        }),
+    },
+    [CLOCK_IDX_COUNT] = { 0 },
+};
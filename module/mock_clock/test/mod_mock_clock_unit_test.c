@@ -0,0 +1,141 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2024, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "scp_unity.h"
+#include "unity.h"
+
+#include <Mockfwk_id.h>
+#include <Mockfwk_module.h>
+
+#include <mod_clock.h>
+
+#include <fwk_element.h>
+#include <fwk_macros.h>
+#include <fwk_module_idx.h>
+
+#include <string.h>
+
+#include UNIT_TEST_SRC
+#include "config_mock_clock.h"
+
+#define CLOCK_ID(idx) FWK_ID_ELEMENT(FWK_MODULE_IDX_MOCK_CLOCK, idx)
+#define CLK0_ID       CLOCK_ID(CLOCK_IDX_CLK0)
+#define CLK1_ID       CLOCK_ID(CLOCK_IDX_CLK1)
+
+static struct mod_mock_clock_element_ctx
+    element_ctx_table[CLOCK_IDX_COUNT];
+
+void setUp(void)
+{
+    unsigned int element_idx;
+
+    memset(element_ctx_table, 0, sizeof(element_ctx_table));
+    elements_ctx = element_ctx_table;
+    elements_count = CLOCK_IDX_COUNT;
+    rate_transaction_ongoing = false;
+
+    for (element_idx = 0; element_idx < CLOCK_IDX_COUNT;
+         element_idx++) {
+        element_ctx_table[element_idx].config =
+            mock_clock_element_table[element_idx].data;
+        element_ctx_table[element_idx].state = MOD_CLOCK_STATE_RUNNING;
+        element_ctx_table[element_idx].rate_initialized = true;
+    }
+}
+
+void tearDown(void)
+{
+    Mockfwk_id_Destroy();
+}
+
+static void set_rate(unsigned int element_idx, uint64_t rate)
+{
+    int status;
+
+    fwk_id_get_element_idx_ExpectAndReturn(CLOCK_ID(element_idx), element_idx);
+    status = mod_mock_clock_set_rate(
+        CLOCK_ID(element_idx), rate, MOD_CLOCK_ROUND_MODE_NONE);
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+}
+
+static uint64_t get_rate(unsigned int element_idx)
+{
+    int status;
+    uint64_t rate;
+
+    fwk_id_get_element_idx_ExpectAndReturn(CLOCK_ID(element_idx), element_idx);
+    status = mod_mock_clock_get_rate(CLOCK_ID(element_idx), &rate);
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+
+    return rate;
+}
+
+void test_mock_clock_set_rate(void)
+{
+    set_rate(CLOCK_IDX_CLK0, 200 * FWK_MHZ);
+
+    TEST_ASSERT_EQUAL(200 * FWK_MHZ, get_rate(CLOCK_IDX_CLK0));
+}
+
+void test_mock_clock_rate_transaction(void)
+{
+    int status;
+
+    status = mod_mock_clock_begin_rate_transaction(CLK0_ID);
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+
+    set_rate(CLOCK_IDX_CLK0, 200 * FWK_MHZ);
+    set_rate(CLOCK_IDX_CLK1, 400 * FWK_MHZ);
+
+    /* The rates are not applied before the end of the transaction */
+    TEST_ASSERT_EQUAL(100 * FWK_MHZ, get_rate(CLOCK_IDX_CLK0));
+    TEST_ASSERT_EQUAL(100 * FWK_MHZ, get_rate(CLOCK_IDX_CLK1));
+
+    status = mod_mock_clock_end_rate_transaction(CLK0_ID);
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+
+    TEST_ASSERT_EQUAL(200 * FWK_MHZ, get_rate(CLOCK_IDX_CLK0));
+    TEST_ASSERT_EQUAL(400 * FWK_MHZ, get_rate(CLOCK_IDX_CLK1));
+    TEST_ASSERT_FALSE(element_ctx_table[0].rate_pending);
+    TEST_ASSERT_FALSE(element_ctx_table[1].rate_pending);
+}
+
+void test_mock_clock_rate_transaction_invalid_state(void)
+{
+    int status;
+
+    status = mod_mock_clock_end_rate_transaction(CLK0_ID);
+    TEST_ASSERT_EQUAL(FWK_E_STATE, status);
+
+    status = mod_mock_clock_begin_rate_transaction(CLK0_ID);
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+
+    /* Transactions cannot be nested */
+    status = mod_mock_clock_begin_rate_transaction(CLK1_ID);
+    TEST_ASSERT_EQUAL(FWK_E_STATE, status);
+
+    status = mod_mock_clock_end_rate_transaction(CLK0_ID);
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+}
+
+int mock_clock_test_main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mock_clock_set_rate);
+    RUN_TEST(test_mock_clock_rate_transaction);
+    RUN_TEST(test_mock_clock_rate_transaction_invalid_state);
+
+    return UNITY_END();
+}
+
+#if !defined(TEST_ON_TARGET)
+int main(void)
+{
+    return mock_clock_test_main();
+}
+#endif
@@ -0,0 +1,114 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2024, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MOD_PERF_GOVERNOR_H
+#define MOD_PERF_GOVERNOR_H
+
+#include <fwk_id.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*!
+ * \ingroup GroupModules
+ *  \defgroup GroupPerfGovernor Performance Governor
+ * \{
+ */
+
+/*! Maximum number of supported cores per domain. */
+#define MOD_PERF_GOV_MAX_NUM_CORES_IN_DOMAIN 8
+
+/*!
+ * \brief Number of AMU counters read for each core.
+ *
+ * \details The core cycles counter is read first and the constant frequency
+ *      cycles counter second. This matches the layout of the architected AMU
+ *      counters group 0.
+ */
+#define MOD_PERF_GOV_AMU_COUNTER_COUNT 2
+
+/*!
+ * \brief Policy used when moving to a new performance level.
+ */
+enum mod_perf_gov_ramp {
+    /*! Move by one operating point per evaluation period. */
+    MOD_PERF_GOV_RAMP_STEP,
+
+    /*!
+     * Move to the lowest operating point that brings the load back between
+     * the thresholds.
+     */
+    MOD_PERF_GOV_RAMP_PROPORTIONAL,
+
+    /*! Move to the highest (or lowest) level allowed by the limits. */
+    MOD_PERF_GOV_RAMP_LIMIT,
+};
+
+/*!
+ * \brief Performance governor sub-element configuration.
+ *
+ * \details The configuration data of each core.
+ */
+struct mod_perf_gov_core_config {
+    /*! Identifier of the power domain associated with each core. */
+    fwk_id_t pd_id;
+
+    /*! Core initial power state when the platform starts is ON. */
+    bool core_starts_online;
+
+    /*!
+     * \brief Identifier of the AMU core cycles counter.
+     *
+     * \details The constant frequency cycles counter must follow it.
+     */
+    fwk_id_t cycle_counter_id;
+};
+
+/*!
+ * \brief Performance governor domain configuration.
+ */
+struct mod_perf_gov_domain_config {
+    /*! Identifier of the performance domain associated with this domain. */
+    fwk_id_t perf_id;
+
+    /*! List of core configurations. */
+    struct mod_perf_gov_core_config const *core_config;
+
+    /*!
+     * \brief Load, in percent, above which the level is raised.
+     *
+     * \details Must be greater than \ref down_threshold. The gap between the
+     *      two thresholds is the hysteresis band in which the level is held.
+     */
+    uint32_t up_threshold;
+
+    /*! Load, in percent, below which the level is lowered. */
+    uint32_t down_threshold;
+
+    /*! Policy used to raise the level. */
+    enum mod_perf_gov_ramp ramp_up;
+
+    /*! Policy used to lower the level. */
+    enum mod_perf_gov_ramp ramp_down;
+};
+
+/*!
+ * \brief Performance governor module configuration.
+ */
+struct mod_perf_gov_config {
+    /*! Identifier of the AMU driver API. */
+    fwk_id_t amu_api_id;
+
+    /*! Frequency of the AMU constant frequency cycles counter in Hertz. */
+    uint32_t const_counter_freq;
+};
+
+/*!
+ * \}
+ */
+
+#endif /* MOD_PERF_GOVERNOR_H */
@@ -0,0 +1,603 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2024, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <mod_dvfs.h>
+#include <mod_perf_governor.h>
+#include <mod_power_domain.h>
+#include <mod_scmi_perf.h>
+
+#include <interface_amu.h>
+
+#include <fwk_assert.h>
+#include <fwk_id.h>
+#include <fwk_log.h>
+#include <fwk_macros.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_notification.h>
+#include <fwk_status.h>
+#include <fwk_time.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Index of the counters as read from the AMU driver */
+#define PGOV_COUNTER_CYCLES 0
+#define PGOV_COUNTER_CONST  1
+
+#define PGOV_US_PER_S 1000000UL
+
+struct mod_pgov_core_ctx {
+    /* The core is online */
+    bool online;
+
+    /* The cached counters can be used to compute a delta */
+    bool counters_valid;
+
+    /* Cached counters */
+    uint64_t counters[MOD_PERF_GOV_AMU_COUNTER_COUNT];
+};
+
+struct mod_pgov_domain_ctx {
+    /* Context Domain ID */
+    fwk_id_t domain_id;
+
+    /* Number of cores to monitor */
+    uint32_t num_cores;
+
+    /* Latest perf level value as reported by the plugin handler */
+    uint32_t current_perf_level;
+
+    /* Time of the last evaluation */
+    fwk_timestamp_t last_update;
+
+    /* Number of operating points */
+    size_t opp_count;
+
+    /* Copy of the DVFS operating points, sorted by increasing level */
+    struct mod_dvfs_opp *opps;
+
+    /* Core context */
+    struct mod_pgov_core_ctx *core_ctx;
+
+    /* Domain configuration */
+    const struct mod_perf_gov_domain_config *domain_config;
+};
+
+static struct mod_pgov_ctx {
+    /* Number of domains */
+    uint32_t domain_count;
+
+    /* Domain context table */
+    struct mod_pgov_domain_ctx *domain_ctx;
+
+    /* Module configuration */
+    const struct mod_perf_gov_config *config;
+
+    /* AMU driver API */
+    struct amu_api *amu_api;
+
+    /* DVFS API */
+    const struct mod_dvfs_domain_api *dvfs_api;
+} pgov_ctx;
+
+static struct mod_pgov_domain_ctx *get_domain_ctx(fwk_id_t domain_id)
+{
+    uint32_t idx = fwk_id_get_element_idx(domain_id);
+
+    if (idx < pgov_ctx.domain_count) {
+        return &pgov_ctx.domain_ctx[idx];
+    } else {
+        return NULL;
+    }
+}
+
+static struct mod_pgov_domain_ctx *get_domain_ctx_from_perf_id(
+    fwk_id_t domain_id)
+{
+    uint32_t domain_idx;
+    /*
+     * Get the performance element id from the sub-element provided in the
+     * function argument.
+     */
+    fwk_id_t perf_id =
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, fwk_id_get_element_idx(domain_id));
+
+    for (domain_idx = 0; domain_idx < pgov_ctx.domain_count; domain_idx++) {
+        if (fwk_id_is_equal(
+                pgov_ctx.domain_ctx[domain_idx].domain_config->perf_id,
+                perf_id)) {
+            return &pgov_ctx.domain_ctx[domain_idx];
+        }
+    }
+
+    return NULL;
+}
+
+/* Compute (value * mul) / div without overflowing the intermediate product */
+static uint64_t pgov_mul_div(uint64_t value, uint64_t mul, uint64_t div)
+{
+    return ((value / div) * mul) + (((value % div) * mul) / div);
+}
+
+static uint64_t pgov_counter_delta(uint64_t now, uint64_t last)
+{
+    if (now < last) {
+        /* Counter wraparound case */
+        return (UINT64_MAX - last) + now;
+    }
+
+    return now - last;
+}
+
+/*
+ * Read the counters of a core and compute the number of cycles run and of
+ * constant frequency cycles elapsed since the previous sample.
+ */
+static int pgov_core_sample(
+    struct mod_pgov_core_ctx *core_ctx,
+    const struct mod_perf_gov_core_config *core_config,
+    uint64_t *delta_cycles,
+    uint64_t *delta_const)
+{
+    int status;
+    uint64_t counters[MOD_PERF_GOV_AMU_COUNTER_COUNT];
+
+    status = pgov_ctx.amu_api->get_counters(
+        core_config->cycle_counter_id,
+        counters,
+        MOD_PERF_GOV_AMU_COUNTER_COUNT);
+    if (status != FWK_SUCCESS) {
+        FWK_LOG_DEBUG(
+            "[PERF_GOV] %s @%d: AMU counter read fail, error=%d",
+            __func__,
+            __LINE__,
+            status);
+        return status;
+    }
+
+    *delta_cycles = pgov_counter_delta(
+        counters[PGOV_COUNTER_CYCLES], core_ctx->counters[PGOV_COUNTER_CYCLES]);
+    *delta_const = pgov_counter_delta(
+        counters[PGOV_COUNTER_CONST], core_ctx->counters[PGOV_COUNTER_CONST]);
+
+    core_ctx->counters[PGOV_COUNTER_CYCLES] = counters[PGOV_COUNTER_CYCLES];
+    core_ctx->counters[PGOV_COUNTER_CONST] = counters[PGOV_COUNTER_CONST];
+
+    if (!core_ctx->counters_valid) {
+        /* The first sample only seeds the cached counters */
+        core_ctx->counters_valid = true;
+        return FWK_E_STATE;
+    }
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Compute the load of the domain as the highest load among its online cores.
+ *
+ * The load of a core is the share of the period during which it was active,
+ * as measured by the constant frequency cycles counter. The demand is the rate
+ * of core cycles run over the period, in Hertz.
+ */
+static bool pgov_domain_load(
+    struct mod_pgov_domain_ctx *domain_ctx,
+    uint64_t elapsed_us,
+    uint32_t *load,
+    uint64_t *demand)
+{
+    uint32_t core_idx;
+    uint64_t delta_cycles, delta_const, period_const;
+    uint32_t core_load;
+    bool sampled = false;
+
+    if (elapsed_us == 0) {
+        return false;
+    }
+
+    period_const = pgov_mul_div(
+        elapsed_us, pgov_ctx.config->const_counter_freq, PGOV_US_PER_S);
+    if (period_const == 0) {
+        return false;
+    }
+
+    *load = 0;
+    *demand = 0;
+
+    for (core_idx = 0; core_idx < domain_ctx->num_cores; core_idx++) {
+        if (!domain_ctx->core_ctx[core_idx].online) {
+            continue;
+        }
+
+        if (pgov_core_sample(
+                &domain_ctx->core_ctx[core_idx],
+                &domain_ctx->domain_config->core_config[core_idx],
+                &delta_cycles,
+                &delta_const) != FWK_SUCCESS) {
+            continue;
+        }
+
+        core_load = (delta_const >= period_const) ?
+            100 :
+            (uint32_t)((delta_const * 100) / period_const);
+
+        *load = FWK_MAX(*load, core_load);
+        *demand = FWK_MAX(
+            *demand, pgov_mul_div(delta_cycles, PGOV_US_PER_S, elapsed_us));
+        sampled = true;
+    }
+
+    return sampled;
+}
+
+/* Index of the lowest operating point at or above the given level */
+static size_t pgov_find_opp_for_level(
+    const struct mod_pgov_domain_ctx *domain_ctx,
+    uint32_t level)
+{
+    size_t idx;
+
+    for (idx = 0; idx < (domain_ctx->opp_count - 1); idx++) {
+        if (domain_ctx->opps[idx].level >= level) {
+            break;
+        }
+    }
+
+    return idx;
+}
+
+/* Index of the lowest operating point at or above the given frequency (kHz) */
+static size_t pgov_find_opp_for_frequency(
+    const struct mod_pgov_domain_ctx *domain_ctx,
+    uint64_t frequency)
+{
+    size_t idx;
+
+    for (idx = 0; idx < (domain_ctx->opp_count - 1); idx++) {
+        if (domain_ctx->opps[idx].frequency >= frequency) {
+            break;
+        }
+    }
+
+    return idx;
+}
+
+/*
+ * Select the performance level of a domain from its load.
+ *
+ * Above the up threshold the level is raised and below the down threshold it
+ * is lowered, following the ramp policy of the domain. In between, the current
+ * level is held. The proportional policy targets the frequency at which the
+ * demand would load the domain halfway between the two thresholds.
+ */
+static uint32_t pgov_select_level(
+    const struct mod_pgov_domain_ctx *domain_ctx,
+    uint32_t load,
+    uint64_t demand,
+    uint32_t min_limit,
+    uint32_t max_limit)
+{
+    const struct mod_perf_gov_domain_config *config =
+        domain_ctx->domain_config;
+    size_t cur_idx, idx;
+    uint64_t target_freq;
+    uint32_t level;
+
+    cur_idx =
+        pgov_find_opp_for_level(domain_ctx, domain_ctx->current_perf_level);
+    idx = cur_idx;
+
+    /* The demand is in Hertz and the operating point frequencies in kHz */
+    target_freq =
+        ((demand * 200) / (config->up_threshold + config->down_threshold)) /
+        FWK_KHZ;
+
+    if (load >= config->up_threshold) {
+        switch (config->ramp_up) {
+        case MOD_PERF_GOV_RAMP_PROPORTIONAL:
+            idx = pgov_find_opp_for_frequency(domain_ctx, target_freq);
+            idx = FWK_MAX(idx, cur_idx + 1);
+            break;
+
+        case MOD_PERF_GOV_RAMP_LIMIT:
+            idx = domain_ctx->opp_count - 1;
+            break;
+
+        default:
+            idx = cur_idx + 1;
+            break;
+        }
+
+        idx = FWK_MIN(idx, domain_ctx->opp_count - 1);
+    } else if ((load <= config->down_threshold) && (cur_idx > 0)) {
+        switch (config->ramp_down) {
+        case MOD_PERF_GOV_RAMP_PROPORTIONAL:
+            idx = pgov_find_opp_for_frequency(domain_ctx, target_freq);
+            idx = FWK_MIN(idx, cur_idx - 1);
+            break;
+
+        case MOD_PERF_GOV_RAMP_LIMIT:
+            idx = 0;
+            break;
+
+        default:
+            idx = cur_idx - 1;
+            break;
+        }
+    }
+
+    level = domain_ctx->opps[idx].level;
+    level = FWK_MAX(level, min_limit);
+    level = FWK_MIN(level, max_limit);
+
+    return level;
+}
+
+/*
+ * Update function will be called periodically. It evaluates the load of the
+ * domain and proposes a level by narrowing the adjusted limits onto it.
+ */
+static int pgov_update(struct perf_plugins_perf_update *data)
+{
+    struct mod_pgov_domain_ctx *domain_ctx;
+    fwk_timestamp_t now;
+    uint64_t elapsed_us;
+    uint32_t load;
+    uint64_t demand;
+    uint32_t level;
+
+    domain_ctx = get_domain_ctx_from_perf_id(data->domain_id);
+    if (domain_ctx == NULL) {
+        return FWK_E_PARAM;
+    }
+
+    if (domain_ctx->opp_count == 0) {
+        return FWK_SUCCESS;
+    }
+
+    now = fwk_time_current();
+    elapsed_us =
+        fwk_time_duration_us(fwk_time_duration(domain_ctx->last_update, now));
+    domain_ctx->last_update = now;
+
+    if (!pgov_domain_load(domain_ctx, elapsed_us, &load, &demand)) {
+        return FWK_SUCCESS;
+    }
+
+    level = pgov_select_level(
+        domain_ctx,
+        load,
+        demand,
+        data->adj_min_limit[0],
+        data->adj_max_limit[0]);
+
+    data->adj_min_limit[0] = level;
+    data->adj_max_limit[0] = level;
+
+    return FWK_SUCCESS;
+}
+
+static int pgov_report(struct perf_plugins_perf_report *data)
+{
+    struct mod_pgov_domain_ctx *domain_ctx;
+
+    domain_ctx = get_domain_ctx_from_perf_id(data->dep_dom_id);
+    if (domain_ctx == NULL) {
+        return FWK_E_PARAM;
+    }
+
+    domain_ctx->current_perf_level = data->level;
+
+    return FWK_SUCCESS;
+}
+
+static struct perf_plugins_api perf_plugins_api = {
+    .update = pgov_update,
+    .report = pgov_report,
+};
+
+/*
+ * Framework handlers
+ */
+static int pgov_init(
+    fwk_id_t module_id,
+    unsigned int element_count,
+    const void *data)
+{
+    const struct mod_perf_gov_config *config = data;
+
+    if ((element_count == 0) || (config == NULL) ||
+        (config->const_counter_freq == 0)) {
+        return FWK_E_PARAM;
+    }
+
+    pgov_ctx.domain_count = element_count;
+    pgov_ctx.domain_ctx =
+        fwk_mm_calloc(element_count, sizeof(struct mod_pgov_domain_ctx));
+    pgov_ctx.config = config;
+
+    return FWK_SUCCESS;
+}
+
+static int pgov_element_init(
+    fwk_id_t domain_id,
+    unsigned int sub_element_count,
+    const void *data)
+{
+    struct mod_pgov_domain_ctx *domain_ctx;
+    const struct mod_perf_gov_domain_config *domain_config = data;
+    uint32_t core_idx;
+
+    if ((sub_element_count == 0) ||
+        (sub_element_count > MOD_PERF_GOV_MAX_NUM_CORES_IN_DOMAIN)) {
+        return FWK_E_PARAM;
+    }
+
+    fwk_assert(domain_config->core_config != NULL);
+
+    if ((domain_config->up_threshold > 100) ||
+        (domain_config->down_threshold >= domain_config->up_threshold)) {
+        return FWK_E_PARAM;
+    }
+
+    domain_ctx = get_domain_ctx(domain_id);
+    domain_ctx->domain_id = domain_id;
+    domain_ctx->num_cores = sub_element_count;
+    domain_ctx->domain_config = domain_config;
+
+    domain_ctx->core_ctx =
+        fwk_mm_calloc(sub_element_count, sizeof(struct mod_pgov_core_ctx));
+
+    for (core_idx = 0; core_idx < domain_ctx->num_cores; core_idx++) {
+        domain_ctx->core_ctx[core_idx].online =
+            domain_config->core_config[core_idx].core_starts_online;
+    }
+
+    return FWK_SUCCESS;
+}
+
+static int pgov_bind(fwk_id_t id, unsigned int round)
+{
+    int status;
+
+    /* Bind in the second round */
+    if ((round == 0) || (!fwk_module_is_valid_module_id(id))) {
+        return FWK_SUCCESS;
+    }
+
+    status = fwk_module_bind(
+        FWK_ID_MODULE(pgov_ctx.config->amu_api_id.common.module_idx),
+        pgov_ctx.config->amu_api_id,
+        &pgov_ctx.amu_api);
+    if (status != FWK_SUCCESS) {
+        return status;
+    }
+
+    return fwk_module_bind(
+        FWK_ID_MODULE(FWK_MODULE_IDX_DVFS),
+        mod_dvfs_api_id_dvfs,
+        &pgov_ctx.dvfs_api);
+}
+
+static int pgov_process_bind_request(
+    fwk_id_t source_id,
+    fwk_id_t target_id,
+    fwk_id_t api_id,
+    const void **api)
+{
+    if (fwk_id_is_equal(source_id, FWK_ID_MODULE(FWK_MODULE_IDX_SCMI_PERF))) {
+        *api = &perf_plugins_api;
+    } else {
+        return FWK_E_ACCESS;
+    }
+
+    return FWK_SUCCESS;
+}
+
+static int pgov_start(fwk_id_t id)
+{
+    int status;
+    uint32_t i;
+    size_t opp_count;
+    struct mod_pgov_domain_ctx *domain_ctx;
+    fwk_id_t perf_id;
+
+    if (fwk_module_is_valid_module_id(id)) {
+        return FWK_SUCCESS;
+    }
+
+    domain_ctx = get_domain_ctx(id);
+    perf_id = domain_ctx->domain_config->perf_id;
+
+    /* Keep a copy of the operating points of the domain */
+    status = pgov_ctx.dvfs_api->get_opp_count(perf_id, &opp_count);
+    if ((status != FWK_SUCCESS) || (opp_count == 0)) {
+        return FWK_E_DEVICE;
+    }
+
+    domain_ctx->opps = fwk_mm_calloc(opp_count, sizeof(struct mod_dvfs_opp));
+
+    for (i = 0; i < opp_count; i++) {
+        status = pgov_ctx.dvfs_api->get_nth_opp(
+            perf_id, i, &domain_ctx->opps[i]);
+        if (status != FWK_SUCCESS) {
+            return FWK_E_DEVICE;
+        }
+    }
+
+    domain_ctx->opp_count = opp_count;
+
+    /* Subscribe to core power state transition */
+    for (i = 0; i < domain_ctx->num_cores; i++) {
+        status = fwk_notification_subscribe(
+            mod_pd_notification_id_power_state_transition,
+            domain_ctx->domain_config->core_config[i].pd_id,
+            domain_ctx->domain_id);
+        if (status != FWK_SUCCESS) {
+            return status;
+        }
+    }
+
+    return FWK_SUCCESS;
+}
+
+static int pgov_process_notification(
+    const struct fwk_event *event,
+    struct fwk_event *resp_event)
+{
+    struct mod_pd_power_state_transition_notification_params *post_state_params;
+    struct mod_pgov_domain_ctx *domain_ctx;
+    struct mod_pgov_core_ctx *core_ctx;
+    uint32_t core_idx;
+
+    fwk_assert(fwk_module_is_valid_element_id(event->target_id));
+    domain_ctx = get_domain_ctx(event->target_id);
+    if (domain_ctx == NULL) {
+        return FWK_E_PARAM;
+    }
+
+    if (!fwk_id_is_equal(
+            event->id, mod_pd_notification_id_power_state_transition)) {
+        return FWK_E_PARAM;
+    }
+
+    /* Find the corresponding core */
+    for (core_idx = 0; core_idx < domain_ctx->num_cores; core_idx++) {
+        if (fwk_id_is_equal(
+                domain_ctx->domain_config->core_config[core_idx].pd_id,
+                event->source_id)) {
+            break;
+        }
+    }
+
+    if (core_idx >= domain_ctx->num_cores) {
+        return FWK_E_PARAM;
+    }
+
+    core_ctx = &domain_ctx->core_ctx[core_idx];
+    post_state_params =
+        (struct mod_pd_power_state_transition_notification_params *)
+            event->params;
+
+    core_ctx->online = (post_state_params->state == MOD_PD_STATE_ON);
+
+    /* The counters of a core are reset when it is powered off */
+    core_ctx->counters_valid = false;
+
+    return FWK_SUCCESS;
+}
+
+const struct fwk_module module_perf_governor = {
+    .type = FWK_MODULE_TYPE_SERVICE,
+    .api_count = 1,
+    .init = pgov_init,
+    .element_init = pgov_element_init,
+    .bind = pgov_bind,
+    .start = pgov_start,
+    .process_bind_request = pgov_process_bind_request,
+    .process_notification = pgov_process_notification,
+};
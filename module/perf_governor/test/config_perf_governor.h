@@ -0,0 +1,77 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2024, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <mod_dvfs.h>
+#include <mod_perf_governor.h>
+
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_module_idx.h>
+
+#include <stdint.h>
+
+/* 1 MHz constant counter: one constant cycle per microsecond */
+#define FAKE_CONST_COUNTER_FREQ 1000000UL
+
+enum fake_amu_counter {
+    FAKE_AMU_CORE0_CYCLES,
+    FAKE_AMU_CORE0_CONST,
+    FAKE_AMU_CORE1_CYCLES,
+    FAKE_AMU_CORE1_CONST,
+    FAKE_AMU_COUNT,
+};
+
+enum fake_core_idx {
+    FAKE_CORE0_IDX,
+    FAKE_CORE1_IDX,
+    FAKE_CORE_IDX_COUNT,
+};
+
+enum fake_opp_idx {
+    FAKE_OPP_0,
+    FAKE_OPP_1,
+    FAKE_OPP_2,
+    FAKE_OPP_3,
+    FAKE_OPP_COUNT,
+};
+
+static struct mod_dvfs_opp fake_opps[FAKE_OPP_COUNT] = {
+    [FAKE_OPP_0] = { .level = 100, .frequency = 100 * FWK_KHZ },
+    [FAKE_OPP_1] = { .level = 200, .frequency = 200 * FWK_KHZ },
+    [FAKE_OPP_2] = { .level = 300, .frequency = 300 * FWK_KHZ },
+    [FAKE_OPP_3] = { .level = 400, .frequency = 400 * FWK_KHZ },
+};
+
+static const struct mod_perf_gov_core_config
+    fake_core_config[FAKE_CORE_IDX_COUNT] = {
+    [FAKE_CORE0_IDX] = {
+        .pd_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_POWER_DOMAIN, 0),
+        .core_starts_online = true,
+        .cycle_counter_id = FWK_ID_SUB_ELEMENT_INIT(
+            FWK_MODULE_IDX_AMU_MMAP, 0, FAKE_AMU_CORE0_CYCLES),
+    },
+    [FAKE_CORE1_IDX] = {
+        .pd_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_POWER_DOMAIN, 1),
+        .core_starts_online = false,
+        .cycle_counter_id = FWK_ID_SUB_ELEMENT_INIT(
+            FWK_MODULE_IDX_AMU_MMAP, 1, FAKE_AMU_CORE1_CYCLES),
+    },
+};
+
+static const struct mod_perf_gov_domain_config fake_domain_config = {
+    .perf_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_DVFS, 0),
+    .core_config = fake_core_config,
+    .up_threshold = 80,
+    .down_threshold = 40,
+    .ramp_up = MOD_PERF_GOV_RAMP_STEP,
+    .ramp_down = MOD_PERF_GOV_RAMP_STEP,
+};
+
+static const struct mod_perf_gov_config fake_config = {
+    .amu_api_id = FWK_ID_API_INIT(FWK_MODULE_IDX_AMU_MMAP, 0),
+    .const_counter_freq = FAKE_CONST_COUNTER_FREQ,
+};
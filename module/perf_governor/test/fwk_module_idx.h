@@ -0,0 +1,31 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2024, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef TEST_FWK_MODULE_IDX_H
+#define TEST_FWK_MODULE_IDX_H
+
+#include <fwk_id.h>
+
+enum fwk_module_idx {
+    FWK_MODULE_IDX_PERF_GOVERNOR,
+    FWK_MODULE_IDX_DVFS,
+    FWK_MODULE_IDX_SCMI_PERF,
+    FWK_MODULE_IDX_POWER_DOMAIN,
+    FWK_MODULE_IDX_AMU_MMAP,
+    FWK_MODULE_IDX_COUNT,
+};
+
+static const fwk_id_t fwk_module_id_perf_governor =
+    FWK_ID_MODULE_INIT(FWK_MODULE_IDX_PERF_GOVERNOR);
+
+static const fwk_id_t fwk_module_id_dvfs =
+    FWK_ID_MODULE_INIT(FWK_MODULE_IDX_DVFS);
+
+static const fwk_id_t fwk_module_id_scmi_perf =
+    FWK_ID_MODULE_INIT(FWK_MODULE_IDX_SCMI_PERF);
+
+#endif /* TEST_FWK_MODULE_IDX_H */
@@ -0,0 +1,347 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2024, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "scp_unity.h"
+#include "unity.h"
+
+#include <Mockfwk_id.h>
+#include <Mockfwk_mm.h>
+#include <Mockfwk_module.h>
+#include <Mockfwk_notification.h>
+#include <config_perf_governor.h>
+
+#include <mod_power_domain.h>
+#include <mod_scmi_perf.h>
+
+#include <fwk_element.h>
+#include <fwk_macros.h>
+#include <fwk_module_idx.h>
+#include <fwk_notification.h>
+
+#include UNIT_TEST_SRC
+
+uint64_t fake_amu_counter[FAKE_AMU_COUNT];
+
+int amu_mmap_copy_data(
+    fwk_id_t start_counter_id,
+    uint64_t *counter_buff,
+    size_t num_counter)
+{
+    memcpy(
+        counter_buff,
+        &fake_amu_counter[start_counter_id.sub_element.sub_element_idx],
+        sizeof(uint64_t) * num_counter);
+    return FWK_SUCCESS;
+}
+
+int amu_mmap_return_error(
+    fwk_id_t start_counter_id,
+    uint64_t *counter_buff,
+    size_t num_counter)
+{
+    return FWK_E_RANGE;
+}
+
+struct amu_api amu_api = {
+    .get_counters = amu_mmap_copy_data,
+};
+
+static struct mod_pgov_domain_ctx dev_ctx_table[1];
+static struct mod_pgov_core_ctx core_ctx_table[FAKE_CORE_IDX_COUNT];
+static struct mod_perf_gov_domain_config domain_config;
+
+void setUp(void)
+{
+    struct mod_pgov_domain_ctx *domain_ctx;
+
+    memset(dev_ctx_table, 0, sizeof(dev_ctx_table));
+    memset(core_ctx_table, 0, sizeof(core_ctx_table));
+    memset(fake_amu_counter, 0, sizeof(fake_amu_counter));
+    domain_config = fake_domain_config;
+
+    pgov_ctx.domain_count = 1;
+    pgov_ctx.domain_ctx = domain_ctx = &dev_ctx_table[0];
+    pgov_ctx.config = &fake_config;
+    pgov_ctx.amu_api = &amu_api;
+    amu_api.get_counters = amu_mmap_copy_data;
+
+    domain_ctx->domain_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_PERF_GOVERNOR, 0);
+    domain_ctx->num_cores = FAKE_CORE_IDX_COUNT;
+    domain_ctx->opps = fake_opps;
+    domain_ctx->opp_count = FAKE_OPP_COUNT;
+    domain_ctx->core_ctx = core_ctx_table;
+    domain_ctx->domain_config = &domain_config;
+
+    core_ctx_table[FAKE_CORE0_IDX].online = true;
+}
+
+void tearDown(void)
+{
+}
+
+void utest_pgov_select_level_hold(void)
+{
+    uint32_t level;
+
+    dev_ctx_table[0].current_perf_level = 200;
+
+    level = pgov_select_level(&dev_ctx_table[0], 60, 0, 0, UINT32_MAX);
+    TEST_ASSERT_EQUAL(200, level);
+}
+
+void utest_pgov_select_level_step_up(void)
+{
+    uint32_t level;
+
+    dev_ctx_table[0].current_perf_level = 200;
+
+    level = pgov_select_level(&dev_ctx_table[0], 90, 0, 0, UINT32_MAX);
+    TEST_ASSERT_EQUAL(300, level);
+}
+
+void utest_pgov_select_level_step_up_at_max(void)
+{
+    uint32_t level;
+
+    dev_ctx_table[0].current_perf_level = 400;
+
+    level = pgov_select_level(&dev_ctx_table[0], 100, 0, 0, UINT32_MAX);
+    TEST_ASSERT_EQUAL(400, level);
+}
+
+void utest_pgov_select_level_step_down(void)
+{
+    uint32_t level;
+
+    dev_ctx_table[0].current_perf_level = 200;
+
+    level = pgov_select_level(&dev_ctx_table[0], 10, 0, 0, UINT32_MAX);
+    TEST_ASSERT_EQUAL(100, level);
+}
+
+void utest_pgov_select_level_proportional_up(void)
+{
+    uint32_t level;
+
+    domain_config.ramp_up = MOD_PERF_GOV_RAMP_PROPORTIONAL;
+    dev_ctx_table[0].current_perf_level = 200;
+
+    /* Fully loaded at 200 MHz: 333 MHz would give a 60% load */
+    level = pgov_select_level(
+        &dev_ctx_table[0], 100, 200000000, 0, UINT32_MAX);
+    TEST_ASSERT_EQUAL(400, level);
+}
+
+void utest_pgov_select_level_proportional_down(void)
+{
+    uint32_t level;
+
+    domain_config.ramp_down = MOD_PERF_GOV_RAMP_PROPORTIONAL;
+    dev_ctx_table[0].current_perf_level = 400;
+
+    /* 20% loaded at 400 MHz: 133 MHz would give a 60% load */
+    level =
+        pgov_select_level(&dev_ctx_table[0], 20, 80000000, 0, UINT32_MAX);
+    TEST_ASSERT_EQUAL(200, level);
+}
+
+void utest_pgov_select_level_proportional_up_intermediate(void)
+{
+    uint32_t level;
+
+    domain_config.ramp_up = MOD_PERF_GOV_RAMP_PROPORTIONAL;
+    dev_ctx_table[0].current_perf_level = 100;
+
+    /* Fully loaded at 150 MHz: 250 MHz would give a 60% load */
+    level = pgov_select_level(
+        &dev_ctx_table[0], 100, 150000000, 0, UINT32_MAX);
+    TEST_ASSERT_EQUAL(300, level);
+}
+
+void utest_pgov_select_level_limit_clamped(void)
+{
+    uint32_t level;
+
+    domain_config.ramp_up = MOD_PERF_GOV_RAMP_LIMIT;
+    dev_ctx_table[0].current_perf_level = 100;
+
+    level = pgov_select_level(&dev_ctx_table[0], 90, 0, 0, 300);
+    TEST_ASSERT_EQUAL(300, level);
+}
+
+void utest_pgov_select_level_min_limit(void)
+{
+    uint32_t level;
+
+    dev_ctx_table[0].current_perf_level = 100;
+
+    level = pgov_select_level(&dev_ctx_table[0], 10, 0, 200, UINT32_MAX);
+    TEST_ASSERT_EQUAL(200, level);
+}
+
+void utest_pgov_domain_load_first_sample(void)
+{
+    bool sampled;
+    uint32_t load;
+    uint64_t demand;
+
+    fake_amu_counter[FAKE_AMU_CORE0_CYCLES] = 0x1000;
+    fake_amu_counter[FAKE_AMU_CORE0_CONST] = 0x2000;
+
+    sampled = pgov_domain_load(&dev_ctx_table[0], 1000, &load, &demand);
+    TEST_ASSERT_FALSE(sampled);
+    TEST_ASSERT_TRUE(core_ctx_table[FAKE_CORE0_IDX].counters_valid);
+    TEST_ASSERT_EQUAL(
+        0x2000, core_ctx_table[FAKE_CORE0_IDX].counters[PGOV_COUNTER_CONST]);
+}
+
+void utest_pgov_domain_load(void)
+{
+    bool sampled;
+    uint32_t load;
+    uint64_t demand;
+
+    core_ctx_table[FAKE_CORE0_IDX].counters_valid = true;
+    core_ctx_table[FAKE_CORE0_IDX].counters[PGOV_COUNTER_CYCLES] = 1000;
+    core_ctx_table[FAKE_CORE0_IDX].counters[PGOV_COUNTER_CONST] = 1000;
+
+    /* Active for 500 us out of 1000 us, running 100000 cycles */
+    fake_amu_counter[FAKE_AMU_CORE0_CYCLES] = 101000;
+    fake_amu_counter[FAKE_AMU_CORE0_CONST] = 1500;
+
+    sampled = pgov_domain_load(&dev_ctx_table[0], 1000, &load, &demand);
+    TEST_ASSERT_TRUE(sampled);
+    TEST_ASSERT_EQUAL(50, load);
+    TEST_ASSERT_EQUAL_UINT64(100000000, demand);
+}
+
+void utest_pgov_domain_load_long_period(void)
+{
+    bool sampled;
+    uint32_t load;
+    uint64_t demand;
+
+    core_ctx_table[FAKE_CORE0_IDX].counters_valid = true;
+
+    /* Active for half of a 5000 s period, at 200 MHz */
+    fake_amu_counter[FAKE_AMU_CORE0_CYCLES] = 1000000000000ULL;
+    fake_amu_counter[FAKE_AMU_CORE0_CONST] = 2500000000ULL;
+
+    sampled = pgov_domain_load(
+        &dev_ctx_table[0], 5000000000ULL, &load, &demand);
+    TEST_ASSERT_TRUE(sampled);
+    TEST_ASSERT_EQUAL(50, load);
+    TEST_ASSERT_EQUAL_UINT64(200000000, demand);
+}
+
+void utest_pgov_domain_load_read_fail(void)
+{
+    bool sampled;
+    uint32_t load;
+    uint64_t demand;
+
+    core_ctx_table[FAKE_CORE0_IDX].counters_valid = true;
+    amu_api.get_counters = amu_mmap_return_error;
+
+    sampled = pgov_domain_load(&dev_ctx_table[0], 1000, &load, &demand);
+    TEST_ASSERT_FALSE(sampled);
+}
+
+void utest_pgov_counter_delta_wraparound(void)
+{
+    TEST_ASSERT_EQUAL_UINT64(5, pgov_counter_delta(2, UINT64_MAX - 3));
+}
+
+void utest_pgov_element_init_invalid_thresholds(void)
+{
+    int status;
+
+    domain_config.down_threshold = domain_config.up_threshold;
+
+    status = pgov_element_init(
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_PERF_GOVERNOR, 0),
+        FAKE_CORE_IDX_COUNT,
+        &domain_config);
+    TEST_ASSERT_EQUAL(FWK_E_PARAM, status);
+}
+
+void utest_pgov_report(void)
+{
+    int status;
+    struct perf_plugins_perf_report report = {
+        .dep_dom_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, 0),
+        .level = 300,
+    };
+
+    fwk_id_get_element_idx_ExpectAnyArgsAndReturn(0);
+    fwk_id_is_equal_ExpectAnyArgsAndReturn(true);
+
+    status = pgov_report(&report);
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+    TEST_ASSERT_EQUAL(300, dev_ctx_table[0].current_perf_level);
+}
+
+void utest_pgov_process_notification_core_on(void)
+{
+    int status;
+    struct fwk_event event = { 0 };
+    struct fwk_event resp_event = { 0 };
+    struct mod_pd_power_state_transition_notification_params *params =
+        (struct mod_pd_power_state_transition_notification_params *)
+            event.params;
+
+    event.target_id = dev_ctx_table[0].domain_id;
+    event.source_id = fake_core_config[FAKE_CORE1_IDX].pd_id;
+    event.id = mod_pd_notification_id_power_state_transition;
+    params->state = MOD_PD_STATE_ON;
+    core_ctx_table[FAKE_CORE1_IDX].counters_valid = true;
+
+    fwk_module_is_valid_element_id_ExpectAnyArgsAndReturn(true);
+    fwk_id_get_element_idx_ExpectAnyArgsAndReturn(0);
+    fwk_id_is_equal_ExpectAnyArgsAndReturn(true);
+    fwk_id_is_equal_ExpectAnyArgsAndReturn(false);
+    fwk_id_is_equal_ExpectAnyArgsAndReturn(true);
+
+    status = pgov_process_notification(&event, &resp_event);
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+    TEST_ASSERT_TRUE(core_ctx_table[FAKE_CORE1_IDX].online);
+    TEST_ASSERT_FALSE(core_ctx_table[FAKE_CORE1_IDX].counters_valid);
+}
+
+int mod_perf_governor_test_main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(utest_pgov_select_level_hold);
+    RUN_TEST(utest_pgov_select_level_step_up);
+    RUN_TEST(utest_pgov_select_level_step_up_at_max);
+    RUN_TEST(utest_pgov_select_level_step_down);
+    RUN_TEST(utest_pgov_select_level_proportional_up);
+    RUN_TEST(utest_pgov_select_level_proportional_down);
+    RUN_TEST(utest_pgov_select_level_proportional_up_intermediate);
+    RUN_TEST(utest_pgov_select_level_limit_clamped);
+    RUN_TEST(utest_pgov_select_level_min_limit);
+
+    RUN_TEST(utest_pgov_domain_load_first_sample);
+    RUN_TEST(utest_pgov_domain_load);
+    RUN_TEST(utest_pgov_domain_load_long_period);
+    RUN_TEST(utest_pgov_domain_load_read_fail);
+    RUN_TEST(utest_pgov_counter_delta_wraparound);
+
+    RUN_TEST(utest_pgov_element_init_invalid_thresholds);
+    RUN_TEST(utest_pgov_report);
+    RUN_TEST(utest_pgov_process_notification_core_on);
+
+    return UNITY_END();
+}
+
+#if !defined(TEST_ON_TARGET)
+int main(void)
+{
+    return mod_perf_governor_test_main();
+}
+#endif
@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2023-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -12,10 +12,14 @@
 #define POWER_DOMAIN_H
 
 #include <mod_power_domain.h>
+#ifdef BUILD_HAS_MOD_STATISTICS
+#    include <mod_stats.h>
+#endif
 
 #include <fwk_core.h>
 #include <fwk_id.h>
 #include <fwk_log.h>
+#include <fwk_time.h>
 
 #include <stdbool.h>
 #include <stddef.h>
@@ -140,6 +144,40 @@ struct pd_ctx {
      */
     unsigned int current_state;
 
+    /*
+     * Summary of the requested states of the children. Entry \c m is the
+     * number of children whose requested state is not allowed when the power
+     * domain is in state \c m. It is kept up to date as the children
+     * requested states change so that the children do not have to be walked
+     * through.
+     */
+    uint16_t children_requested_state_veto[MOD_PD_STATE_COUNT_MAX];
+
+    /*
+     * Summary of the current states of the children. Entry \c m is the number
+     * of children whose current state is not allowed when the power domain is
+     * in state \c m.
+     */
+    uint16_t children_current_state_veto[MOD_PD_STATE_COUNT_MAX];
+
+    /*
+     * Number of children whose requested state or current state is not
+     * MOD_PD_STATE_OFF.
+     */
+    unsigned int children_not_off_count;
+
+    /* Power state statistics, NULL if they are not collected */
+    struct mod_pd_state_stats *stats;
+
+    /* Time of the last change of the current state */
+    fwk_timestamp_t state_timestamp;
+
+    /* Time of the last power state transition request to the driver */
+    fwk_timestamp_t transition_timestamp;
+
+    /* Flag indicating if a transition requested to the driver is timed */
+    bool transition_timed;
+
     /* Pending response context */
     struct response_ctx response;
 
@@ -152,6 +190,21 @@ struct pd_ctx {
         power_state_pre_transition_notification_ctx;
 };
 
+/* Summary of the power domains of a given type that are not fully off */
+struct pd_active_summary {
+    /*
+     * Number of power domains whose requested state or current state is not
+     * MOD_PD_STATE_OFF.
+     */
+    unsigned int count;
+
+    /*
+     * Sum of the indices of these power domains. When ::count is equal to
+     * one, this is the index of the last active power domain.
+     */
+    unsigned int idx_sum;
+};
+
 struct system_suspend_ctx {
     /*
      * Flag indicating if the last core is being turned off (true) or not
@@ -207,11 +260,22 @@ struct mod_pd_mod_ctx {
     /* Context of the system power domain */
     struct pd_ctx *system_pd_ctx;
 
+    /* Summary of the core power domains that are not fully off */
+    struct pd_active_summary active_cores;
+
+    /* Summary of the cluster power domains that are not fully off */
+    struct pd_active_summary active_clusters;
+
     /* System suspend context */
     struct system_suspend_ctx system_suspend;
 
     /* System shutdown context */
     struct system_shutdown_ctx system_shutdown;
+
+#ifdef BUILD_HAS_MOD_STATISTICS
+    /* Statistics API, NULL if the statistics are not published */
+    const struct mod_stats_api *stats_api;
+#endif
 };
 
 extern struct mod_pd_mod_ctx mod_pd_ctx;
@@ -226,6 +290,7 @@ enum pd_event_idx {
     PD_EVENT_IDX_REPORT_POWER_STATE_TRANSITION,
     PD_EVENT_IDX_SYSTEM_SUSPEND,
     PD_EVENT_IDX_SYSTEM_SHUTDOWN,
+    PD_EVENT_IDX_SET_STATE_BATCH,
     PD_EVENT_COUNT
 };
 
@@ -248,6 +313,21 @@ struct pd_set_state_request {
     uint32_t composite_state;
 };
 
+/*
+ * PD_EVENT_IDX_SET_STATE_BATCH
+ * Parameters of the batched set state request event
+ */
+struct pd_set_state_batch_request {
+    /* The composite state requested for each power domain of the set */
+    uint32_t composite_state;
+
+    /*
+     * Set of power domains. Bit \c n is set if the power domain whose index
+     * is the index of the target of the request plus \c n belongs to the set.
+     */
+    uint64_t pd_mask;
+};
+
 /*
  * PD_EVENT_IDX_REPORT_POWER_STATE_TRANSITION
  * Parameters of the power state transition report event
@@ -255,6 +335,9 @@ struct pd_set_state_request {
 struct pd_power_state_transition_report {
     /* The new power state of the power domain */
     uint32_t state;
+
+    /* Time at which the new power state was reported by the driver */
+    fwk_timestamp_t timestamp;
 };
 
 /*
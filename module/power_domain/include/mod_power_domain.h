@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2015-2022, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -103,6 +103,16 @@ struct mod_power_domain_config {
 
     /*! Number of identifiers in the "authorized_id_table" table. */
     size_t authorized_id_table_size;
+
+    /*!
+     * \brief Collect the power state statistics of the power domains.
+     *
+     * \details The statistics are returned by
+     *      ::mod_pd_restricted_api::get_state_stats. When the statistics module
+     *      is part of the firmware, the residency and the number of transitions
+     *      of each power state are also published in its shared memory region.
+     */
+    bool stats_enabled;
 };
 
 /*!
@@ -268,6 +278,41 @@ enum {
      ((LEVEL_1_STATE) << MOD_PD_CS_LEVEL_1_STATE_SHIFT) | \
      ((LEVEL_0_STATE) << MOD_PD_CS_LEVEL_0_STATE_SHIFT))
 
+/*!
+ * \brief Number of buckets of the transition latency histogram.
+ */
+#define MOD_PD_LATENCY_BUCKET_COUNT 17
+
+/*!
+ * \brief Power state statistics of a power domain.
+ */
+struct mod_pd_state_stats {
+    /*! Number of transitions to each power state */
+    uint32_t transition_count[MOD_PD_STATE_COUNT_MAX];
+
+    /*!
+     * \brief Time spent in each power state in microseconds.
+     *
+     * \details The time spent so far in the current power state is included.
+     */
+    uint64_t residency_us[MOD_PD_STATE_COUNT_MAX];
+
+    /*! Longest transition latency in microseconds */
+    uint32_t max_latency_us;
+
+    /*!
+     * \brief Log2 histogram of the transition latencies.
+     *
+     * \details The latency of a transition is the time between the request to
+     *      the driver and the report of the new power state by the driver.
+     *      Bucket \c n counts the transitions that took between
+     *      <tt>2^(n-1)</tt> and <tt>2^n</tt> microseconds. Bucket 0 counts the
+     *      transitions of less than one microsecond and the last bucket also
+     *      counts all the slower transitions.
+     */
+    uint32_t latency_histogram[MOD_PD_LATENCY_BUCKET_COUNT];
+};
+
 /*!
  * \brief Power domain driver interface.
  *
@@ -510,6 +555,45 @@ struct mod_pd_restricted_api {
      */
     int (*set_state)(fwk_id_t pd_id, bool resp_requested, uint32_t state);
 
+    /*!
+     * \brief Request asynchronous power state transitions for a set of power
+     *      domains.
+     *
+     * \details The requests for all the power domains of the set are processed
+     *      as part of a single event, for instance when turning on or off
+     *      several cores of a cluster at once. Their pre-transition
+     *      notifications are sent in a single round and their drivers are
+     *      called back to back.
+     *
+     * \warning Successful completion of this function does not indicate
+     *      completion of the transitions, but instead that a request has been
+     *      submitted. The response, if requested, is sent once the requests
+     *      for all the power domains of the set have been processed and not
+     *      when the transitions have completed.
+     *
+     * \param pd_id Identifier of the first power domain of the set.
+     *
+     * \param pd_mask Set of power domains. Bit \c n is set if the power domain
+     *      whose element index is the one of \p pd_id plus \c n belongs to the
+     *      set.
+     *
+     * \param resp_requested True if the caller wants to be notified with an
+     *      event response at the end of the request processing.
+     *
+     * \param state Composite state each power domain of the set has to be put
+     *      into. See ::mod_pd_restricted_api::set_state.
+     *
+     * \retval ::FWK_SUCCESS The power state transitions were submitted.
+     * \retval ::FWK_E_ACCESS Invalid access, the framework has rejected the
+     *      call to the API.
+     * \retval ::FWK_E_PARAM One or more parameters were invalid.
+     */
+    int (*set_state_batch)(
+        fwk_id_t pd_id,
+        uint64_t pd_mask,
+        bool resp_requested,
+        uint32_t state);
+
     /*!
      * \brief Get the state of a given power domain.
      *
@@ -523,6 +607,18 @@ struct mod_pd_restricted_api {
      */
     int (*get_state)(fwk_id_t pd_id, unsigned int *state);
 
+    /*!
+     * \brief Get the power state statistics of a given power domain.
+     *
+     * \param pd_id Identifier of the power domain.
+     * \param[out] stats The power state statistics.
+     *
+     * \retval ::FWK_SUCCESS The statistics were returned.
+     * \retval ::FWK_E_PARAM The `stats` parameter was a null pointer value.
+     * \retval ::FWK_E_SUPPORT The statistics are not collected.
+     */
+    int (*get_state_stats)(fwk_id_t pd_id, struct mod_pd_state_stats *stats);
+
     /*!
      * \brief Request for a power domain to be reset.
      *
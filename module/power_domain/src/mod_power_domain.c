@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2015-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -19,11 +19,13 @@
 #include <fwk_id.h>
 #include <fwk_log.h>
 #include <fwk_macros.h>
+#include <fwk_math.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
 #include <fwk_notification.h>
 #include <fwk_status.h>
+#include <fwk_time.h>
 
 #include <inttypes.h>
 #include <stdbool.h>
@@ -85,6 +87,219 @@ static inline bool notify_system_shutdown_wrapper(
  * Utility functions
  */
 
+static bool is_fully_off(const struct pd_ctx *pd)
+{
+    return (pd->requested_state == MOD_PD_STATE_OFF) &&
+        (pd->current_state == MOD_PD_STATE_OFF);
+}
+
+/*
+ * Add (add == true) or remove (add == false) a core or cluster power domain
+ * to/from the summary of the active power domains of its type.
+ */
+static void update_active_summary(const struct pd_ctx *pd, bool add)
+{
+    struct pd_active_summary *summary;
+    unsigned int pd_idx;
+
+    if (is_fully_off(pd)) {
+        return;
+    }
+
+    switch (pd->config->attributes.pd_type) {
+    case MOD_PD_TYPE_CORE:
+        summary = &mod_pd_ctx.active_cores;
+        break;
+
+    case MOD_PD_TYPE_CLUSTER:
+        summary = &mod_pd_ctx.active_clusters;
+        break;
+
+    default:
+        return;
+    }
+
+    pd_idx = (unsigned int)(pd - mod_pd_ctx.pd_ctx_table);
+
+    if (add) {
+        summary->count++;
+        summary->idx_sum += pd_idx;
+    } else {
+        summary->count--;
+        summary->idx_sum -= pd_idx;
+    }
+}
+
+/*
+ * Add (add == true) or remove (add == false) the contribution of the requested
+ * and current states of a power domain to the children state summary of its
+ * parent.
+ */
+static void update_children_summary(const struct pd_ctx *pd, bool add)
+{
+    struct pd_ctx *parent = pd->parent;
+    unsigned int parent_state;
+    uint32_t allowed_state_mask;
+    uint32_t requested_state_mask = 0;
+    uint32_t current_state_mask = 0;
+
+    if (parent == NULL) {
+        return;
+    }
+
+    if (pd->requested_state < MOD_PD_STATE_COUNT_MAX) {
+        requested_state_mask = (uint32_t)1 << pd->requested_state;
+    }
+    if (pd->current_state < MOD_PD_STATE_COUNT_MAX) {
+        current_state_mask = (uint32_t)1 << pd->current_state;
+    }
+
+    for (parent_state = 0; parent_state < MOD_PD_STATE_COUNT_MAX;
+         parent_state++) {
+        allowed_state_mask = 0;
+        if (parent_state < pd->allowed_state_mask_table_size) {
+            allowed_state_mask = pd->allowed_state_mask_table[parent_state];
+        }
+
+        if ((allowed_state_mask & requested_state_mask) == 0) {
+            if (add) {
+                parent->children_requested_state_veto[parent_state]++;
+            } else {
+                parent->children_requested_state_veto[parent_state]--;
+            }
+        }
+
+        if ((allowed_state_mask & current_state_mask) == 0) {
+            if (add) {
+                parent->children_current_state_veto[parent_state]++;
+            } else {
+                parent->children_current_state_veto[parent_state]--;
+            }
+        }
+    }
+
+    if (!is_fully_off(pd)) {
+        if (add) {
+            parent->children_not_off_count++;
+        } else {
+            parent->children_not_off_count--;
+        }
+    }
+}
+
+/*
+ * Update the requested and current states of a power domain, the children
+ * state summary of its parent and the summary of the active power domains
+ * accordingly.
+ */
+static void set_pd_states(
+    struct pd_ctx *pd,
+    unsigned int requested_state,
+    unsigned int current_state)
+{
+    if ((pd->requested_state == requested_state) &&
+        (pd->current_state == current_state)) {
+        return;
+    }
+
+    update_children_summary(pd, false);
+    update_active_summary(pd, false);
+    pd->requested_state = requested_state;
+    pd->current_state = current_state;
+    update_children_summary(pd, true);
+    update_active_summary(pd, true);
+}
+
+static void set_requested_state(struct pd_ctx *pd, unsigned int state)
+{
+    set_pd_states(pd, state, pd->current_state);
+}
+
+static void set_current_state(struct pd_ctx *pd, unsigned int state)
+{
+    set_pd_states(pd, pd->requested_state, state);
+}
+
+static uint32_t pd_elapsed_us(fwk_timestamp_t start, fwk_timestamp_t end)
+{
+    fwk_duration_us_t elapsed_us;
+
+    if (end <= start) {
+        return 0;
+    }
+
+    elapsed_us = fwk_time_duration_us(fwk_time_duration(start, end));
+
+    return (uint32_t)FWK_MIN(elapsed_us, (fwk_duration_us_t)UINT32_MAX);
+}
+
+static unsigned int pd_latency_bucket(uint32_t latency_us)
+{
+    unsigned int bucket;
+
+    if (latency_us == 0) {
+        return 0;
+    }
+
+    bucket = fwk_math_log2(latency_us) + 1u;
+
+    return FWK_MIN(bucket, MOD_PD_LATENCY_BUCKET_COUNT - 1u);
+}
+
+static void pd_stats_count(uint32_t *counter)
+{
+    if (*counter < UINT32_MAX) {
+        (*counter)++;
+    }
+}
+
+/*
+ * Account for a change of the current state of a power domain in its power
+ * state statistics.
+ *
+ * \param pd Description of the power domain
+ * \param previous_state Power state the power domain has left
+ * \param timestamp Time at which the new power state was reported
+ */
+static void update_state_stats(
+    struct pd_ctx *pd,
+    unsigned int previous_state,
+    fwk_timestamp_t timestamp)
+{
+    struct mod_pd_state_stats *stats = pd->stats;
+    uint32_t latency_us;
+
+    if (stats == NULL) {
+        return;
+    }
+
+    if (previous_state < MOD_PD_STATE_COUNT_MAX) {
+        stats->residency_us[previous_state] +=
+            pd_elapsed_us(pd->state_timestamp, timestamp);
+    }
+    pd->state_timestamp = timestamp;
+
+    if (pd->current_state < MOD_PD_STATE_COUNT_MAX) {
+        pd_stats_count(&stats->transition_count[pd->current_state]);
+    }
+
+    if (pd->transition_timed) {
+        pd->transition_timed = false;
+
+        latency_us = pd_elapsed_us(pd->transition_timestamp, timestamp);
+        stats->max_latency_us = FWK_MAX(stats->max_latency_us, latency_us);
+        pd_stats_count(
+            &stats->latency_histogram[pd_latency_bucket(latency_us)]);
+    }
+
+#ifdef BUILD_HAS_MOD_STATISTICS
+    if (mod_pd_ctx.stats_api != NULL) {
+        (void)mod_pd_ctx.stats_api->update_domain(
+            fwk_module_id_power_domain, pd->id, pd->current_state);
+    }
+#endif
+}
+
 /* Sub-routine of 'pd_post_init()', to build the power domain tree */
 static int connect_pd_tree(void)
 {
@@ -103,6 +318,7 @@ static int connect_pd_tree(void)
             return FWK_E_DATA;
         }
         fwk_list_push_tail(&parent->children_list, &pd->child_node);
+        update_children_summary(pd, true);
     }
 
     return FWK_SUCCESS;
@@ -112,6 +328,7 @@ int initiate_power_state_transition(struct pd_ctx *pd)
 {
     int status;
     unsigned int state = pd->requested_state;
+    fwk_timestamp_t timestamp;
 
     if ((pd->driver_api->deny != NULL) &&
         pd->driver_api->deny(pd->driver_id, state)) {
@@ -124,6 +341,7 @@ int initiate_power_state_transition(struct pd_ctx *pd)
         return FWK_E_DEVICE;
     }
 
+    timestamp = fwk_time_current();
     status = pd->driver_api->set_state(pd->driver_id, state);
 
 #if FWK_LOG_LEVEL <= FWK_LOG_LEVEL_DEBUG
@@ -149,6 +367,8 @@ int initiate_power_state_transition(struct pd_ctx *pd)
 
     if (status == FWK_SUCCESS) {
         pd->state_requested_to_driver = state;
+        pd->transition_timestamp = timestamp;
+        pd->transition_timed = true;
     }
 
     return status;
@@ -197,8 +417,10 @@ static void send_pd_set_state_delayed_response(
  * \param lowest_pd  Description of the target of the 'set state' request
  * \param req_params Parameters of the 'set state' request
  * \param [out] Response event
+ *
+ * \return Status of the processing of the request
  */
-static void process_set_state_request(
+static int process_set_state_request(
     struct pd_ctx *lowest_pd,
     const struct fwk_event *event,
     struct fwk_event *resp_event)
@@ -289,7 +511,7 @@ static void process_set_state_request(
          * pending response concerning the previous requested power state.
          */
         prev_state = pd->requested_state;
-        pd->requested_state = state;
+        set_requested_state(pd, state);
         pd->power_state_pre_transition_notification_ctx.valid = false;
         send_pd_set_state_delayed_response(pd, FWK_E_OVERWRITTEN);
 
@@ -345,7 +567,7 @@ static void process_set_state_request(
             pd_in_charge_of_response = NULL;
 
             /* The power state change failed, restore the previous state */
-            pd->requested_state = prev_state;
+            set_requested_state(pd, prev_state);
             break;
         }
 
@@ -353,7 +575,7 @@ static void process_set_state_request(
     }
 
     if (!event->response_requested) {
-        return;
+        return status;
     }
 
     if (pd_in_charge_of_response != NULL) {
@@ -365,6 +587,64 @@ static void process_set_state_request(
         resp_params->status = status;
         resp_params->composite_state = composite_state;
     }
+
+    return status;
+}
+
+/*
+ * Process a 'set state batch' request
+ *
+ * All the power domains of the set are processed as part of the same event.
+ * Their pre-transition notifications are thus sent in a single round and the
+ * drivers are called back to back for the transitions that can be initiated
+ * straight away.
+ *
+ * \param first_pd Description of the target of the 'set state batch' request
+ * \param event 'set state batch' request event
+ * \param [out] resp_event Response event
+ */
+static void process_set_state_batch_request(
+    struct pd_ctx *first_pd,
+    const struct fwk_event *event,
+    struct fwk_event *resp_event)
+{
+    int status, batch_status;
+    const struct pd_set_state_batch_request *req_params;
+    struct pd_set_state_response *resp_params;
+    struct pd_set_state_request *pd_req_params;
+    struct fwk_event pd_event, pd_resp_event;
+    uint64_t pd_mask;
+    unsigned int pd_offset;
+
+    req_params = (struct pd_set_state_batch_request *)event->params;
+    resp_params = (struct pd_set_state_response *)resp_event->params;
+    pd_req_params = (struct pd_set_state_request *)pd_event.params;
+
+    /*
+     * No response is requested for the individual requests. The response to
+     * the batch is sent once all of them have been processed.
+     */
+    pd_event = (struct fwk_event){ 0 };
+    pd_req_params->composite_state = req_params->composite_state;
+
+    batch_status = FWK_SUCCESS;
+    pd_mask = req_params->pd_mask;
+
+    for (pd_offset = 0; pd_mask != 0; pd_offset++, pd_mask >>= 1) {
+        if ((pd_mask & 1) == 0) {
+            continue;
+        }
+
+        pd_resp_event = (struct fwk_event){ 0 };
+        status = process_set_state_request(
+            first_pd + pd_offset, &pd_event, &pd_resp_event);
+        if ((status != FWK_SUCCESS) && (batch_status == FWK_SUCCESS)) {
+            batch_status = status;
+        }
+    }
+
+    resp_params->status = batch_status;
+    resp_params->composite_state = req_params->composite_state;
 }
 
 /*
@@ -490,21 +770,14 @@ static void process_reset_request(
     struct pd_response *resp_params)
 {
     int status;
-    struct pd_ctx *child = NULL;
-    struct fwk_slist *c_node = NULL;
 
     status = FWK_E_PWRSTATE;
     if (pd->requested_state == MOD_PD_STATE_OFF) {
         goto exit;
     }
 
-    FWK_LIST_FOR_EACH(
-        &pd->children_list, c_node, struct pd_ctx, child_node, child)
-    {
-        if ((child->requested_state != MOD_PD_STATE_OFF) ||
-            (child->current_state != MOD_PD_STATE_OFF)) {
-            goto exit;
-        }
+    if (pd->children_not_off_count != 0) {
+        goto exit;
     }
 
     status = pd->driver_api->reset(pd->driver_id);
@@ -609,7 +882,11 @@ static void process_power_state_transition_report(
     }
 
     previous_state = pd->current_state;
-    pd->current_state = new_state;
+    set_current_state(pd, new_state);
+
+    if (new_state != previous_state) {
+        update_state_stats(pd, previous_state, report_params->timestamp);
+    }
 
 #ifdef BUILD_HAS_NOTIFICATION
     if (pd->power_state_transition_notification_ctx.pending_responses == 0 &&
@@ -665,7 +942,8 @@ static void process_power_state_transition_report(
 #endif
 
     /* Update the pd states to follow the new transition */
-    pd->requested_state = pd->state_requested_to_driver = pd->current_state;
+    pd->state_requested_to_driver = pd->current_state;
+    set_requested_state(pd, pd->current_state);
 
     if (is_deeper_state(new_state, previous_state)) {
         process_power_state_transition_report_deeper_state(pd);
@@ -686,8 +964,6 @@ static void process_system_suspend_request(
     struct pd_response *resp_params)
 {
     int status;
-    unsigned int pd_idx;
-    struct pd_ctx *pd;
     struct pd_ctx *last_core_pd = NULL;
     struct pd_ctx *last_cluster_pd = NULL;
 
@@ -695,26 +971,20 @@ static void process_system_suspend_request(
      * All core related power domains have to be in the MOD_PD_STATE_OFF state
      * but one core and its ancestors.
      */
-    for (pd_idx = 0; pd_idx < mod_pd_ctx.pd_count; pd_idx++) {
-        pd = &mod_pd_ctx.pd_ctx_table[pd_idx];
-        if ((pd->requested_state == MOD_PD_STATE_OFF) &&
-            (pd->current_state == MOD_PD_STATE_OFF)) {
-            continue;
-        }
+    if ((mod_pd_ctx.active_cores.count > 1) ||
+        (mod_pd_ctx.active_clusters.count > 1)) {
+        resp_params->status = FWK_E_STATE;
+        return;
+    }
 
-        if (pd->config->attributes.pd_type == MOD_PD_TYPE_CORE) {
-            if (last_core_pd != NULL) {
-                resp_params->status = FWK_E_STATE;
-                return;
-            }
-            last_core_pd = pd;
-        } else if (pd->config->attributes.pd_type == MOD_PD_TYPE_CLUSTER) {
-            if (last_cluster_pd != NULL) {
-                resp_params->status = FWK_E_STATE;
-                return;
-            }
-            last_cluster_pd = pd;
-        }
+    if (mod_pd_ctx.active_cores.count == 1) {
+        last_core_pd =
+            &mod_pd_ctx.pd_ctx_table[mod_pd_ctx.active_cores.idx_sum];
+    }
+
+    if (mod_pd_ctx.active_clusters.count == 1) {
+        last_cluster_pd =
+            &mod_pd_ctx.pd_ctx_table[mod_pd_ctx.active_clusters.idx_sum];
     }
 
     if (last_core_pd == NULL) {
@@ -729,9 +999,9 @@ static void process_system_suspend_request(
 
             mod_pd_ctx.system_suspend.last_core_pd = last_core_pd;
             mod_pd_ctx.system_suspend.state = req_params->state;
-            last_core_pd->requested_state =
-                last_core_pd->state_requested_to_driver =
-                    (unsigned int)MOD_PD_STATE_OFF;
+            last_core_pd->state_requested_to_driver =
+                (unsigned int)MOD_PD_STATE_OFF;
+            set_requested_state(last_core_pd, (unsigned int)MOD_PD_STATE_OFF);
         }
     }
 
@@ -810,8 +1080,9 @@ void perform_shutdown(enum mod_pd_system_shutdown system_shutdown)
                 "[PD] %s shutdown", fwk_module_get_element_name(pd_id));
         }
 
-        pd->requested_state = pd->state_requested_to_driver =
-            pd->current_state = (unsigned int)MOD_PD_STATE_OFF;
+        pd->state_requested_to_driver = (unsigned int)MOD_PD_STATE_OFF;
+        set_pd_states(
+            pd, (unsigned int)MOD_PD_STATE_OFF, (unsigned int)MOD_PD_STATE_OFF);
     }
 
     /*
@@ -958,6 +1229,62 @@ static int pd_set_state(fwk_id_t pd_id, bool response_requested, uint32_t state)
     return fwk_put_event(&req);
 }
 
+static int pd_set_state_batch(
+    fwk_id_t pd_id,
+    uint64_t pd_mask,
+    bool response_requested,
+    uint32_t state)
+{
+    struct pd_ctx *pd;
+    struct fwk_event req;
+    struct pd_set_state_batch_request *req_params =
+        (struct pd_set_state_batch_request *)(&req.params);
+    unsigned int pd_idx;
+    uint64_t mask;
+
+    if (pd_mask == 0) {
+        return FWK_E_PARAM;
+    }
+
+    pd_idx = fwk_id_get_element_idx(pd_id);
+
+    for (mask = pd_mask; mask != 0; mask >>= 1, pd_idx++) {
+        if ((mask & 1) == 0) {
+            continue;
+        }
+
+        if (pd_idx >= mod_pd_ctx.pd_count) {
+            return FWK_E_PARAM;
+        }
+
+        pd = &mod_pd_ctx.pd_ctx_table[pd_idx];
+        if (pd->cs_support) {
+            if (!is_valid_composite_state(pd, state)) {
+                return FWK_E_PARAM;
+            }
+        } else {
+            if (!is_valid_state(pd, state)) {
+                return FWK_E_PARAM;
+            }
+        }
+    }
+
+    pd = &mod_pd_ctx.pd_ctx_table[fwk_id_get_element_idx(pd_id)];
+
+    req = (struct fwk_event){
+        .id = FWK_ID_EVENT(
+            FWK_MODULE_IDX_POWER_DOMAIN, PD_EVENT_IDX_SET_STATE_BATCH),
+        .source_id = pd->driver_id,
+        .target_id = pd_id,
+        .response_requested = response_requested,
+    };
+
+    req_params->composite_state = state;
+    req_params->pd_mask = pd_mask;
+
+    return fwk_put_event(&req);
+}
+
 static int pd_get_state(fwk_id_t pd_id, unsigned int *state)
 {
     struct pd_ctx *pd = NULL;
@@ -973,6 +1300,36 @@ static int pd_get_state(fwk_id_t pd_id, unsigned int *state)
     return FWK_SUCCESS;
 }
 
+static int pd_get_state_stats(
+    fwk_id_t pd_id,
+    struct mod_pd_state_stats *stats)
+{
+    const struct pd_ctx *pd;
+
+    if (stats == NULL) {
+        return FWK_E_PARAM;
+    }
+
+    if (!fwk_module_is_valid_element_id(pd_id)) {
+        return FWK_E_PARAM;
+    }
+
+    pd = &mod_pd_ctx.pd_ctx_table[fwk_id_get_element_idx(pd_id)];
+    if (pd->stats == NULL) {
+        return FWK_E_SUPPORT;
+    }
+
+    *stats = *pd->stats;
+
+    /* Account for the time spent so far in the current state */
+    if (pd->current_state < MOD_PD_STATE_COUNT_MAX) {
+        stats->residency_us[pd->current_state] +=
+            pd_elapsed_us(pd->state_timestamp, fwk_time_current());
+    }
+
+    return FWK_SUCCESS;
+}
+
 static int pd_system_suspend(unsigned int state)
 {
     struct fwk_event req;
@@ -1047,6 +1404,7 @@ static int report_power_state_transition(
                                 FWK_MODULE_IDX_POWER_DOMAIN,
                                 PD_EVENT_IDX_REPORT_POWER_STATE_TRANSITION) };
     report_params->state = state;
+    report_params->timestamp = fwk_time_current();
 
     return fwk_put_event(&report);
 }
@@ -1087,7 +1445,9 @@ static const struct mod_pd_restricted_api pd_restricted_api = {
     .get_domain_parent_id = pd_get_domain_parent_id,
 
     .set_state = pd_set_state,
+    .set_state_batch = pd_set_state_batch,
     .get_state = pd_get_state,
+    .get_state_stats = pd_get_state_stats,
     .reset = pd_reset,
     .system_suspend = pd_system_suspend,
     .system_shutdown = pd_system_shutdown
@@ -1179,6 +1539,10 @@ static int pd_power_domain_init(
     pd->id = pd_id;
     pd->config = pd_config;
 
+    if (mod_pd_ctx.config->stats_enabled) {
+        pd->stats = fwk_mm_calloc(1, sizeof(struct mod_pd_state_stats));
+    }
+
     return FWK_SUCCESS;
 }
 
@@ -1207,6 +1571,14 @@ static int pd_bind(fwk_id_t id, unsigned int round)
     }
 
     if (fwk_id_is_type(id, FWK_ID_TYPE_MODULE)) {
+#ifdef BUILD_HAS_MOD_STATISTICS
+        if (mod_pd_ctx.config->stats_enabled) {
+            return fwk_module_bind(
+                FWK_ID_MODULE(FWK_MODULE_IDX_STATISTICS),
+                FWK_ID_API(FWK_MODULE_IDX_STATISTICS, MOD_STATS_API_IDX_STATS),
+                &mod_pd_ctx.stats_api);
+        }
+#endif
         return FWK_SUCCESS;
     }
 
@@ -1231,6 +1603,41 @@ static int pd_bind(fwk_id_t id, unsigned int round)
     return FWK_SUCCESS;
 }
 
+#ifdef BUILD_HAS_MOD_STATISTICS
+/*
+ * Publish the residency and the number of transitions of the power states of
+ * all the power domains in the shared memory region of the statistics module.
+ */
+static int pd_stats_start(void)
+{
+    int status;
+    unsigned int pd_idx;
+    const struct pd_ctx *pd;
+
+    status = mod_pd_ctx.stats_api->init_stats(
+        fwk_module_id_power_domain,
+        (int)mod_pd_ctx.pd_count,
+        (int)mod_pd_ctx.pd_count);
+    if (status != FWK_SUCCESS) {
+        return status;
+    }
+
+    for (pd_idx = 0; pd_idx < mod_pd_ctx.pd_count; pd_idx++) {
+        pd = &mod_pd_ctx.pd_ctx_table[pd_idx];
+
+        status = mod_pd_ctx.stats_api->add_domain(
+            fwk_module_id_power_domain,
+            pd->id,
+            (int)fwk_math_log2(pd->valid_state_mask) + 1);
+        if (status != FWK_SUCCESS) {
+            return status;
+        }
+    }
+
+    return mod_pd_ctx.stats_api->start_stats(fwk_module_id_power_domain);
+}
+#endif
+
 static int pd_start(fwk_id_t id)
 {
     int status;
@@ -1243,11 +1650,21 @@ static int pd_start(fwk_id_t id)
         return FWK_SUCCESS;
     }
 
+#ifdef BUILD_HAS_MOD_STATISTICS
+    if (mod_pd_ctx.stats_api != NULL) {
+        status = pd_stats_start();
+        if (status != FWK_SUCCESS) {
+            FWK_LOG_ERR("[PD] Failed to publish the statistics");
+            mod_pd_ctx.stats_api = NULL;
+        }
+    }
+#endif
+
     for (index = (int)(mod_pd_ctx.pd_count - 1); index >= 0; index--) {
         pd = &mod_pd_ctx.pd_ctx_table[index];
-        pd->requested_state = (unsigned int)MOD_PD_STATE_OFF;
         pd->state_requested_to_driver = (unsigned int)MOD_PD_STATE_OFF;
-        pd->current_state = (unsigned int)MOD_PD_STATE_OFF;
+        set_pd_states(
+            pd, (unsigned int)MOD_PD_STATE_OFF, (unsigned int)MOD_PD_STATE_OFF);
 
         /*
          * If the power domain parent is powered down, don't call the driver
@@ -1272,7 +1689,8 @@ static int pd_start(fwk_id_t id)
                 __LINE__);
 #endif
         } else {
-            pd->requested_state = pd->state_requested_to_driver = state;
+            pd->state_requested_to_driver = state;
+            set_requested_state(pd, state);
 
             if (state == MOD_PD_STATE_OFF) {
                 continue;
@@ -1363,6 +1781,13 @@ static int pd_process_event(
 
         return FWK_SUCCESS;
 
+    case (unsigned int)PD_EVENT_IDX_SET_STATE_BATCH:
+        fwk_assert(pd != NULL);
+
+        process_set_state_batch_request(pd, event, resp);
+
+        return FWK_SUCCESS;
+
     case (unsigned int)PD_EVENT_IDX_RESET:
         fwk_assert(pd != NULL);
 
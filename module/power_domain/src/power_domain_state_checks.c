@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2023-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -13,6 +13,7 @@
 #include <mod_power_domain.h>
 
 #include <fwk_assert.h>
+#include <fwk_list.h>
 #include <fwk_log.h>
 #include <fwk_macros.h>
 #include <fwk_module.h>
@@ -75,18 +76,11 @@ bool is_allowed_by_child(
 
 bool is_allowed_by_children(const struct pd_ctx *pd, unsigned int state)
 {
-    const struct pd_ctx *child = NULL;
-    struct fwk_slist *c_node = NULL;
-
-    FWK_LIST_FOR_EACH(
-        &pd->children_list, c_node, struct pd_ctx, child_node, child)
-    {
-        if (!is_allowed_by_child(child, state, child->requested_state)) {
-            return false;
-        }
+    if (state >= MOD_PD_STATE_COUNT_MAX) {
+        return fwk_list_is_empty(&pd->children_list);
     }
 
-    return true;
+    return pd->children_requested_state_veto[state] == 0;
 }
 
 #if FWK_LOG_LEVEL <= FWK_LOG_LEVEL_ERROR
@@ -259,8 +253,7 @@ bool is_upwards_transition_propagation(
 
 bool is_allowed_by_parent_and_children(struct pd_ctx *pd, unsigned int state)
 {
-    struct pd_ctx *parent, *child = NULL;
-    struct fwk_slist *c_node = NULL;
+    struct pd_ctx *parent;
 
     parent = pd->parent;
     if (parent != NULL) {
@@ -269,13 +262,9 @@ bool is_allowed_by_parent_and_children(struct pd_ctx *pd, unsigned int state)
         }
     }
 
-    FWK_LIST_FOR_EACH(
-        &pd->children_list, c_node, struct pd_ctx, child_node, child)
-    {
-        if (!is_allowed_by_child(child, state, child->current_state)) {
-            return false;
-        }
+    if (state >= MOD_PD_STATE_COUNT_MAX) {
+        return fwk_list_is_empty(&pd->children_list);
     }
 
-    return true;
+    return pd->children_current_state_veto[state] == 0;
 }
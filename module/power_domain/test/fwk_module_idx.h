@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2023-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -12,6 +12,7 @@
 
 enum fwk_module_idx {
     FWK_MODULE_IDX_POWER_DOMAIN,
+    FWK_MODULE_IDX_FAKE_DRIVER,
     FWK_MODULE_IDX_COUNT,
 };
 
@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2023-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -10,6 +10,7 @@
 
 #include <Mockfwk_module.h>
 #include <Mockfwk_notification.h>
+#include <internal/Mockfwk_core_internal.h>
 #include <Mockmod_power_domain_extra.h>
 #include <config_power_domain.h>
 #include <power_domain_utils.h>
@@ -25,6 +26,8 @@ static const char *const default_state_name_table[] = { "OFF", "ON", "SLEEP" };
 static struct mod_pd_driver_api pd_driver = {
     .set_state = pd_driver_set_state,
     .deny = pd_driver_deny,
+    .prepare_core_for_system_suspend =
+        pd_driver_prepare_core_for_system_suspend,
 };
 
 static struct pd_ctx pd_ctx[PD_IDX_COUNT];
@@ -37,6 +40,9 @@ static void init_module_ctx(void)
     mod_pd_ctx.pd_ctx_table = pd_ctx;
     mod_pd_ctx.pd_count = PD_IDX_COUNT;
     mod_pd_ctx.system_pd_ctx = &mod_pd_ctx.pd_ctx_table[PD_IDX_COUNT - 1];
+    mod_pd_ctx.active_cores = (struct pd_active_summary){ 0 };
+    mod_pd_ctx.active_clusters = (struct pd_active_summary){ 0 };
+    mod_pd_ctx.system_suspend = (struct system_suspend_ctx){ 0 };
 }
 
 static void init_pd_ctx_common_fields(void)
@@ -168,6 +174,7 @@ void tearDown(void)
     Mockfwk_module_Destroy();
     Mockmod_power_domain_extra_Destroy();
     Mockfwk_notification_Destroy();
+    Mockfwk_core_internal_Destroy();
 }
 
 static inline void prepare_mocks_for_set_state_request(
@@ -609,6 +616,274 @@ void test_state_transition_report_cluster_on_while_transition_init(void)
     TEST_ASSERT_EQUAL(MOD_PD_STATE_ON, pd_ctx[PD_IDX_CLUSTER0].current_state);
 }
 
+void test_children_summary_core_state_changes(void)
+{
+    struct pd_ctx *cluster = &pd_ctx[PD_IDX_CLUSTER0];
+    struct pd_ctx *core = &pd_ctx[PD_IDX_CLUS0CORE0];
+
+    update_children_summary(&pd_ctx[PD_IDX_CLUS0CORE0], true);
+    update_children_summary(&pd_ctx[PD_IDX_CLUS0CORE1], true);
+    TEST_ASSERT_EQUAL(
+        0, cluster->children_requested_state_veto[MOD_PD_STATE_OFF]);
+    TEST_ASSERT_EQUAL(0, cluster->children_not_off_count);
+
+    set_requested_state(core, MOD_PD_STATE_ON);
+    TEST_ASSERT_EQUAL(
+        1, cluster->children_requested_state_veto[MOD_PD_STATE_OFF]);
+    TEST_ASSERT_EQUAL(
+        0, cluster->children_requested_state_veto[MOD_PD_STATE_ON]);
+    TEST_ASSERT_EQUAL(
+        0, cluster->children_current_state_veto[MOD_PD_STATE_OFF]);
+    TEST_ASSERT_EQUAL(1, cluster->children_not_off_count);
+
+    set_current_state(core, MOD_PD_STATE_ON);
+    TEST_ASSERT_EQUAL(
+        1, cluster->children_current_state_veto[MOD_PD_STATE_OFF]);
+    TEST_ASSERT_EQUAL(1, cluster->children_not_off_count);
+
+    set_pd_states(core, MOD_PD_STATE_OFF, MOD_PD_STATE_OFF);
+    TEST_ASSERT_EQUAL(
+        0, cluster->children_requested_state_veto[MOD_PD_STATE_OFF]);
+    TEST_ASSERT_EQUAL(
+        0, cluster->children_current_state_veto[MOD_PD_STATE_OFF]);
+    TEST_ASSERT_EQUAL(0, cluster->children_not_off_count);
+}
+
+void test_reset_cluster_while_core_on_expect_error(void)
+{
+    struct pd_response resp_params;
+
+    update_children_summary(&pd_ctx[PD_IDX_CLUS0CORE0], true);
+    update_children_summary(&pd_ctx[PD_IDX_CLUS0CORE1], true);
+    pd_ctx[PD_IDX_CLUSTER0].requested_state = MOD_PD_STATE_ON;
+    pd_ctx[PD_IDX_CLUSTER0].current_state = MOD_PD_STATE_ON;
+    set_requested_state(&pd_ctx[PD_IDX_CLUS0CORE1], MOD_PD_STATE_ON);
+
+    process_reset_request(&pd_ctx[PD_IDX_CLUSTER0], &resp_params);
+    TEST_ASSERT_EQUAL(FWK_E_PWRSTATE, resp_params.status);
+}
+
+void test_system_suspend_while_two_cores_on_expect_error(void)
+{
+    struct pd_system_suspend_request req_params = { 0 };
+    struct pd_response resp_params;
+
+    set_pd_states(&pd_ctx[PD_IDX_CLUSTER0], MOD_PD_STATE_ON, MOD_PD_STATE_ON);
+    set_pd_states(
+        &pd_ctx[PD_IDX_CLUS0CORE0], MOD_PD_STATE_ON, MOD_PD_STATE_ON);
+    set_pd_states(
+        &pd_ctx[PD_IDX_CLUS0CORE1], MOD_PD_STATE_OFF, MOD_PD_STATE_ON);
+    TEST_ASSERT_EQUAL(2, mod_pd_ctx.active_cores.count);
+    TEST_ASSERT_EQUAL(1, mod_pd_ctx.active_clusters.count);
+
+    process_system_suspend_request(&req_params, &resp_params);
+    TEST_ASSERT_EQUAL(FWK_E_STATE, resp_params.status);
+}
+
+void test_system_suspend_last_core_on(void)
+{
+    struct pd_system_suspend_request req_params = { 0 };
+    struct pd_response resp_params;
+
+    set_pd_states(&pd_ctx[PD_IDX_CLUSTER1], MOD_PD_STATE_ON, MOD_PD_STATE_ON);
+    set_pd_states(
+        &pd_ctx[PD_IDX_CLUS1CORE0], MOD_PD_STATE_ON, MOD_PD_STATE_ON);
+    set_pd_states(
+        &pd_ctx[PD_IDX_CLUS1CORE1], MOD_PD_STATE_ON, MOD_PD_STATE_ON);
+    set_pd_states(
+        &pd_ctx[PD_IDX_CLUS1CORE0], MOD_PD_STATE_OFF, MOD_PD_STATE_OFF);
+    TEST_ASSERT_EQUAL(1, mod_pd_ctx.active_cores.count);
+
+    pd_driver_prepare_core_for_system_suspend_ExpectAndReturn(
+        pd_ctx[PD_IDX_CLUS1CORE1].driver_id, FWK_SUCCESS);
+
+    process_system_suspend_request(&req_params, &resp_params);
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, resp_params.status);
+    TEST_ASSERT_EQUAL_PTR(
+        &pd_ctx[PD_IDX_CLUS1CORE1], mod_pd_ctx.system_suspend.last_core_pd);
+    TEST_ASSERT_TRUE(mod_pd_ctx.system_suspend.last_core_off_ongoing);
+    TEST_ASSERT_EQUAL(
+        MOD_PD_STATE_OFF, pd_ctx[PD_IDX_CLUS1CORE1].requested_state);
+}
+
+/*
+ * Request the cores of a cluster to be turned off with a single 'set state
+ * batch' request targeting the first of them.
+ */
+static void set_state_batch_cores_off(
+    enum pd_idx first_pd_idx,
+    enum pd_idx cluster_pd_idx,
+    const enum pd_idx *core_pd_idx,
+    unsigned int core_count)
+{
+    struct fwk_event event;
+    struct fwk_event resp_event;
+    struct pd_set_state_batch_request *req_params =
+        (struct pd_set_state_batch_request *)event.params;
+    struct pd_set_state_response *resp_params =
+        (struct pd_set_state_response *)resp_event.params;
+    unsigned int i;
+
+    pd_ctx[cluster_pd_idx].requested_state = MOD_PD_STATE_ON;
+    pd_ctx[cluster_pd_idx].state_requested_to_driver = MOD_PD_STATE_ON;
+    pd_ctx[cluster_pd_idx].current_state = MOD_PD_STATE_ON;
+
+    event = (struct fwk_event){ 0 };
+    req_params->composite_state = MOD_PD_STATE_OFF;
+    req_params->pd_mask = 0;
+
+    for (i = 0; i < core_count; i++) {
+        /* The mask is relative to the target of the request */
+        req_params->pd_mask |= 1ULL << (core_pd_idx[i] - first_pd_idx);
+
+        pd_ctx[core_pd_idx[i]].requested_state = MOD_PD_STATE_ON;
+        pd_ctx[core_pd_idx[i]].state_requested_to_driver = MOD_PD_STATE_ON;
+        pd_ctx[core_pd_idx[i]].current_state = MOD_PD_STATE_ON;
+
+        is_upwards_transition_propagation_ExpectAndReturn(
+            &pd_ctx[core_pd_idx[i]], MOD_PD_STATE_OFF, false);
+        get_highest_level_from_composite_state_ExpectAndReturn(
+            &pd_ctx[core_pd_idx[i]], MOD_PD_STATE_OFF, 0);
+        get_level_state_from_composite_state_ExpectAnyArgsAndReturn(
+            MOD_PD_STATE_OFF);
+        prepare_allow_tree(true, true, true);
+        prepare_mocks_for_set_state_request(
+            core_pd_idx[i], MOD_PD_STATE_OFF, false, FWK_SUCCESS);
+        prepare_state_name(MOD_PD_STATE_OFF);
+    }
+
+    process_set_state_batch_request(
+        &pd_ctx[first_pd_idx], &event, &resp_event);
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, resp_params->status);
+
+    for (i = 0; i < core_count; i++) {
+        TEST_ASSERT_EQUAL(
+            MOD_PD_STATE_OFF, pd_ctx[core_pd_idx[i]].requested_state);
+        TEST_ASSERT_EQUAL(
+            MOD_PD_STATE_OFF, pd_ctx[core_pd_idx[i]].state_requested_to_driver);
+        TEST_ASSERT_EQUAL(
+            MOD_PD_STATE_ON, pd_ctx[core_pd_idx[i]].current_state);
+    }
+}
+
+void test_set_state_batch_cores_off(void)
+{
+    const enum pd_idx core_pd_idx[] = { PD_IDX_CLUS0CORE0, PD_IDX_CLUS0CORE1 };
+
+    set_state_batch_cores_off(
+        PD_IDX_CLUS0CORE0,
+        PD_IDX_CLUSTER0,
+        core_pd_idx,
+        FWK_ARRAY_SIZE(core_pd_idx));
+}
+
+void test_set_state_batch_cores_off_from_second_cluster(void)
+{
+    const enum pd_idx core_pd_idx[] = { PD_IDX_CLUS1CORE0, PD_IDX_CLUS1CORE1 };
+
+    pd_ctx[PD_IDX_CLUS0CORE0].requested_state = MOD_PD_STATE_ON;
+    pd_ctx[PD_IDX_CLUS0CORE1].requested_state = MOD_PD_STATE_ON;
+
+    set_state_batch_cores_off(
+        PD_IDX_CLUS1CORE0,
+        PD_IDX_CLUSTER1,
+        core_pd_idx,
+        FWK_ARRAY_SIZE(core_pd_idx));
+
+    /* The cores of the first cluster are not part of the request */
+    TEST_ASSERT_EQUAL(
+        MOD_PD_STATE_ON, pd_ctx[PD_IDX_CLUS0CORE0].requested_state);
+    TEST_ASSERT_EQUAL(
+        MOD_PD_STATE_ON, pd_ctx[PD_IDX_CLUS0CORE1].requested_state);
+}
+
+static struct fwk_event batch_event;
+
+static int put_event_callback(struct fwk_event *event, int cmock_num_calls)
+{
+    batch_event = *event;
+
+    return FWK_SUCCESS;
+}
+
+void test_set_state_batch_outside_event_context(void)
+{
+    int status;
+    unsigned int pd_idx;
+    struct pd_set_state_batch_request *req_params =
+        (struct pd_set_state_batch_request *)batch_event.params;
+
+    for (pd_idx = PD_IDX_CLUS1CORE0; pd_idx <= PD_IDX_CLUS1CORE1; pd_idx++) {
+        pd_ctx[pd_idx].driver_id =
+            FWK_ID_ELEMENT(FWK_MODULE_IDX_FAKE_DRIVER, pd_idx);
+        is_valid_composite_state_ExpectAndReturn(
+            &pd_ctx[pd_idx], MOD_PD_STATE_OFF, true);
+    }
+
+    /*
+     * Outside of an event handler the framework does not fill in the source
+     * of the event, the request must provide a valid one.
+     */
+    batch_event = (struct fwk_event){ 0 };
+    __fwk_put_event_Stub(put_event_callback);
+
+    status = pd_set_state_batch(
+        pd_ctx[PD_IDX_CLUS1CORE0].id, 0x3, false, MOD_PD_STATE_OFF);
+
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+    TEST_ASSERT_TRUE(fwk_id_is_equal(
+        pd_ctx[PD_IDX_CLUS1CORE0].driver_id, batch_event.source_id));
+    TEST_ASSERT_TRUE(
+        fwk_id_is_equal(pd_ctx[PD_IDX_CLUS1CORE0].id, batch_event.target_id));
+    TEST_ASSERT_EQUAL(0x3, req_params->pd_mask);
+    TEST_ASSERT_EQUAL(MOD_PD_STATE_OFF, req_params->composite_state);
+}
+
+void test_state_stats_core_off_to_on(void)
+{
+    struct mod_pd_state_stats stats = { 0 };
+    struct pd_ctx *pd = &pd_ctx[PD_IDX_CLUS0CORE0];
+
+    pd->stats = &stats;
+    pd->current_state = MOD_PD_STATE_ON;
+    pd->state_timestamp = FWK_US(100);
+    pd->transition_timestamp = FWK_US(990);
+    pd->transition_timed = true;
+
+    update_state_stats(pd, MOD_PD_STATE_OFF, FWK_US(1000));
+
+    TEST_ASSERT_EQUAL_UINT64(900, stats.residency_us[MOD_PD_STATE_OFF]);
+    TEST_ASSERT_EQUAL(1, stats.transition_count[MOD_PD_STATE_ON]);
+    TEST_ASSERT_EQUAL(10, stats.max_latency_us);
+    /* 10 us falls in the [8, 16) us bucket */
+    TEST_ASSERT_EQUAL(1, stats.latency_histogram[4]);
+    TEST_ASSERT_EQUAL_UINT64(FWK_US(1000), pd->state_timestamp);
+    TEST_ASSERT_FALSE(pd->transition_timed);
+
+    pd->stats = NULL;
+}
+
+void test_get_state_stats_invalid_pd_id(void)
+{
+    struct mod_pd_state_stats stats;
+    fwk_id_t pd_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_POWER_DOMAIN, PD_IDX_COUNT);
+
+    fwk_module_is_valid_element_id_ExpectAndReturn(pd_id, false);
+
+    TEST_ASSERT_EQUAL(FWK_E_PARAM, pd_get_state_stats(pd_id, &stats));
+}
+
+void test_get_state_stats_not_supported(void)
+{
+    struct mod_pd_state_stats stats;
+    fwk_id_t pd_id =
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_POWER_DOMAIN, PD_IDX_CLUS0CORE0);
+
+    fwk_module_is_valid_element_id_ExpectAndReturn(pd_id, true);
+
+    TEST_ASSERT_EQUAL(FWK_E_SUPPORT, pd_get_state_stats(pd_id, &stats));
+}
+
 int power_domain_test_main(void)
 {
     UNITY_BEGIN();
@@ -623,6 +898,16 @@ int power_domain_test_main(void)
     RUN_TEST(test_state_transition_cluster_on_expect_core_transition_init);
     RUN_TEST(test_set_state_on_core_cluster_soc_expect_cluster_transition_init);
     RUN_TEST(test_state_transition_report_cluster_on_while_transition_init);
+    RUN_TEST(test_children_summary_core_state_changes);
+    RUN_TEST(test_reset_cluster_while_core_on_expect_error);
+    RUN_TEST(test_system_suspend_while_two_cores_on_expect_error);
+    RUN_TEST(test_system_suspend_last_core_on);
+    RUN_TEST(test_set_state_batch_cores_off);
+    RUN_TEST(test_set_state_batch_cores_off_from_second_cluster);
+    RUN_TEST(test_set_state_batch_outside_event_context);
+    RUN_TEST(test_state_stats_core_off_to_on);
+    RUN_TEST(test_get_state_stats_invalid_pd_id);
+    RUN_TEST(test_get_state_stats_not_supported);
     return UNITY_END();
 }
 
@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2015-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -15,10 +15,79 @@
 #include <mod_scmi_header.h>
 
 #include <fwk_id.h>
+#include <fwk_slist.h>
+#ifdef BUILD_HAS_MOD_SCMI_LATENCY_STATS
+#    include <fwk_time.h>
+#endif
 
 #include <stddef.h>
 #include <stdint.h>
 
+/* State of an outstanding request entry */
+enum scmi_request_state {
+    /* The entry is not in use */
+    SCMI_REQUEST_STATE_FREE,
+
+    /* The request waits for the transport channel to be free */
+    SCMI_REQUEST_STATE_QUEUED,
+
+    /* The request has been transmitted and waits for its response */
+    SCMI_REQUEST_STATE_IN_FLIGHT,
+};
+
+/* Request sent or queued by an agent service */
+struct scmi_outstanding_request {
+    /* Node in the queue of requests waiting for the transport channel */
+    struct fwk_slist_node node;
+
+    /* State of the entry */
+    enum scmi_request_state state;
+
+    /* SCMI message header, including the token assigned to the request */
+    uint32_t message_header;
+
+    /* Copy of the request payload */
+    void *payload;
+
+    /* Size in number of bytes of the request payload */
+    size_t payload_size;
+
+    /* Request an acknowledgement interrupt for the request */
+    bool request_ack_by_interrupt;
+
+    /* Function called when the response is received */
+    mod_scmi_response_callback_t *callback;
+
+    /* Requester-defined value given back to the callback */
+    uintptr_t cookie;
+};
+
+#ifdef BUILD_HAS_MOD_SCMI_LATENCY_STATS
+/*
+ * Number of commands per service whose signal timestamp is kept until their
+ * delayed response is sent.
+ */
+#    define SCMI_DELAYED_COMMAND_COUNT 4
+
+/* Command awaiting its delayed response */
+struct scmi_delayed_command {
+    /* The entry is in use */
+    bool valid;
+
+    /* SCMI protocol identifier of the command */
+    uint8_t protocol_id;
+
+    /* SCMI message identifier of the command */
+    uint8_t message_id;
+
+    /* SCMI token of the command */
+    uint16_t token;
+
+    /* Timestamp of the signal of the command */
+    fwk_timestamp_t signal_timestamp;
+};
+#endif
+
 /* SCMI service context */
 struct scmi_service_ctx {
     /* Pointer to SCMI service configuration data */
@@ -59,6 +128,29 @@ struct scmi_service_ctx {
 
     /* SCMI type of the message currently being processed */
     enum mod_scmi_message_type scmi_message_type;
+
+#ifdef BUILD_HAS_MOD_SCMI_LATENCY_STATS
+    /* Timestamp of the signal of the message currently being processed */
+    fwk_timestamp_t signal_timestamp;
+
+    /* The message being processed completes with a delayed response */
+    bool delayed_response;
+
+    /* Commands awaiting their delayed response, oldest entries reused first */
+    struct scmi_delayed_command delayed_commands[SCMI_DELAYED_COMMAND_COUNT];
+#endif
+
+    /* Table of the requests sent or queued by an agent service */
+    struct scmi_outstanding_request *outstanding_requests;
+
+    /* Size of the payload buffer of each outstanding request entry */
+    size_t request_payload_size_max;
+
+    /* Queue of the requests waiting for the transport channel */
+    struct fwk_slist request_queue;
+
+    /* Token to try first for the next request */
+    uint16_t next_request_token;
 };
 
 struct scmi_protocol {
@@ -113,6 +205,16 @@ struct mod_scmi_ctx {
     /* Table of scmi notification subscribers */
     struct scmi_notification_subscribers *scmi_notif_subscribers;
 #endif
+#ifdef BUILD_HAS_MOD_SCMI_LATENCY_STATS
+    /*
+     * Table of message latency statistics, indexed by
+     * [protocol_table index][message identifier]
+     */
+    struct mod_scmi_latency_stats *latency_stats;
+
+    /* Number of protocol_table entries covered by the latency statistics */
+    unsigned int latency_stats_protocol_count;
+#endif
 };
 
 #endif /* MOD_INTERNAL_SCMI_H */
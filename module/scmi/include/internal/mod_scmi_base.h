@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2015-2022, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -140,4 +140,10 @@ int scmi_base_message_handler(
 void scmi_base_set_api(const struct mod_scmi_from_protocol_api *api);
 void scmi_base_set_shared_ctx(struct mod_scmi_ctx *scmi_ctx_param);
 
+/*
+ * Build the responses to the discovery commands. To be called once all the
+ * protocols have been bound.
+ */
+void scmi_base_discovery_init(void);
+
 #endif /* INTERNAL_MOD_SCMI_BASE_H */
@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2015-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -40,6 +40,9 @@ enum mod_scmi_api_idx {
     MOD_SCMI_API_IDX_TRANSPORT,
 #ifdef BUILD_HAS_SCMI_NOTIFICATIONS
     MOD_SCMI_API_IDX_NOTIFICATION,
+#endif
+#ifdef BUILD_HAS_MOD_SCMI_LATENCY_STATS
+    MOD_SCMI_API_IDX_LATENCY_STATS,
 #endif
     MOD_SCMI_API_IDX_COUNT,
 };
@@ -185,6 +188,19 @@ struct mod_scmi_service_config {
      * \details Determine if this entity is an agent or a platform.
      */
     enum mod_scmi_entity_role scmi_entity_role;
+
+    /*!
+     * \brief Maximum number of outstanding requests of an agent service.
+     *
+     * \details Size of the table tracking the requests sent or queued through
+     *      ::mod_scmi_from_protocol_req_api::scmi_send_request. Requests that
+     *      cannot be transmitted immediately because the transport channel is
+     *      busy are queued and sent, in order, as soon as the channel becomes
+     *      free. Zero disables request tracking for the service.
+     *
+     * \note Only applicable to services with the ::MOD_SCMI_ROLE_AGENT role.
+     */
+    unsigned int outstanding_request_count;
 };
 
 /*!
@@ -659,6 +675,102 @@ struct mod_scmi_from_protocol_api {
      */
     void (*notify)(fwk_id_t service_id, int protocol_id, int message_id,
         const void *payload, size_t size);
+
+    /*!
+     * \brief Get the token of the command being processed on a service and
+     *      announce that the command completes with a delayed response.
+     *
+     * \details Called by the message handler of an asynchronous command
+     *      before it responds to the command. The token identifies the
+     *      command when its delayed response is sent with
+     *      ::mod_scmi_from_protocol_api::send_delayed_response.
+     *
+     * \param service_id Service identifier.
+     * \param[out] token Token of the command.
+     *
+     * \retval ::FWK_SUCCESS The operation succeeded.
+     * \retval ::FWK_E_PARAM The `token` parameter was a null pointer value.
+     */
+    int (*get_delayed_response_token)(fwk_id_t service_id, uint16_t *token);
+
+    /*!
+     * \brief Send the delayed response to an asynchronous command.
+     *
+     * \details The delayed response is sent through the notification channel
+     *      associated with the service the command was received on.
+     *
+     * \param service_id Identifier of the service the command was received on.
+     * \param protocol_id Protocol identifier of the command.
+     * \param message_id Message identifier of the command.
+     * \param token Token of the command.
+     * \param payload Payload data to write.
+     * \param size Size of the payload in bytes.
+     *
+     * \retval ::FWK_SUCCESS The operation succeeded.
+     * \retval ::FWK_E_SUPPORT The service has no notification channel.
+     * \return One of the standard error codes for implementation-defined
+     *      errors.
+     */
+    int (*send_delayed_response)(
+        fwk_id_t service_id,
+        uint8_t protocol_id,
+        uint8_t message_id,
+        uint16_t token,
+        const void *payload,
+        size_t size);
+};
+
+/*!
+ * \brief SCMI response callback prototype.
+ *
+ * \details Prototype of the function called by the SCMI module when the
+ *      response to a request sent with
+ *      ::mod_scmi_from_protocol_req_api::scmi_send_request is received, or
+ *      when the request could not be transmitted.
+ *
+ * \param service_id Identifier of the SCMI service the request was sent on.
+ * \param token Token assigned to the request.
+ * \param status ::FWK_SUCCESS if a response was received, or the error
+ *      returned by the transport if the request could not be transmitted.
+ * \param payload Pointer to the response payload, NULL on error.
+ * \param payload_size Size in number of bytes of the response payload.
+ * \param cookie Value given by the requester along with the request.
+ */
+typedef void mod_scmi_response_callback_t(
+    fwk_id_t service_id,
+    uint16_t token,
+    int status,
+    const uint32_t *payload,
+    size_t payload_size,
+    uintptr_t cookie);
+
+/*!
+ * \brief SCMI request descriptor.
+ */
+struct mod_scmi_request {
+    /*! Identifier of the SCMI service to send the request on */
+    fwk_id_t service_id;
+
+    /*! SCMI protocol identifier */
+    uint8_t protocol_id;
+
+    /*! SCMI message identifier */
+    uint8_t message_id;
+
+    /*! Request payload, copied by the SCMI module */
+    const void *payload;
+
+    /*! Size in number of bytes of the request payload */
+    size_t payload_size;
+
+    /*! Request an acknowledgement interrupt for the request */
+    bool request_ack_by_interrupt;
+
+    /*! Function called when the response is received */
+    mod_scmi_response_callback_t *callback;
+
+    /*! Requester-defined value given back to the callback */
+    uintptr_t cookie;
 };
 
 /*!
@@ -694,8 +806,120 @@ struct mod_scmi_from_protocol_req_api {
      * \retval ::FWK_SUCCESS The operation succeeded.
      */
     int (*response_message_handler)(fwk_id_t service_id);
+
+    /*!
+     * \brief Send an SCMI request and track its response.
+     *
+     * \details The SCMI module assigns a token to the request that is unique
+     *      among the outstanding requests of the service, so several requests
+     *      can be outstanding at the same time. The response is matched to
+     *      its request by token and given to the request callback instead of
+     *      the protocol requester message handler. The transport channel lock
+     *      is released by the SCMI module once the callback returns.
+     *
+     * \param request Request descriptor. The payload is copied, so it does
+     *      not need to remain valid after the call.
+     * \param[out] token Token assigned to the request. May be NULL.
+     *
+     * \retval ::FWK_SUCCESS The request has been transmitted.
+     * \retval ::FWK_PENDING The transport channel is busy, the request has
+     *      been queued and will be transmitted once the channel is free.
+     * \retval ::FWK_E_PARAM An invalid parameter was encountered:
+     *      - The `request` parameter was a null pointer value.
+     *      - The `callback` field of the request was a null pointer value.
+     *      - The payload does not fit within the channel.
+     * \retval ::FWK_E_SUPPORT The service does not track requests.
+     * \retval ::FWK_E_BUSY All the outstanding request entries of the
+     *      service are in use.
+     * \return One of the standard error codes for implementation-defined
+     *      errors.
+     */
+    int (*scmi_send_request)(
+        const struct mod_scmi_request *request,
+        uint16_t *token);
 };
 
+#ifdef BUILD_HAS_MOD_SCMI_LATENCY_STATS
+/*!
+ * \brief Number of message identifiers per protocol for which latency
+ *      statistics are collected.
+ *
+ * \details Messages with an identifier greater than or equal to this value
+ *      are handled normally but are not accounted for.
+ */
+#    define MOD_SCMI_LATENCY_STATS_MESSAGE_ID_COUNT 16
+
+/*!
+ * \brief Number of buckets of the latency histograms.
+ *
+ * \details Bucket 0 counts the messages handled in less than one microsecond.
+ *      Bucket 'n' (n > 0) counts the messages handled in [2^(n-1), 2^n)
+ *      microseconds. The last bucket also counts all the slower messages.
+ */
+#    define MOD_SCMI_LATENCY_STATS_BUCKET_COUNT 16
+
+/*!
+ * \brief Latency statistics of an SCMI message.
+ *
+ * \details The latency of a message is measured from the moment the transport
+ *      signals the message to the SCMI module, to the moment the response has
+ *      been handed back to the transport, including any time spent waiting
+ *      for a deferred response.
+ */
+struct mod_scmi_latency_stats {
+    /*! Number of messages accounted for */
+    uint32_t count;
+
+    /*! Minimum latency in nanoseconds */
+    uint32_t min_ns;
+
+    /*! Maximum latency in nanoseconds */
+    uint32_t max_ns;
+
+    /*! Sum of the latencies in nanoseconds */
+    uint64_t total_ns;
+
+    /*! Log2 histogram of the latencies in microseconds */
+    uint32_t histogram[MOD_SCMI_LATENCY_STATS_BUCKET_COUNT];
+
+    /*!
+     * Number of delayed commands whose latency could not be measured because
+     * too many delayed commands were outstanding on their service
+     */
+    uint32_t dropped_count;
+};
+
+/*!
+ * \brief SCMI latency statistics API.
+ */
+struct mod_scmi_latency_stats_api {
+    /*!
+     * \brief Get the latency statistics of a message.
+     *
+     * \param scmi_protocol_id SCMI protocol identifier.
+     * \param scmi_message_id SCMI message identifier.
+     * \param[out] stats Latency statistics of the message.
+     *
+     * \retval ::FWK_SUCCESS The operation succeeded.
+     * \retval ::FWK_E_PARAM An invalid parameter was encountered:
+     *      - The `stats` parameter was a null pointer value.
+     * \retval ::FWK_E_RANGE The protocol is not implemented by the platform or
+     *      the message identifier is not accounted for.
+     */
+    int (*get_stats)(
+        uint8_t scmi_protocol_id,
+        uint8_t scmi_message_id,
+        struct mod_scmi_latency_stats *stats);
+
+    /*!
+     * \brief Reset the latency statistics of all the messages.
+     *
+     * \retval ::FWK_SUCCESS The operation succeeded.
+     */
+    int (*reset_stats)(void);
+};
+#endif
+
 /*!
  * \brief SCMI notification indices.
  */
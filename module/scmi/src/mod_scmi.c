@@ -21,8 +21,12 @@
 #include <fwk_core.h>
 #include <fwk_event.h>
 #include <fwk_id.h>
+#include <fwk_list.h>
 #include <fwk_log.h>
 #include <fwk_macros.h>
+#ifdef BUILD_HAS_MOD_SCMI_LATENCY_STATS
+#    include <fwk_math.h>
+#endif
 #include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
@@ -84,6 +88,17 @@ struct scmi_notification_subscribers {
 #define PROTOCOL_TABLE_BASE_PROTOCOL_IDX 1
 #define PROTOCOL_TABLE_RESERVED_ENTRIES_COUNT 2
 
+/*
+ * Range of the tokens assigned to the requests tracked by the SCMI module. It
+ * lies above the 8-bit tokens of scmi_send_message() so that the response to
+ * an untracked message is never mistaken for the response to a tracked one.
+ */
+#define SCMI_REQUEST_TOKEN_MIN 0x100U
+#define SCMI_REQUEST_TOKEN_MAX \
+    (SCMI_MESSAGE_HEADER_TOKEN_MASK >> SCMI_MESSAGE_HEADER_TOKEN_POS)
+#define SCMI_REQUEST_TOKEN_COUNT \
+    (SCMI_REQUEST_TOKEN_MAX - SCMI_REQUEST_TOKEN_MIN + 1U)
+
 static struct mod_scmi_ctx scmi_ctx;
 
 /*
@@ -96,7 +111,7 @@ static struct mod_scmi_ctx scmi_ctx;
  * and a 10-bit token.
  */
 static uint32_t scmi_message_header(uint8_t message_id,
-    uint8_t message_type, uint8_t protocol_id, uint8_t token)
+    uint8_t message_type, uint8_t protocol_id, uint16_t token)
 {
     return (
         (((message_id) << SCMI_MESSAGE_HEADER_MESSAGE_ID_POS) &
@@ -240,6 +255,11 @@ static int signal_message(fwk_id_t service_id)
         .target_id = service_id,
     };
 
+#ifdef BUILD_HAS_MOD_SCMI_LATENCY_STATS
+    scmi_ctx.service_ctx_table[fwk_id_get_element_idx(service_id)]
+        .signal_timestamp = fwk_time_current();
+#endif
+
     return fwk_put_event(&event);
 }
 
@@ -318,10 +338,163 @@ static int write_payload(fwk_id_t service_id, size_t offset,
                                              offset, payload, size);
 }
 
+#ifdef BUILD_HAS_MOD_SCMI_LATENCY_STATS
+static struct mod_scmi_latency_stats *get_latency_stats(
+    unsigned int protocol_idx,
+    unsigned int message_id)
+{
+    if ((scmi_ctx.latency_stats == NULL) || (protocol_idx == 0) ||
+        (protocol_idx >= scmi_ctx.latency_stats_protocol_count) ||
+        (message_id >= MOD_SCMI_LATENCY_STATS_MESSAGE_ID_COUNT)) {
+        return NULL;
+    }
+
+    return &scmi_ctx.latency_stats
+                [(protocol_idx * MOD_SCMI_LATENCY_STATS_MESSAGE_ID_COUNT) +
+                 message_id];
+}
+
+static unsigned int latency_stats_bucket(uint32_t latency_ns)
+{
+    unsigned int latency_us = latency_ns / 1000u;
+    unsigned int bucket;
+
+    if (latency_us == 0) {
+        return 0;
+    }
+
+    bucket = fwk_math_log2(latency_us) + 1u;
+
+    return FWK_MIN(bucket, MOD_SCMI_LATENCY_STATS_BUCKET_COUNT - 1u);
+}
+
+static void latency_stats_add(
+    struct mod_scmi_latency_stats *stats,
+    uint32_t latency_ns)
+{
+    if ((stats->count == 0) || (latency_ns < stats->min_ns)) {
+        stats->min_ns = latency_ns;
+    }
+    if (latency_ns > stats->max_ns) {
+        stats->max_ns = latency_ns;
+    }
+    stats->total_ns += latency_ns;
+    stats->count++;
+    stats->histogram[latency_stats_bucket(latency_ns)]++;
+}
+
+static void latency_stats_account(
+    uint8_t protocol_id,
+    uint8_t message_id,
+    fwk_timestamp_t signal_timestamp)
+{
+    struct mod_scmi_latency_stats *stats;
+    fwk_timestamp_t now;
+    uint64_t elapsed_ns;
+
+    stats = get_latency_stats(
+        scmi_ctx.scmi_protocol_id_to_idx[protocol_id], message_id);
+    if (stats == NULL) {
+        return;
+    }
+
+    /* The timestamps are all zero when no time driver is available */
+    now = fwk_time_current();
+    elapsed_ns = (now > signal_timestamp) ?
+        fwk_time_stamp_duration(now - signal_timestamp) :
+        0;
+
+    latency_stats_add(
+        stats, (uint32_t)FWK_MIN(elapsed_ns, (uint64_t)UINT32_MAX));
+}
+
+static void latency_stats_drop(uint8_t protocol_id, uint8_t message_id)
+{
+    struct mod_scmi_latency_stats *stats;
+
+    stats = get_latency_stats(
+        scmi_ctx.scmi_protocol_id_to_idx[protocol_id], message_id);
+    if (stats != NULL) {
+        stats->dropped_count++;
+    }
+}
+
+static void latency_stats_record(struct scmi_service_ctx *ctx)
+{
+    struct scmi_delayed_command *command, *entry;
+    unsigned int i;
+
+    if ((ctx->config->scmi_entity_role != MOD_SCMI_ROLE_PLATFORM) ||
+        (ctx->scmi_message_type != MOD_SCMI_MESSAGE_TYPE_COMMAND)) {
+        return;
+    }
+
+    if (!ctx->delayed_response) {
+        latency_stats_account(
+            ctx->scmi_protocol_id,
+            ctx->scmi_message_id,
+            ctx->signal_timestamp);
+        return;
+    }
+
+    /*
+     * The command is accounted for when its delayed response is sent. Keep
+     * its signal timestamp until then in a free entry. When all the entries
+     * are in use, the oldest one is reused and its command is counted as
+     * dropped.
+     */
+    command = &ctx->delayed_commands[0];
+    for (i = 0; i < SCMI_DELAYED_COMMAND_COUNT; i++) {
+        entry = &ctx->delayed_commands[i];
+        if (!entry->valid) {
+            command = entry;
+            break;
+        }
+        if (entry->signal_timestamp < command->signal_timestamp) {
+            command = entry;
+        }
+    }
+
+    if (command->valid) {
+        latency_stats_drop(command->protocol_id, command->message_id);
+    }
+
+    *command = (struct scmi_delayed_command){
+        .valid = true,
+        .protocol_id = ctx->scmi_protocol_id,
+        .message_id = ctx->scmi_message_id,
+        .token = ctx->scmi_token,
+        .signal_timestamp = ctx->signal_timestamp,
+    };
+}
+
+static void latency_stats_record_delayed(
+    struct scmi_service_ctx *ctx,
+    uint8_t protocol_id,
+    uint8_t message_id,
+    uint16_t token)
+{
+    struct scmi_delayed_command *command;
+    unsigned int i;
+
+    for (i = 0; i < SCMI_DELAYED_COMMAND_COUNT; i++) {
+        command = &ctx->delayed_commands[i];
+        if (command->valid && (command->token == token) &&
+            (command->protocol_id == protocol_id) &&
+            (command->message_id == message_id)) {
+            command->valid = false;
+            latency_stats_account(
+                protocol_id, message_id, command->signal_timestamp);
+            return;
+        }
+    }
+}
+#endif
+
 static int respond(fwk_id_t service_id, const void *payload, size_t size)
 {
     int status;
-    const struct scmi_service_ctx *ctx;
+    struct scmi_service_ctx *ctx;
     const char *service_name;
     const char *message_type_name;
 
@@ -377,6 +550,11 @@ static int respond(fwk_id_t service_id, const void *payload, size_t size)
             fwk_status_str(status));
 #endif
     }
+#ifdef BUILD_HAS_MOD_SCMI_LATENCY_STATS
+    if (status == FWK_SUCCESS) {
+        latency_stats_record(ctx);
+    }
+#endif
     return status;
 }
 
@@ -430,6 +608,68 @@ static void scmi_notify(fwk_id_t id, int protocol_id, int message_id,
     }
 }
 
+static int get_delayed_response_token(fwk_id_t service_id, uint16_t *token)
+{
+    struct scmi_service_ctx *ctx;
+
+    if (token == NULL) {
+        return FWK_E_PARAM;
+    }
+
+    ctx = &scmi_ctx.service_ctx_table[fwk_id_get_element_idx(service_id)];
+    *token = ctx->scmi_token;
+#ifdef BUILD_HAS_MOD_SCMI_LATENCY_STATS
+    ctx->delayed_response = true;
+#endif
+
+    return FWK_SUCCESS;
+}
+
+static int send_delayed_response(
+    fwk_id_t service_id,
+    uint8_t protocol_id,
+    uint8_t message_id,
+    uint16_t token,
+    const void *payload,
+    size_t size)
+{
+    int status;
+    uint32_t message_header;
+    struct scmi_service_ctx *ctx;
+    const struct scmi_service_ctx *p2a_ctx;
+
+    ctx = &scmi_ctx.service_ctx_table[fwk_id_get_element_idx(service_id)];
+
+    /* Delayed responses are sent on the P2A channel of the A2P service */
+    if (fwk_id_is_equal(ctx->config->scmi_p2a_id, FWK_ID_NONE)) {
+        return FWK_E_SUPPORT;
+    }
+    p2a_ctx = &scmi_ctx.service_ctx_table[fwk_id_get_element_idx(
+        ctx->config->scmi_p2a_id)];
+    if (p2a_ctx->transmit == NULL) {
+        return FWK_E_SUPPORT;
+    }
+
+    message_header = scmi_message_header(
+        message_id,
+        (uint8_t)MOD_SCMI_MESSAGE_TYPE_DELAYED_RESPONSE,
+        protocol_id,
+        token);
+
+    status = p2a_ctx->transmit(
+        p2a_ctx->transport_id, message_header, payload, size, false);
+    if (status != FWK_SUCCESS) {
+        FWK_LOG_DEBUG("[SCMI] %s @%d", __func__, __LINE__);
+        return status;
+    }
+
+#ifdef BUILD_HAS_MOD_SCMI_LATENCY_STATS
+    latency_stats_record_delayed(ctx, protocol_id, message_id, token);
+#endif
+
+    return FWK_SUCCESS;
+}
+
 int scmi_send_message(
     uint8_t message_id,
     uint8_t protocol_id,
@@ -508,6 +748,230 @@ int response_message_handler(fwk_id_t service_id)
     return status;
 }
 
+static struct scmi_outstanding_request *find_request(
+    const struct scmi_service_ctx *ctx,
+    uint16_t token)
+{
+    unsigned int idx;
+    struct scmi_outstanding_request *request;
+
+    for (idx = 0; idx < ctx->config->outstanding_request_count; idx++) {
+        request = &ctx->outstanding_requests[idx];
+        if ((request->state != SCMI_REQUEST_STATE_FREE) &&
+            (read_token(request->message_header) == token)) {
+            return request;
+        }
+    }
+
+    return NULL;
+}
+
+static uint16_t next_request_token(uint16_t token)
+{
+    return (token == SCMI_REQUEST_TOKEN_MAX) ? (uint16_t)SCMI_REQUEST_TOKEN_MIN :
+                                               (uint16_t)(token + 1U);
+}
+
+static uint16_t allocate_request_token(struct scmi_service_ctx *ctx)
+{
+    uint16_t token = ctx->next_request_token;
+
+    /*
+     * There are fewer outstanding request entries than tokens in the range,
+     * so a free token is always found.
+     */
+    while (find_request(ctx, token) != NULL) {
+        token = next_request_token(token);
+    }
+
+    ctx->next_request_token = next_request_token(token);
+
+    return token;
+}
+
+static int transmit_request(
+    struct scmi_service_ctx *ctx,
+    struct scmi_outstanding_request *request)
+{
+    int status;
+
+    status = ctx->transmit(
+        ctx->transport_id,
+        request->message_header,
+        request->payload,
+        request->payload_size,
+        request->request_ack_by_interrupt);
+    if (status == FWK_SUCCESS) {
+        request->state = SCMI_REQUEST_STATE_IN_FLIGHT;
+    }
+
+    return status;
+}
+
+static void complete_request(
+    fwk_id_t service_id,
+    struct scmi_outstanding_request *request,
+    int status,
+    const uint32_t *payload,
+    size_t payload_size)
+{
+    mod_scmi_response_callback_t *callback = request->callback;
+    uintptr_t cookie = request->cookie;
+    uint16_t token = read_token(request->message_header);
+
+    /* Free the entry first so that the callback can send a new request */
+    request->state = SCMI_REQUEST_STATE_FREE;
+
+    callback(service_id, token, status, payload, payload_size, cookie);
+}
+
+/*
+ * Transmit the queued requests of a service, in order, until the transport
+ * channel is busy again.
+ */
+static void send_queued_requests(
+    fwk_id_t service_id,
+    struct scmi_service_ctx *ctx)
+{
+    int status;
+    struct scmi_outstanding_request *request;
+
+    while (!fwk_list_is_empty(&ctx->request_queue)) {
+        request = FWK_LIST_GET(
+            fwk_list_head(&ctx->request_queue),
+            struct scmi_outstanding_request,
+            node);
+
+        status = transmit_request(ctx, request);
+        if (status == FWK_E_BUSY) {
+            return;
+        }
+
+        (void)fwk_list_pop_head(&ctx->request_queue);
+
+        if (status != FWK_SUCCESS) {
+            FWK_LOG_ERR(
+                "[SCMI] %s: Cmd [%" PRIu16 "] failed to be sent (%s)",
+                fwk_module_get_element_name(service_id),
+                read_token(request->message_header),
+                fwk_status_str(status));
+            complete_request(service_id, request, status, NULL, 0);
+        }
+    }
+}
+
+static int scmi_send_request(
+    const struct mod_scmi_request *request,
+    uint16_t *token)
+{
+    int status;
+    unsigned int idx;
+    struct scmi_service_ctx *ctx;
+    struct scmi_outstanding_request *entry = NULL;
+    uint16_t request_token;
+
+    if ((request == NULL) || (request->callback == NULL) ||
+        ((request->payload == NULL) && (request->payload_size != 0))) {
+        return FWK_E_PARAM;
+    }
+
+    if (!fwk_module_is_valid_element_id(request->service_id)) {
+        return FWK_E_PARAM;
+    }
+
+    ctx = &scmi_ctx.service_ctx_table[fwk_id_get_element_idx(
+        request->service_id)];
+
+    if (ctx->outstanding_requests == NULL) {
+        return FWK_E_SUPPORT;
+    }
+
+    if (request->payload_size > ctx->request_payload_size_max) {
+        return FWK_E_PARAM;
+    }
+
+    for (idx = 0; idx < ctx->config->outstanding_request_count; idx++) {
+        if (ctx->outstanding_requests[idx].state == SCMI_REQUEST_STATE_FREE) {
+            entry = &ctx->outstanding_requests[idx];
+            break;
+        }
+    }
+
+    if (entry == NULL) {
+        return FWK_E_BUSY;
+    }
+
+    request_token = allocate_request_token(ctx);
+
+    /* All commands, synchronous or asynchronous, have a message type of 0 */
+    entry->message_header = scmi_message_header(
+                                request->message_id,
+                                (uint8_t)MOD_SCMI_MESSAGE_TYPE_COMMAND,
+                                request->protocol_id,
+                                0) |
+        (((uint32_t)request_token << SCMI_MESSAGE_HEADER_TOKEN_POS) &
+         SCMI_MESSAGE_HEADER_TOKEN_MASK);
+    entry->payload_size = request->payload_size;
+    entry->request_ack_by_interrupt = request->request_ack_by_interrupt;
+    entry->callback = request->callback;
+    entry->cookie = request->cookie;
+    if (request->payload_size != 0) {
+        fwk_str_memcpy(entry->payload, request->payload, request->payload_size);
+    }
+    entry->state = SCMI_REQUEST_STATE_QUEUED;
+
+    if (token != NULL) {
+        *token = request_token;
+    }
+
+    /* Requests are transmitted in order, do not overtake queued requests */
+    if (fwk_list_is_empty(&ctx->request_queue)) {
+        status = transmit_request(ctx, entry);
+        if (status == FWK_SUCCESS) {
+            return FWK_SUCCESS;
+        }
+
+        if (status != FWK_E_BUSY) {
+            entry->state = SCMI_REQUEST_STATE_FREE;
+            return status;
+        }
+    }
+
+    fwk_list_push_tail(&ctx->request_queue, &entry->node);
+
+    return FWK_PENDING;
+}
+
+/*
+ * Give the response to a tracked request to its callback. Returns false when
+ * the response does not belong to a tracked request.
+ */
+static bool handle_request_response(
+    fwk_id_t service_id,
+    struct scmi_service_ctx *ctx,
+    const uint32_t *payload,
+    size_t payload_size)
+{
+    struct scmi_outstanding_request *request;
+
+    if ((ctx->outstanding_requests == NULL) ||
+        (ctx->scmi_message_type != MOD_SCMI_MESSAGE_TYPE_COMMAND)) {
+        return false;
+    }
+
+    request = find_request(ctx, ctx->scmi_token);
+    if ((request == NULL) ||
+        (request->state != SCMI_REQUEST_STATE_IN_FLIGHT) ||
+        (read_protocol_id(request->message_header) != ctx->scmi_protocol_id) ||
+        (read_message_id(request->message_header) != ctx->scmi_message_id)) {
+        return false;
+    }
+
+    complete_request(service_id, request, FWK_SUCCESS, payload, payload_size);
+
+    return true;
+}
+
 static const struct mod_scmi_from_protocol_api scmi_from_protocol_api = {
     .get_agent_count = get_agent_count,
     .get_agent_id = get_agent_id,
@@ -516,14 +980,64 @@ static const struct mod_scmi_from_protocol_api scmi_from_protocol_api = {
     .write_payload = write_payload,
     .respond = respond,
     .notify = scmi_notify,
+    .get_delayed_response_token = get_delayed_response_token,
+    .send_delayed_response = send_delayed_response,
 };
 
 static const struct mod_scmi_from_protocol_req_api
     scmi_from_protocol_req_api = {
         .scmi_send_message = scmi_send_message,
         .response_message_handler = response_message_handler,
+        .scmi_send_request = scmi_send_request,
     };
 
+#ifdef BUILD_HAS_MOD_SCMI_LATENCY_STATS
+/*
+ * SCMI latency statistics protocol module -> SCMI module interface
+ */
+
+static int latency_stats_get(
+    uint8_t scmi_protocol_id,
+    uint8_t scmi_message_id,
+    struct mod_scmi_latency_stats *stats)
+{
+    const struct mod_scmi_latency_stats *entry;
+
+    if (stats == NULL) {
+        return FWK_E_PARAM;
+    }
+
+    entry = get_latency_stats(
+        scmi_ctx.scmi_protocol_id_to_idx[scmi_protocol_id], scmi_message_id);
+    if (entry == NULL) {
+        return FWK_E_RANGE;
+    }
+
+    *stats = *entry;
+
+    return FWK_SUCCESS;
+}
+
+static int latency_stats_reset(void)
+{
+    if (scmi_ctx.latency_stats != NULL) {
+        fwk_str_memset(
+            scmi_ctx.latency_stats,
+            0,
+            scmi_ctx.latency_stats_protocol_count *
+                MOD_SCMI_LATENCY_STATS_MESSAGE_ID_COUNT *
+                sizeof(scmi_ctx.latency_stats[0]));
+    }
+
+    return FWK_SUCCESS;
+}
+
+static const struct mod_scmi_latency_stats_api scmi_latency_stats_api = {
+    .get_stats = latency_stats_get,
+    .reset_stats = latency_stats_reset,
+};
+#endif
+
 #ifdef BUILD_HAS_SCMI_NOTIFICATIONS
 static struct scmi_notification_subscribers *notification_subscribers(
     unsigned int protocol_id)
@@ -802,8 +1316,39 @@ static int scmi_service_init(fwk_id_t service_id, unsigned int unused,
         return FWK_E_PARAM;
     }
 
+    if ((config->outstanding_request_count != 0) &&
+        ((config->scmi_entity_role != MOD_SCMI_ROLE_AGENT) ||
+         (config->outstanding_request_count > SCMI_REQUEST_TOKEN_COUNT))) {
+        return FWK_E_PARAM;
+    }
+
     ctx = &scmi_ctx.service_ctx_table[fwk_id_get_element_idx(service_id)];
     ctx->config = config;
+    fwk_list_init(&ctx->request_queue);
+    ctx->next_request_token = (uint16_t)SCMI_REQUEST_TOKEN_MIN;
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_outstanding_requests_init(struct scmi_service_ctx *ctx)
+{
+    int status;
+    unsigned int idx;
+    unsigned int count = ctx->config->outstanding_request_count;
+
+    status = ctx->transport_api->get_max_payload_size(
+        ctx->transport_id, &ctx->request_payload_size_max);
+    if (status != FWK_SUCCESS) {
+        return status;
+    }
+
+    ctx->outstanding_requests =
+        fwk_mm_calloc(count, sizeof(ctx->outstanding_requests[0]));
+
+    for (idx = 0; idx < count; idx++) {
+        ctx->outstanding_requests[idx].payload =
+            fwk_mm_calloc(1, ctx->request_payload_size_max);
+    }
 
     return FWK_SUCCESS;
 }
@@ -843,6 +1388,10 @@ static int scmi_bind(fwk_id_t id, unsigned int round)
         ctx->respond = transport_api->respond;
         ctx->transmit = transport_api->transmit;
 
+        if (ctx->config->outstanding_request_count != 0) {
+            return scmi_outstanding_requests_init(ctx);
+        }
+
         return FWK_SUCCESS;
     }
 
@@ -983,6 +1532,16 @@ static int scmi_process_bind_request(fwk_id_t source_id, fwk_id_t target_id,
         break;
 #endif
 
+#ifdef BUILD_HAS_MOD_SCMI_LATENCY_STATS
+    case MOD_SCMI_API_IDX_LATENCY_STATS:
+        if (!fwk_id_is_type(target_id, FWK_ID_TYPE_MODULE)) {
+            return FWK_E_SUPPORT;
+        }
+
+        *api = &scmi_latency_stats_api;
+        break;
+#endif
+
     default:
         return FWK_E_SUPPORT;
     };
@@ -1041,6 +1600,9 @@ static int scmi_process_event(const struct fwk_event *event,
     ctx->scmi_message_type =
         (enum mod_scmi_message_type)read_message_type(message_header);
     ctx->scmi_token = read_token(message_header);
+#ifdef BUILD_HAS_MOD_SCMI_LATENCY_STATS
+    ctx->delayed_response = false;
+#endif
     message_type_name = get_message_type_str(ctx);
 
 #if FWK_LOG_LEVEL <= FWK_LOG_LEVEL_DEBUG
@@ -1140,6 +1702,19 @@ static int scmi_process_event(const struct fwk_event *event,
 #endif
     protocol = &scmi_ctx.protocol_table[protocol_idx];
     } else if (ctx->config->scmi_entity_role == MOD_SCMI_ROLE_AGENT) {
+        if (handle_request_response(
+                event->target_id, ctx, payload, payload_size)) {
+            status = transport_api->release_transport_channel_lock(
+                transport_id);
+            if (status != FWK_SUCCESS) {
+                FWK_LOG_DEBUG("[SCMI] %s @%d", __func__, __LINE__);
+            }
+
+            send_queued_requests(event->target_id, ctx);
+
+            return FWK_SUCCESS;
+        }
+
         protocol_idx =
             scmi_ctx.scmi_protocol_requester_id_to_idx[ctx->scmi_protocol_id];
         protocol = &scmi_ctx.protocol_requester_table[protocol_idx];
@@ -1185,6 +1760,8 @@ static int scmi_process_event(const struct fwk_event *event,
 #endif
             return FWK_SUCCESS;
         }
+
+        send_queued_requests(event->target_id, ctx);
     }
 
     return FWK_SUCCESS;
@@ -1192,6 +1769,25 @@ static int scmi_process_event(const struct fwk_event *event,
 
 static int scmi_start(fwk_id_t id)
 {
+#ifdef BUILD_HAS_BASE_PROTOCOL
+    if (fwk_id_is_type(id, FWK_ID_TYPE_MODULE)) {
+        /* All the protocols are bound, build the discovery responses */
+        scmi_base_discovery_init();
+    }
+#endif
+
+#ifdef BUILD_HAS_MOD_SCMI_LATENCY_STATS
+    if (fwk_id_is_type(id, FWK_ID_TYPE_MODULE)) {
+        /* All the protocols, including the reserved entries, are bound */
+        scmi_ctx.latency_stats_protocol_count =
+            scmi_ctx.protocol_count + PROTOCOL_TABLE_RESERVED_ENTRIES_COUNT;
+        scmi_ctx.latency_stats = fwk_mm_calloc(
+            scmi_ctx.latency_stats_protocol_count *
+                MOD_SCMI_LATENCY_STATS_MESSAGE_ID_COUNT,
+            sizeof(scmi_ctx.latency_stats[0]));
+    }
+#endif
+
 #ifdef BUILD_HAS_NOTIFICATION
     const struct mod_scmi_service_config *config;
     unsigned int notifications_sent;
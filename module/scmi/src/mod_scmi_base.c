@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2022-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2022-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -18,6 +18,7 @@
 #include <fwk_log.h>
 #include <fwk_macros.h>
 #include <fwk_module.h>
+#include <fwk_mm.h>
 #include <fwk_module_idx.h>
 #include <fwk_string.h>
 
@@ -25,9 +26,31 @@
 #    include <mod_resource_perms.h>
 #endif
 
+/* Protocols an agent has access to */
+struct scmi_base_agent_protocols {
+    /* The list has to be rebuilt before being used */
+    bool stale;
+
+    /* Number of protocols in the list */
+    unsigned int count;
+
+    /* Identifiers of the protocols, Base protocol excluded, in order */
+    uint8_t *protocol_ids;
+};
+
 static struct mod_scmi_ctx *shared_scmi_ctx;
 static const struct mod_scmi_from_protocol_api *protocol_api;
 
+/*
+ * Discovery responses, built once after the protocols have been bound and
+ * served as they are. The protocol lists are indexed by agent identifier and
+ * rebuilt only after the permissions of the agent have changed.
+ */
+static struct scmi_base_discover_vendor_p2a discover_vendor_response;
+static struct scmi_base_discover_sub_vendor_p2a discover_sub_vendor_response;
+static struct scmi_base_discover_agent_p2a *discover_agent_responses;
+static struct scmi_base_agent_protocols *agent_protocols_table;
+
 static const char *const default_agent_names[SCMI_AGENT_TYPE_COUNT] = {
     [SCMI_AGENT_TYPE_PSCI] = "PSCI",
     [SCMI_AGENT_TYPE_MANAGEMENT] = "MANAGEMENT",
@@ -116,53 +139,56 @@ static int (*const base_handler_table[MOD_SCMI_BASE_COMMAND_COUNT])(
 #endif
 };
 /*
- * Base protocol implementation
+ * Discovery responses
  */
-/*
- * Base Protocol - PROTOCOL_VERSION
- */
-static int scmi_base_protocol_version_handler(
-    fwk_id_t service_id,
-    const uint32_t *payload)
+#ifndef BUILD_HAS_MOD_RESOURCE_PERMS
+static bool scmi_base_is_protocol_disabled_for_psci(uint8_t protocol_id)
 {
-    struct scmi_protocol_version_p2a return_values = {
-        .status = (int32_t)SCMI_SUCCESS,
-        .version = SCMI_PROTOCOL_VERSION_BASE,
-    };
+    unsigned int index;
 
-    return protocol_api->respond(
-        service_id, &return_values, sizeof(return_values));
+    /*
+     * assert if a valid list of disabled protocols is supplied in case the
+     * number of the disabled protocols is not zero. In case the number of the
+     * disabled protocols is zero , then no list needs to be supplied
+     */
+    fwk_assert(
+        (shared_scmi_ctx->config->dis_protocol_list_psci != NULL) ||
+        (shared_scmi_ctx->config->dis_protocol_count_psci == 0));
+
+    for (index = 0; index < shared_scmi_ctx->config->dis_protocol_count_psci;
+         index++) {
+        if (protocol_id ==
+            shared_scmi_ctx->config->dis_protocol_list_psci[index]) {
+            return true;
+        }
+    }
+
+    return false;
 }
+#endif
 
-/*
- * Base Protocol - PROTOCOL_ATTRIBUTES
- */
-static int scmi_base_protocol_attributes_handler(
-    fwk_id_t service_id,
-    const uint32_t *payload)
+static int scmi_base_build_agent_protocols(
+    unsigned int agent_id,
+    struct scmi_base_agent_protocols *agent_protocols)
 {
-    size_t protocol_count;
-    int status;
-    unsigned int agent_id;
-
+    unsigned int index;
+    unsigned int count;
+    uint8_t protocol_id;
 #ifdef BUILD_HAS_MOD_RESOURCE_PERMS
-    size_t global_protocol_count;
     enum mod_res_perms_permissions perms;
-    uint8_t protocol_id;
-    unsigned int index;
 #else
+    int status;
     enum scmi_agent_type agent_type;
-#endif
 
-    status = protocol_api->get_agent_id(service_id, &agent_id);
+    status = protocol_api->get_agent_type(agent_id, &agent_type);
     if (status != FWK_SUCCESS) {
         return status;
     }
+#endif
 
-#ifdef BUILD_HAS_MOD_RESOURCE_PERMS
-    for (index = 0, protocol_count = 0, global_protocol_count = 0;
+    for (index = 0, count = 0;
          (index < FWK_ARRAY_SIZE(shared_scmi_ctx->scmi_protocol_id_to_idx)) &&
-         (global_protocol_count < shared_scmi_ctx->protocol_count);
+         (count < shared_scmi_ctx->protocol_count);
          index++) {
         if ((shared_scmi_ctx->scmi_protocol_id_to_idx[index] == 0) ||
             (index == MOD_SCMI_PROTOCOL_ID_BASE)) {
@@ -171,45 +197,113 @@ static int scmi_base_protocol_attributes_handler(
 
         protocol_id = (uint8_t)index;
 
+#ifdef BUILD_HAS_MOD_RESOURCE_PERMS
         /*
          * Check that the agent has the permission to access the protocol
          */
         perms = shared_scmi_ctx->res_perms_api->agent_has_protocol_permission(
             agent_id, protocol_id);
 
-        if (perms == MOD_RES_PERMS_ACCESS_ALLOWED) {
-            protocol_count++;
+        if (perms == MOD_RES_PERMS_ACCESS_DENIED) {
+            continue;
         }
+#else
+        /*
+         * PSCI agents are only allowed access certain protocols defined
+         * for the platform.
+         */
+        if ((agent_type == SCMI_AGENT_TYPE_PSCI) &&
+            scmi_base_is_protocol_disabled_for_psci(protocol_id)) {
+            continue;
+        }
+#endif
 
-        global_protocol_count++;
+        agent_protocols->protocol_ids[count++] = protocol_id;
     }
-#else
-    status = protocol_api->get_agent_type(agent_id, &agent_type);
+
+    agent_protocols->count = count;
+    agent_protocols->stale = false;
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_base_get_agent_protocols(
+    unsigned int agent_id,
+    const struct scmi_base_agent_protocols **agent_protocols)
+{
+    int status;
+    struct scmi_base_agent_protocols *entry;
+
+    if (agent_id > shared_scmi_ctx->config->agent_count) {
+        return FWK_E_PARAM;
+    }
+
+    entry = &agent_protocols_table[agent_id];
+    if (entry->stale) {
+        status = scmi_base_build_agent_protocols(agent_id, entry);
+        if (status != FWK_SUCCESS) {
+            return status;
+        }
+    }
+
+    *agent_protocols = entry;
+
+    return FWK_SUCCESS;
+}
+
+#ifdef BUILD_HAS_MOD_RESOURCE_PERMS
+static void scmi_base_invalidate_agent_protocols(unsigned int agent_id)
+{
+    agent_protocols_table[agent_id].stale = true;
+}
+#endif
+
+/*
+ * Base protocol implementation
+ */
+/*
+ * Base Protocol - PROTOCOL_VERSION
+ */
+static int scmi_base_protocol_version_handler(
+    fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    struct scmi_protocol_version_p2a return_values = {
+        .status = (int32_t)SCMI_SUCCESS,
+        .version = SCMI_PROTOCOL_VERSION_BASE,
+    };
+
+    return protocol_api->respond(
+        service_id, &return_values, sizeof(return_values));
+}
+
+/*
+ * Base Protocol - PROTOCOL_ATTRIBUTES
+ */
+static int scmi_base_protocol_attributes_handler(
+    fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    int status;
+    unsigned int agent_id;
+    const struct scmi_base_agent_protocols *agent_protocols;
+
+    status = protocol_api->get_agent_id(service_id, &agent_id);
     if (status != FWK_SUCCESS) {
         return status;
     }
 
-    /*
-     * PSCI agents are only allowed access to certain protocols defined
-     * for the platform.
-     */
-    if (agent_type == SCMI_AGENT_TYPE_PSCI) {
-        fwk_assert(
-            shared_scmi_ctx->protocol_count >
-            shared_scmi_ctx->config->dis_protocol_count_psci);
-        protocol_count = shared_scmi_ctx->protocol_count -
-            shared_scmi_ctx->config->dis_protocol_count_psci;
-    } else {
-        protocol_count = shared_scmi_ctx->protocol_count;
+    status = scmi_base_get_agent_protocols(agent_id, &agent_protocols);
+    if (status != FWK_SUCCESS) {
+        return status;
     }
-#endif
 
     struct scmi_protocol_attributes_p2a return_values = {
         .status = (int32_t)SCMI_SUCCESS,
     };
 
     return_values.attributes = (uint32_t)SCMI_BASE_PROTOCOL_ATTRIBUTES(
-        protocol_count, shared_scmi_ctx->config->agent_count);
+        agent_protocols->count, shared_scmi_ctx->config->agent_count);
 
     return protocol_api->respond(
         service_id, &return_values, sizeof(return_values));
@@ -254,19 +348,10 @@ static int scmi_base_discover_vendor_handler(
     fwk_id_t service_id,
     const uint32_t *payload)
 {
-    struct scmi_base_discover_vendor_p2a return_values = {
-        .status = (int32_t)SCMI_SUCCESS,
-    };
-
-    if (shared_scmi_ctx->config->vendor_identifier != NULL) {
-        fwk_str_strncpy(
-            return_values.vendor_identifier,
-            shared_scmi_ctx->config->vendor_identifier,
-            sizeof(return_values.vendor_identifier) - 1);
-    }
-
     return protocol_api->respond(
-        service_id, &return_values, sizeof(return_values));
+        service_id,
+        &discover_vendor_response,
+        sizeof(discover_vendor_response));
 }
 
 /*
@@ -276,19 +361,10 @@ static int scmi_base_discover_sub_vendor_handler(
     fwk_id_t service_id,
     const uint32_t *payload)
 {
-    struct scmi_base_discover_sub_vendor_p2a return_values = {
-        .status = (int32_t)SCMI_SUCCESS,
-    };
-
-    if (shared_scmi_ctx->config->sub_vendor_identifier != NULL) {
-        fwk_str_strncpy(
-            return_values.sub_vendor_identifier,
-            shared_scmi_ctx->config->sub_vendor_identifier,
-            sizeof(return_values.sub_vendor_identifier) - 1);
-    }
-
     return protocol_api->respond(
-        service_id, &return_values, sizeof(return_values));
+        service_id,
+        &discover_sub_vendor_response,
+        sizeof(discover_sub_vendor_response));
 }
 
 /*
@@ -319,21 +395,12 @@ static int scmi_base_discover_list_protocols_handler(
         .status = (int32_t)SCMI_GENERIC_ERROR,
         .num_protocols = 0,
     };
+    const struct scmi_base_agent_protocols *agent_protocols;
     unsigned int skip;
     size_t max_payload_size;
     size_t payload_size;
     size_t entry_count;
-    size_t protocol_count, protocol_count_max;
-    size_t avail_protocol_count = 0;
-    unsigned int index;
-    uint8_t protocol_id;
-#ifdef BUILD_HAS_MOD_RESOURCE_PERMS
-    enum mod_res_perms_permissions perms;
-#else
-    unsigned int dis_protocol_list_psci_index;
-    unsigned int protocol_count_psci;
-    enum scmi_agent_type agent_type;
-#endif
+    size_t avail_protocol_count;
     unsigned int agent_id;
 
     status = protocol_api->get_agent_id(service_id, &agent_id);
@@ -341,12 +408,10 @@ static int scmi_base_discover_list_protocols_handler(
         goto error;
     }
 
-#ifndef BUILD_HAS_MOD_RESOURCE_PERMS
-    status = protocol_api->get_agent_type(agent_id, &agent_type);
+    status = scmi_base_get_agent_protocols(agent_id, &agent_protocols);
     if (status != FWK_SUCCESS) {
         goto error;
     }
-#endif
 
     status = protocol_api->get_max_payload_size(service_id, &max_payload_size);
     if (status != FWK_SUCCESS) {
@@ -366,113 +431,25 @@ static int scmi_base_discover_list_protocols_handler(
     parameters = (const struct scmi_base_discover_list_protocols_a2p *)payload;
     skip = parameters->skip;
 
-#ifdef BUILD_HAS_MOD_RESOURCE_PERMS
-    protocol_count_max =
-        (shared_scmi_ctx->protocol_count < (skip + entry_count)) ?
-        shared_scmi_ctx->protocol_count :
-        (skip + entry_count);
-#else
-
-    if (agent_type == SCMI_AGENT_TYPE_PSCI) {
-        fwk_assert(
-            shared_scmi_ctx->protocol_count >
-            shared_scmi_ctx->config->dis_protocol_count_psci);
-
-        protocol_count_psci = shared_scmi_ctx->protocol_count -
-            shared_scmi_ctx->config->dis_protocol_count_psci;
-
-        protocol_count_max = (protocol_count_psci < (skip + entry_count)) ?
-            protocol_count_psci :
-            (skip + entry_count);
-    } else {
-        protocol_count_max =
-            (shared_scmi_ctx->protocol_count < (skip + entry_count)) ?
-            shared_scmi_ctx->protocol_count :
-            (skip + entry_count);
+    if (skip > agent_protocols->count) {
+        return_values.status = (int32_t)SCMI_INVALID_PARAMETERS;
+        goto error;
     }
-#endif
-
-    for (index = 0,
-        protocol_count = 0,
-        payload_size = sizeof(struct scmi_base_discover_list_protocols_p2a);
-         (index < FWK_ARRAY_SIZE(shared_scmi_ctx->scmi_protocol_id_to_idx)) &&
-         (protocol_count < protocol_count_max);
-         index++) {
-        if ((shared_scmi_ctx->scmi_protocol_id_to_idx[index] == 0) ||
-            (index == MOD_SCMI_PROTOCOL_ID_BASE)) {
-            continue;
-        }
 
-        protocol_id = (uint8_t)index;
-
-#ifdef BUILD_HAS_MOD_RESOURCE_PERMS
-        /*
-         * Check that the agent has the permission to access the protocol
-         */
-        perms = shared_scmi_ctx->res_perms_api->agent_has_protocol_permission(
-            agent_id, protocol_id);
-
-        if (perms == MOD_RES_PERMS_ACCESS_DENIED) {
-            continue;
-        }
-#else
-        /*
-         * PSCI agents are only allowed access certain protocols defined
-         * for the platform.
-         */
-        if (agent_type == SCMI_AGENT_TYPE_PSCI) {
-            /*
-             * assert if a valid list of disabled protocols is supplied in case
-             * the number of the disabled protocols is not zero. In case the
-             * number of the disabled protocols is zero , then no list needs to
-             * be supplied
-             */
-            fwk_assert(
-                (shared_scmi_ctx->config->dis_protocol_list_psci != NULL) ||
-                (shared_scmi_ctx->config->dis_protocol_count_psci == 0));
-
-            /*
-             * check if the current protocol is within the disabled protocols
-             * list.
-             */
-            for (dis_protocol_list_psci_index = 0;
-                 dis_protocol_list_psci_index <
-                 shared_scmi_ctx->config->dis_protocol_count_psci;
-                 dis_protocol_list_psci_index++) {
-                if (protocol_id ==
-                    shared_scmi_ctx->config->dis_protocol_list_psci
-                        [dis_protocol_list_psci_index]) {
-                    break;
-                }
-            }
-
-            /*
-             * don't include the protocol in case it is in the disabled list
-             */
-            if (dis_protocol_list_psci_index !=
-                shared_scmi_ctx->config->dis_protocol_count_psci) {
-                continue;
-            }
-        }
-#endif
-
-        protocol_count++;
-        if (protocol_count <= skip) {
-            continue;
-        }
+    avail_protocol_count =
+        FWK_MIN(agent_protocols->count - skip, entry_count);
+    payload_size = sizeof(struct scmi_base_discover_list_protocols_p2a);
 
+    if (avail_protocol_count != 0) {
         status = protocol_api->write_payload(
-            service_id, payload_size, &protocol_id, sizeof(protocol_id));
+            service_id,
+            payload_size,
+            &agent_protocols->protocol_ids[skip],
+            avail_protocol_count);
         if (status != FWK_SUCCESS) {
             goto error;
         }
-        payload_size += sizeof(protocol_id);
-        avail_protocol_count++;
-    }
-
-    if (skip > protocol_count) {
-        return_values.status = (int32_t)SCMI_INVALID_PARAMETERS;
-        goto error;
+        payload_size += avail_protocol_count;
     }
 
     return_values.status = (int32_t)SCMI_SUCCESS;
@@ -512,7 +489,6 @@ static int scmi_base_discover_agent_handler(
     struct scmi_base_discover_agent_p2a return_values = {
         .status = (int32_t)SCMI_NOT_FOUND,
     };
-    const struct mod_scmi_agent *agent;
 
 #if (SCMI_PROTOCOL_VERSION_BASE >= UINT32_C(0x20000))
     unsigned int agent_id;
@@ -532,24 +508,6 @@ static int scmi_base_discover_agent_handler(
     }
 #endif
 
-    return_values.status = (int32_t)SCMI_SUCCESS;
-
-    if (parameters->agent_id == MOD_SCMI_PLATFORM_ID) {
-        static const char name[] = "platform";
-
-        static_assert(
-            sizeof(return_values.name) >= sizeof(name),
-            "return_values.name is not large enough to contain name");
-
-        fwk_str_memcpy(return_values.name, name, sizeof(name));
-
-#if (SCMI_PROTOCOL_VERSION_BASE >= UINT32_C(0x20000))
-        return_values.agent_id = MOD_SCMI_PLATFORM_ID;
-#endif
-
-        goto exit;
-    }
-
 #if (SCMI_PROTOCOL_VERSION_BASE >= UINT32_C(0x20000))
     if (parameters->agent_id == 0xFFFFFFFF) {
         /*
@@ -563,6 +521,7 @@ static int scmi_base_discover_agent_handler(
             return FWK_E_ACCESS;
         }
 
+        return_values.status = (int32_t)SCMI_SUCCESS;
         return_values.agent_id = (uint32_t)agent_id;
 
         fwk_str_strncpy(
@@ -574,20 +533,10 @@ static int scmi_base_discover_agent_handler(
     }
 #endif
 
-#if (SCMI_PROTOCOL_VERSION_BASE >= UINT32_C(0x20000))
-    /*
-     * agent_id is identical to the agent_id field passed via the calling
-     * parameters.
-     */
-    return_values.agent_id = parameters->agent_id;
-#endif
-
-    agent = &shared_scmi_ctx->config->agent_table[parameters->agent_id];
-
-    fwk_str_strncpy(
-        return_values.name,
-        (agent->name != NULL) ? agent->name : default_agent_names[agent->type],
-        sizeof(return_values.name) - 1);
+    return protocol_api->respond(
+        service_id,
+        &discover_agent_responses[parameters->agent_id],
+        sizeof(discover_agent_responses[parameters->agent_id]));
 
 exit:
     return protocol_api->respond(
@@ -636,6 +585,7 @@ static int scmi_base_set_device_permissions(
 
     switch (status) {
     case FWK_SUCCESS:
+        scmi_base_invalidate_agent_protocols(parameters->agent_id);
         return_values.status = (int32_t)SCMI_SUCCESS;
         break;
     case FWK_E_PARAM:
@@ -709,6 +659,7 @@ static int scmi_base_set_protocol_permissions(
 
     switch (status) {
     case FWK_SUCCESS:
+        scmi_base_invalidate_agent_protocols(parameters->agent_id);
         return_values.status = (int32_t)SCMI_SUCCESS;
         break;
     case FWK_E_PARAM:
@@ -770,6 +721,7 @@ static int scmi_base_reset_agent_config(
 
     switch (status) {
     case FWK_SUCCESS:
+        scmi_base_invalidate_agent_protocols(parameters->agent_id);
         return_values.status = (int32_t)SCMI_SUCCESS;
         break;
     case FWK_E_PARAM:
@@ -877,3 +829,63 @@ void scmi_base_set_shared_ctx(struct mod_scmi_ctx *scmi_ctx_param)
 {
     shared_scmi_ctx = scmi_ctx_param;
 }
+
+void scmi_base_discovery_init(void)
+{
+    unsigned int agent_count = shared_scmi_ctx->config->agent_count;
+    unsigned int agent_id;
+    const struct mod_scmi_agent *agent;
+    struct scmi_base_discover_agent_p2a *response;
+    static const char platform_name[] = "platform";
+
+    static_assert(
+        sizeof(response->name) >= sizeof(platform_name),
+        "response->name is not large enough to contain platform_name");
+
+    discover_vendor_response.status = (int32_t)SCMI_SUCCESS;
+    if (shared_scmi_ctx->config->vendor_identifier != NULL) {
+        fwk_str_strncpy(
+            discover_vendor_response.vendor_identifier,
+            shared_scmi_ctx->config->vendor_identifier,
+            sizeof(discover_vendor_response.vendor_identifier) - 1);
+    }
+
+    discover_sub_vendor_response.status = (int32_t)SCMI_SUCCESS;
+    if (shared_scmi_ctx->config->sub_vendor_identifier != NULL) {
+        fwk_str_strncpy(
+            discover_sub_vendor_response.sub_vendor_identifier,
+            shared_scmi_ctx->config->sub_vendor_identifier,
+            sizeof(discover_sub_vendor_response.sub_vendor_identifier) - 1);
+    }
+
+    /* One entry per agent, plus the platform */
+    discover_agent_responses =
+        fwk_mm_calloc(agent_count + 1, sizeof(discover_agent_responses[0]));
+    agent_protocols_table =
+        fwk_mm_calloc(agent_count + 1, sizeof(agent_protocols_table[0]));
+
+    for (agent_id = 0; agent_id <= agent_count; agent_id++) {
+        response = &discover_agent_responses[agent_id];
+        response->status = (int32_t)SCMI_SUCCESS;
+#if (SCMI_PROTOCOL_VERSION_BASE >= UINT32_C(0x20000))
+        response->agent_id = (uint32_t)agent_id;
+#endif
+
+        if (agent_id == MOD_SCMI_PLATFORM_ID) {
+            fwk_str_memcpy(
+                response->name, platform_name, sizeof(platform_name));
+        } else {
+            agent = &shared_scmi_ctx->config->agent_table[agent_id];
+            fwk_str_strncpy(
+                response->name,
+                (agent->name != NULL) ? agent->name :
+                                        default_agent_names[agent->type],
+                sizeof(response->name) - 1);
+        }
+
+        /* The protocol lists are built on first use */
+        agent_protocols_table[agent_id].protocol_ids = fwk_mm_calloc(
+            FWK_MAX(shared_scmi_ctx->protocol_count, 1U), sizeof(uint8_t));
+        agent_protocols_table[agent_id].stale = true;
+    }
+}
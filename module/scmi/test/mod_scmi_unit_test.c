@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2022-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2022-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -24,6 +24,7 @@
 #include <mod_scmi.h>
 
 #include <fwk_element.h>
+#include <fwk_list.h>
 #include <fwk_macros.h>
 
 #include UNIT_TEST_SRC
@@ -157,6 +158,7 @@ void setUp(void)
 
     scmi_base_set_shared_ctx(&scmi_ctx);
     scmi_base_set_api(&from_protocol_api);
+    scmi_base_discovery_init();
 
     ctx = &scmi_ctx.service_ctx_table[FAKE_SERVICE_IDX_PSCI];
     ctx->config =
@@ -283,6 +285,362 @@ void test_send_to_notification_handler(void)
     TEST_ASSERT_EQUAL(status, FWK_SUCCESS);
 }
 
+void test_scmi_base_agent_protocols_built_once(void)
+{
+    int status;
+    enum scmi_agent_type agent_type = SCMI_AGENT_TYPE_OSPM;
+    const struct scmi_base_agent_protocols *agent_protocols;
+
+    scmi_ctx.protocol_count = 2;
+    scmi_ctx.scmi_protocol_id_to_idx[MOD_SCMI_PROTOCOL_ID_PERF] =
+        PROTOCOL_TABLE_RESERVED_ENTRIES_COUNT;
+    scmi_ctx.scmi_protocol_id_to_idx[MOD_SCMI_PROTOCOL_ID_SENSOR] =
+        PROTOCOL_TABLE_RESERVED_ENTRIES_COUNT + 1;
+    scmi_base_discovery_init();
+
+    mod_scmi_from_protocol_get_agent_type_ExpectAnyArgsAndReturn(FWK_SUCCESS);
+    mod_scmi_from_protocol_get_agent_type_ReturnThruPtr_agent_type(
+        &agent_type);
+
+    status = scmi_base_get_agent_protocols(
+        FAKE_SCMI_AGENT_IDX_OSPM, &agent_protocols);
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+    TEST_ASSERT_EQUAL(2, agent_protocols->count);
+    TEST_ASSERT_EQUAL(
+        MOD_SCMI_PROTOCOL_ID_PERF, agent_protocols->protocol_ids[0]);
+    TEST_ASSERT_EQUAL(
+        MOD_SCMI_PROTOCOL_ID_SENSOR, agent_protocols->protocol_ids[1]);
+
+    /* The list is served from the cache, the agent type is not read again */
+    status = scmi_base_get_agent_protocols(
+        FAKE_SCMI_AGENT_IDX_OSPM, &agent_protocols);
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+    TEST_ASSERT_EQUAL(2, agent_protocols->count);
+
+    scmi_ctx.protocol_count = 0;
+    scmi_ctx.scmi_protocol_id_to_idx[MOD_SCMI_PROTOCOL_ID_PERF] = 0;
+    scmi_ctx.scmi_protocol_id_to_idx[MOD_SCMI_PROTOCOL_ID_SENSOR] = 0;
+}
+
+#define FAKE_OUTSTANDING_REQUEST_COUNT 2
+#define FAKE_REQUEST_PAYLOAD_SIZE_MAX  16
+
+static unsigned int fake_response_count;
+static int fake_response_status;
+static uint16_t fake_response_token;
+static uintptr_t fake_response_cookie;
+
+static void fake_response_callback(
+    fwk_id_t service_id,
+    uint16_t token,
+    int status,
+    const uint32_t *payload,
+    size_t payload_size,
+    uintptr_t cookie)
+{
+    fake_response_count++;
+    fake_response_status = status;
+    fake_response_token = token;
+    fake_response_cookie = cookie;
+}
+
+static struct scmi_service_ctx *setup_outstanding_requests(void)
+{
+    static struct mod_scmi_service_config config;
+    struct scmi_service_ctx *ctx;
+    unsigned int idx;
+
+    ctx = &scmi_ctx.service_ctx_table[FAKE_SERVICE_IDX_OSPM];
+
+    config = *ctx->config;
+    config.scmi_entity_role = MOD_SCMI_ROLE_AGENT;
+    config.outstanding_request_count = FAKE_OUTSTANDING_REQUEST_COUNT;
+    ctx->config = &config;
+
+    ctx->request_payload_size_max = FAKE_REQUEST_PAYLOAD_SIZE_MAX;
+    ctx->outstanding_requests = fwk_mm_calloc(
+        FAKE_OUTSTANDING_REQUEST_COUNT, sizeof(ctx->outstanding_requests[0]));
+    for (idx = 0; idx < FAKE_OUTSTANDING_REQUEST_COUNT; idx++) {
+        ctx->outstanding_requests[idx].payload =
+            fwk_mm_calloc(1, FAKE_REQUEST_PAYLOAD_SIZE_MAX);
+    }
+    fwk_list_init(&ctx->request_queue);
+    ctx->next_request_token = (uint16_t)SCMI_REQUEST_TOKEN_MIN;
+
+    fake_response_count = 0;
+
+    return ctx;
+}
+
+static int send_fake_request(uintptr_t cookie, uint16_t *token)
+{
+    uint32_t payload = 0xA5A5A5A5;
+    struct mod_scmi_request request = {
+        .service_id =
+            FWK_ID_ELEMENT_INIT(FAKE_MODULE_ID, FAKE_SERVICE_IDX_OSPM),
+        .protocol_id = MOD_SCMI_PROTOCOL_ID_SENSOR,
+        .message_id = 0x6,
+        .payload = &payload,
+        .payload_size = sizeof(payload),
+        .callback = fake_response_callback,
+        .cookie = cookie,
+    };
+
+#if !defined(TEST_ON_TARGET)
+    fwk_module_is_valid_element_id_ExpectAndReturn(request.service_id, true);
+    fwk_id_get_element_idx_ExpectAndReturn(
+        request.service_id, FAKE_SERVICE_IDX_OSPM);
+#endif
+
+    return scmi_send_request(&request, token);
+}
+
+void test_scmi_send_request_not_supported(void)
+{
+    int status;
+    uint16_t token;
+
+    status = send_fake_request(0, &token);
+    TEST_ASSERT_EQUAL(FWK_E_SUPPORT, status);
+}
+
+void test_scmi_send_request_queued_when_busy(void)
+{
+    int status;
+    uint16_t token_a, token_b;
+    struct scmi_service_ctx *ctx = setup_outstanding_requests();
+
+    mod_scmi_to_transport_api_transmit_ExpectAnyArgsAndReturn(FWK_SUCCESS);
+    status = send_fake_request(1, &token_a);
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+
+    mod_scmi_to_transport_api_transmit_ExpectAnyArgsAndReturn(FWK_E_BUSY);
+    status = send_fake_request(2, &token_b);
+    TEST_ASSERT_EQUAL(FWK_PENDING, status);
+    TEST_ASSERT_NOT_EQUAL(token_a, token_b);
+    TEST_ASSERT_FALSE(fwk_list_is_empty(&ctx->request_queue));
+
+    /* Both entries are in use */
+    status = send_fake_request(3, NULL);
+    TEST_ASSERT_EQUAL(FWK_E_BUSY, status);
+}
+
+void test_scmi_request_response_matched_by_token(void)
+{
+    int status;
+    bool handled;
+    uint16_t token_a, token_b;
+    uint32_t response = SCMI_SUCCESS;
+    fwk_id_t service_id =
+        FWK_ID_ELEMENT_INIT(FAKE_MODULE_ID, FAKE_SERVICE_IDX_OSPM);
+    struct scmi_service_ctx *ctx = setup_outstanding_requests();
+
+    mod_scmi_to_transport_api_transmit_ExpectAnyArgsAndReturn(FWK_SUCCESS);
+    status = send_fake_request(1, &token_a);
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+
+    mod_scmi_to_transport_api_transmit_ExpectAnyArgsAndReturn(FWK_E_BUSY);
+    status = send_fake_request(2, &token_b);
+    TEST_ASSERT_EQUAL(FWK_PENDING, status);
+
+    /* A response with an unknown token goes to the requester handler */
+    ctx->scmi_message_type = MOD_SCMI_MESSAGE_TYPE_COMMAND;
+    ctx->scmi_protocol_id = MOD_SCMI_PROTOCOL_ID_SENSOR;
+    ctx->scmi_message_id = 0x6;
+    ctx->scmi_token = 0x12;
+    handled = handle_request_response(
+        service_id, ctx, &response, sizeof(response));
+    TEST_ASSERT_FALSE(handled);
+    TEST_ASSERT_EQUAL(0, fake_response_count);
+
+    /* A queued request cannot be answered */
+    ctx->scmi_token = token_b;
+    handled = handle_request_response(
+        service_id, ctx, &response, sizeof(response));
+    TEST_ASSERT_FALSE(handled);
+
+    ctx->scmi_token = token_a;
+    handled = handle_request_response(
+        service_id, ctx, &response, sizeof(response));
+    TEST_ASSERT_TRUE(handled);
+    TEST_ASSERT_EQUAL(1, fake_response_count);
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, fake_response_status);
+    TEST_ASSERT_EQUAL(token_a, fake_response_token);
+    TEST_ASSERT_EQUAL(1, fake_response_cookie);
+
+    /* The queued request is transmitted once the channel is free */
+    mod_scmi_to_transport_api_transmit_ExpectAnyArgsAndReturn(FWK_SUCCESS);
+    send_queued_requests(service_id, ctx);
+    TEST_ASSERT_TRUE(fwk_list_is_empty(&ctx->request_queue));
+
+    ctx->scmi_token = token_b;
+    handled = handle_request_response(
+        service_id, ctx, &response, sizeof(response));
+    TEST_ASSERT_TRUE(handled);
+    TEST_ASSERT_EQUAL(2, fake_response_count);
+    TEST_ASSERT_EQUAL(2, fake_response_cookie);
+}
+
+#ifdef BUILD_HAS_MOD_SCMI_LATENCY_STATS
+static struct mod_scmi_latency_stats
+    fake_latency_stats[2 * MOD_SCMI_LATENCY_STATS_MESSAGE_ID_COUNT];
+
+static struct mod_scmi_latency_stats *setup_latency_stats(void)
+{
+    memset(fake_latency_stats, 0, sizeof(fake_latency_stats));
+    scmi_ctx.latency_stats = fake_latency_stats;
+    scmi_ctx.latency_stats_protocol_count = 2;
+
+    return &fake_latency_stats
+        [PROTOCOL_TABLE_BASE_PROTOCOL_IDX *
+         MOD_SCMI_LATENCY_STATS_MESSAGE_ID_COUNT];
+}
+
+void test_latency_stats_bucket(void)
+{
+    /* Bucket 0 counts the sub-microsecond latencies */
+    TEST_ASSERT_EQUAL(0, latency_stats_bucket(0));
+    TEST_ASSERT_EQUAL(0, latency_stats_bucket(999));
+
+    /* Bucket n counts the latencies in [2^(n-1), 2^n) microseconds */
+    TEST_ASSERT_EQUAL(1, latency_stats_bucket(1000));
+    TEST_ASSERT_EQUAL(2, latency_stats_bucket(2000));
+    TEST_ASSERT_EQUAL(2, latency_stats_bucket(3999));
+    TEST_ASSERT_EQUAL(3, latency_stats_bucket(4000));
+
+    /* The last bucket counts all the longer latencies */
+    TEST_ASSERT_EQUAL(
+        MOD_SCMI_LATENCY_STATS_BUCKET_COUNT - 1,
+        latency_stats_bucket(UINT32_MAX));
+}
+
+void test_latency_stats_add(void)
+{
+    struct mod_scmi_latency_stats stats = { 0 };
+
+    latency_stats_add(&stats, 3000);
+    latency_stats_add(&stats, 500);
+    latency_stats_add(&stats, 10000);
+
+    TEST_ASSERT_EQUAL(3, stats.count);
+    TEST_ASSERT_EQUAL(500, stats.min_ns);
+    TEST_ASSERT_EQUAL(10000, stats.max_ns);
+    TEST_ASSERT_EQUAL_UINT64(13500, stats.total_ns);
+    TEST_ASSERT_EQUAL(1, stats.histogram[0]);
+    TEST_ASSERT_EQUAL(1, stats.histogram[2]);
+    TEST_ASSERT_EQUAL(1, stats.histogram[4]);
+}
+
+void test_latency_stats_delayed_response(void)
+{
+    int status;
+    uint16_t token;
+    int32_t payload = SCMI_SUCCESS;
+    struct mod_scmi_latency_stats *stats = setup_latency_stats();
+    struct scmi_service_ctx *ctx =
+        &scmi_ctx.service_ctx_table[FAKE_SERVICE_IDX_OSPM];
+    struct mod_scmi_service_config config = *ctx->config;
+    fwk_id_t service_id =
+        FWK_ID_ELEMENT_INIT(FAKE_MODULE_ID, FAKE_SERVICE_IDX_OSPM);
+
+    /* Use the PSCI service as the notification channel of OSPM */
+    config.scmi_p2a_id =
+        (fwk_id_t)FWK_ID_ELEMENT_INIT(FAKE_MODULE_ID, FAKE_SERVICE_IDX_PSCI);
+    ctx->config = &config;
+
+    ctx->scmi_message_type = MOD_SCMI_MESSAGE_TYPE_COMMAND;
+    ctx->scmi_protocol_id = MOD_SCMI_PROTOCOL_ID_BASE;
+    ctx->scmi_message_id = 0x3;
+    ctx->scmi_token = 0x21;
+    ctx->delayed_response = false;
+
+#    if !defined(TEST_ON_TARGET)
+    fwk_id_get_element_idx_ExpectAndReturn(service_id, FAKE_SERVICE_IDX_OSPM);
+#    endif
+    status = get_delayed_response_token(service_id, &token);
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+    TEST_ASSERT_EQUAL(0x21, token);
+
+    /* The immediate response of a delayed command is not accounted for */
+#    if !defined(TEST_ON_TARGET)
+    fwk_id_get_element_idx_ExpectAndReturn(service_id, FAKE_SERVICE_IDX_OSPM);
+    fwk_module_get_element_name_ExpectAndReturn(service_id, "OSPM");
+#    endif
+    mod_scmi_to_transport_api_respond_ExpectAnyArgsAndReturn(FWK_SUCCESS);
+    status = respond(service_id, &payload, sizeof(payload));
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+    TEST_ASSERT_EQUAL(0, stats[0x3].count);
+
+    /* The command is accounted for once its delayed response is sent */
+#    if !defined(TEST_ON_TARGET)
+    fwk_id_get_element_idx_ExpectAndReturn(service_id, FAKE_SERVICE_IDX_OSPM);
+    fwk_id_is_equal_ExpectAnyArgsAndReturn(false);
+    fwk_id_get_element_idx_ExpectAndReturn(
+        config.scmi_p2a_id, FAKE_SERVICE_IDX_PSCI);
+#    endif
+    mod_scmi_to_transport_api_transmit_ExpectAnyArgsAndReturn(FWK_SUCCESS);
+    status = send_delayed_response(
+        service_id,
+        MOD_SCMI_PROTOCOL_ID_BASE,
+        0x3,
+        token,
+        &payload,
+        sizeof(payload));
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+    TEST_ASSERT_EQUAL(1, stats[0x3].count);
+    TEST_ASSERT_FALSE(ctx->delayed_commands[0].valid);
+
+    ctx->config =
+        (struct mod_scmi_service_config *)element_table[FAKE_SERVICE_IDX_OSPM]
+            .data;
+    scmi_ctx.latency_stats = NULL;
+}
+
+void test_latency_stats_delayed_command_overflow(void)
+{
+    unsigned int i;
+    struct mod_scmi_latency_stats *stats = setup_latency_stats();
+    struct scmi_service_ctx *ctx =
+        &scmi_ctx.service_ctx_table[FAKE_SERVICE_IDX_OSPM];
+
+    ctx->scmi_message_type = MOD_SCMI_MESSAGE_TYPE_COMMAND;
+    ctx->scmi_protocol_id = MOD_SCMI_PROTOCOL_ID_BASE;
+    ctx->scmi_message_id = 0x3;
+    ctx->delayed_response = true;
+    memset(ctx->delayed_commands, 0, sizeof(ctx->delayed_commands));
+
+    for (i = 0; i < SCMI_DELAYED_COMMAND_COUNT; i++) {
+        ctx->scmi_token = (uint16_t)i;
+        ctx->signal_timestamp = 100 - i;
+        latency_stats_record(ctx);
+    }
+    TEST_ASSERT_EQUAL(0, stats[0x3].dropped_count);
+
+    /* A free entry is used before the oldest pending command is dropped */
+    ctx->delayed_commands[2].valid = false;
+    ctx->scmi_token = 0x10;
+    ctx->signal_timestamp = 200;
+    latency_stats_record(ctx);
+    TEST_ASSERT_EQUAL(0x10, ctx->delayed_commands[2].token);
+    TEST_ASSERT_EQUAL(0, stats[0x3].dropped_count);
+
+    /* The command with the earliest signal timestamp is dropped */
+    ctx->scmi_message_id = 0x4;
+    ctx->scmi_token = 0x11;
+    ctx->signal_timestamp = 300;
+    latency_stats_record(ctx);
+    TEST_ASSERT_EQUAL(0x11, ctx->delayed_commands[3].token);
+    TEST_ASSERT_EQUAL(0x4, ctx->delayed_commands[3].message_id);
+    TEST_ASSERT_EQUAL(1, stats[0x3].dropped_count);
+    TEST_ASSERT_EQUAL(0, stats[0x3].count);
+    TEST_ASSERT_EQUAL(0, stats[0x4].dropped_count);
+
+    ctx->delayed_response = false;
+    memset(ctx->delayed_commands, 0, sizeof(ctx->delayed_commands));
+    scmi_ctx.latency_stats = NULL;
+}
+#endif
+
 int scmi_test_main(void)
 {
     UNITY_BEGIN();
@@ -292,6 +650,19 @@ int scmi_test_main(void)
 
     RUN_TEST(test_send_to_message_handler);
     RUN_TEST(test_send_to_notification_handler);
+
+    RUN_TEST(test_scmi_base_agent_protocols_built_once);
+
+    RUN_TEST(test_scmi_send_request_not_supported);
+    RUN_TEST(test_scmi_send_request_queued_when_busy);
+    RUN_TEST(test_scmi_request_response_matched_by_token);
+
+#ifdef BUILD_HAS_MOD_SCMI_LATENCY_STATS
+    RUN_TEST(test_latency_stats_bucket);
+    RUN_TEST(test_latency_stats_add);
+    RUN_TEST(test_latency_stats_delayed_response);
+    RUN_TEST(test_latency_stats_delayed_command_overflow);
+#endif
     return UNITY_END();
 }
 
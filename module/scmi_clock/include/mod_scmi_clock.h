@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2015-2021, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -113,6 +113,22 @@ struct mod_scmi_clock_config {
 
     /*! Number of agents in ::mod_scmi_clock_config::agent_table */
     size_t agent_count;
+
+    /*!
+     * \brief Maximum number of requests queued per clock device while an
+     *      operation is in progress on the clock device.
+     *
+     * \details The queued requests are processed in order as the operations
+     *      in progress complete. Requests received while the queue of the
+     *      clock device is full are rejected with SCMI_BUSY. When the queues
+     *      are enabled, a CLOCK_ATTRIBUTES request received while the clock
+     *      device is busy is answered immediately with the state the agent
+     *      has requested for the clock.
+     *
+     * \note A value of 0 disables the queues, and every request received
+     *      while the clock device is busy is rejected with SCMI_BUSY.
+     */
+    uint8_t max_queued_operations;
 };
 
 /*!
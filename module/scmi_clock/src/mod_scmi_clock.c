@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2015-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -56,6 +56,45 @@ struct clock_operations {
     enum scmi_clock_request_type request;
 };
 
+struct clock_queued_operation {
+    /* Operation to perform once the clock device is available */
+    struct clock_operations op;
+
+    /* Identifier of the request event */
+    fwk_id_t event_id;
+
+    /* Parameters of the request event */
+    struct scmi_clock_event_request_params params;
+};
+
+struct clock_ops_queue {
+    /* Table of queued operations, used as a circular buffer */
+    struct clock_queued_operation *entries;
+
+    /* Index of the oldest queued operation */
+    uint8_t head;
+
+    /* Number of queued operations */
+    uint8_t count;
+};
+
+/*
+ * Rates of a clock in the format of the CLOCK_DESCRIBE_RATES response
+ */
+struct clock_rate_table {
+    /* The table has been built */
+    bool is_built;
+
+    /* SCMI_CLOCK_RATE_FORMAT_LIST or SCMI_CLOCK_RATE_FORMAT_RANGE */
+    uint32_t format;
+
+    /* Number of entries in the table */
+    uint32_t rate_count;
+
+    /* List of rates, or the (min, max, step) triplet of a range */
+    struct scmi_clock_rate *rates;
+};
+
 struct mod_scmi_clock_ctx {
     /*! SCMI Clock Module Configuration */
     const struct mod_scmi_clock_config *config;
@@ -81,6 +120,15 @@ struct mod_scmi_clock_ctx {
     /* Pointer to a table of clock operations */
     struct clock_operations *clock_ops;
 
+    /* Maximum number of queued operations per clock device */
+    uint8_t max_queued_operations;
+
+    /* Pointer to a table of queues of clock operations */
+    struct clock_ops_queue *clock_ops_queue;
+
+    /* Pointer to a table of rate tables, one per clock device */
+    struct clock_rate_table *rate_tables;
+
     /* Pointer to a table of clock reference counts */
     uint8_t *dev_clock_ref_count_table;
 
@@ -469,11 +517,6 @@ static void clock_ops_update_state(unsigned int clock_dev_idx, int status)
     }
 }
 
-static inline void clock_ops_set_available(unsigned int clock_dev_idx)
-{
-    scmi_clock_ctx.clock_ops[clock_dev_idx].service_id = FWK_ID_NONE;
-}
-
 static inline fwk_id_t clock_ops_get_service(unsigned int clock_dev_idx)
 {
     return scmi_clock_ctx.clock_ops[clock_dev_idx].service_id;
@@ -485,6 +528,13 @@ static inline bool clock_ops_is_available(unsigned int clock_dev_idx)
                            FWK_ID_NONE);
 }
 
+static inline bool clock_ops_queue_is_full(unsigned int clock_dev_idx)
+{
+    return scmi_clock_ctx.clock_ops_queue == NULL ||
+        scmi_clock_ctx.clock_ops_queue[clock_dev_idx].count ==
+        scmi_clock_ctx.max_queued_operations;
+}
+
 /*
  * Helper for the 'get_state' response
  */
@@ -599,6 +649,138 @@ static void set_request_respond(fwk_id_t service_id, int status)
     }
 }
 
+/*
+ * Get the queued operation at a given position from the oldest one.
+ */
+static inline struct clock_queued_operation *clock_ops_queue_entry(
+    struct clock_ops_queue *queue,
+    unsigned int position)
+{
+    return &queue->entries
+                [(queue->head + position) %
+                 scmi_clock_ctx.max_queued_operations];
+}
+
+static void clock_ops_enqueue(
+    unsigned int clock_dev_idx,
+    const struct fwk_event *event,
+    fwk_id_t service_id,
+    uint32_t scmi_clock_idx,
+    enum mod_clock_state state,
+    enum scmi_clock_request_type request)
+{
+    struct clock_ops_queue *queue;
+    struct clock_queued_operation *entry;
+
+    queue = &scmi_clock_ctx.clock_ops_queue[clock_dev_idx];
+    entry = clock_ops_queue_entry(queue, queue->count);
+    queue->count++;
+
+    entry->op = (struct clock_operations){
+        .service_id = service_id,
+        .state = state,
+        .scmi_clock_idx = scmi_clock_idx,
+        .request = request,
+    };
+    entry->event_id = event->id;
+    memcpy(&entry->params, event->params, sizeof(entry->params));
+}
+
+/*
+ * Start the oldest queued operation of a clock device, if any.
+ */
+static void clock_ops_start_next(unsigned int clock_dev_idx)
+{
+    int status;
+    struct clock_ops_queue *queue;
+    struct clock_queued_operation *entry;
+    struct fwk_event event;
+
+    if (scmi_clock_ctx.clock_ops_queue == NULL) {
+        return;
+    }
+
+    queue = &scmi_clock_ctx.clock_ops_queue[clock_dev_idx];
+
+    while (queue->count > 0) {
+        entry = clock_ops_queue_entry(queue, 0);
+        queue->head = (uint8_t)(
+            (queue->head + 1u) % scmi_clock_ctx.max_queued_operations);
+        queue->count--;
+
+        event = (struct fwk_event){
+            .target_id = fwk_module_id_scmi_clock,
+            .id = entry->event_id,
+        };
+        memcpy(event.params, &entry->params, sizeof(entry->params));
+
+        status = fwk_put_event(&event);
+        if (status == FWK_SUCCESS) {
+            scmi_clock_ctx.clock_ops[clock_dev_idx] = entry->op;
+            return;
+        }
+
+        request_response(status, entry->op.service_id);
+    }
+}
+
+static void clock_ops_set_available(unsigned int clock_dev_idx)
+{
+    scmi_clock_ctx.clock_ops[clock_dev_idx].service_id = FWK_ID_NONE;
+
+    clock_ops_start_next(clock_dev_idx);
+}
+
+/*
+ * Serve a request for the state of a clock while an operation is in progress
+ * on the clock device. The state reported to an agent is the target of its
+ * latest set state request, if any, and the state it last set otherwise.
+ */
+static int clock_ops_get_target_state(
+    fwk_id_t clock_id,
+    fwk_id_t service_id,
+    uint32_t scmi_clock_idx)
+{
+    int status;
+    unsigned int agent_id;
+    unsigned int clock_dev_idx = fwk_id_get_element_idx(clock_id);
+    unsigned int i;
+    enum mod_clock_state clock_state;
+    const struct clock_operations *op;
+    struct clock_ops_queue *queue;
+
+    status = scmi_clock_ctx.scmi_api->get_agent_id(service_id, &agent_id);
+    if (status != FWK_SUCCESS) {
+        return status;
+    }
+
+    clock_state = scmi_clock_get_agent_clock_state(agent_id, scmi_clock_idx);
+
+    op = &scmi_clock_ctx.clock_ops[clock_dev_idx];
+    if ((op->request == SCMI_CLOCK_REQUEST_SET_STATE) &&
+        (op->scmi_clock_idx == scmi_clock_idx) &&
+        fwk_id_is_equal(op->service_id, service_id)) {
+        clock_state = op->state;
+    }
+
+    if (scmi_clock_ctx.clock_ops_queue != NULL) {
+        queue = &scmi_clock_ctx.clock_ops_queue[clock_dev_idx];
+
+        for (i = 0; i < queue->count; i++) {
+            op = &clock_ops_queue_entry(queue, i)->op;
+            if ((op->request == SCMI_CLOCK_REQUEST_SET_STATE) &&
+                (op->scmi_clock_idx == scmi_clock_idx) &&
+                fwk_id_is_equal(op->service_id, service_id)) {
+                clock_state = op->state;
+            }
+        }
+    }
+
+    get_state_respond(clock_id, service_id, &clock_state, FWK_SUCCESS);
+
+    return FWK_SUCCESS;
+}
+
 FWK_WEAK int mod_scmi_clock_rate_set_policy(
     enum mod_scmi_clock_policy_status *policy_status,
     enum mod_clock_round_mode *round_mode,
@@ -711,9 +893,20 @@ static int create_event_request(
     unsigned int clock_dev_idx = fwk_id_get_element_idx(clock_id);
     struct scmi_clock_event_request_params *params;
     enum mod_clock_state state = MOD_CLOCK_STATE_COUNT;
+    bool queue_request = false;
 
     if (!clock_ops_is_available(clock_dev_idx)) {
-        return FWK_E_BUSY;
+        if ((request == SCMI_CLOCK_REQUEST_GET_STATE) &&
+            (scmi_clock_ctx.clock_ops_queue != NULL)) {
+            return clock_ops_get_target_state(
+                clock_id, service_id, scmi_clock_idx);
+        }
+
+        if (clock_ops_queue_is_full(clock_dev_idx)) {
+            return FWK_E_BUSY;
+        }
+
+        queue_request = true;
     }
 
     struct fwk_event event = {
@@ -765,6 +958,13 @@ static int create_event_request(
 
     params->clock_dev_id = clock_id;
 
+    if (queue_request) {
+        /* The request is started once the clock device is available */
+        clock_ops_enqueue(
+            clock_dev_idx, &event, service_id, scmi_clock_idx, state, request);
+        return FWK_SUCCESS;
+    }
+
     status = fwk_put_event(&event);
     if (status != FWK_SUCCESS) {
         return status;
@@ -1197,6 +1397,95 @@ exit:
         service_id, &return_values, response_size);
 }
 
+/*
+ * Build the table of the rates of a clock device as they are returned by the
+ * CLOCK_DESCRIBE_RATES command. The rates of a clock do not change at runtime
+ * so the table is only built once.
+ */
+static int scmi_clock_build_rate_table(fwk_id_t clock_dev_id)
+{
+    int status;
+    unsigned int i;
+    uint64_t rate;
+    struct mod_clock_info info;
+    struct scmi_clock_rate *rates;
+    struct clock_rate_table *rate_table;
+
+    rate_table =
+        &scmi_clock_ctx.rate_tables[fwk_id_get_element_idx(clock_dev_id)];
+    if (rate_table->is_built) {
+        return FWK_SUCCESS;
+    }
+
+    status = scmi_clock_ctx.clock_api->get_info(clock_dev_id, &info);
+    if (status != FWK_SUCCESS) {
+        return status;
+    }
+
+    if (info.range.rate_type == MOD_CLOCK_RATE_TYPE_DISCRETE) {
+        if (info.range.rate_count > UINT32_MAX) {
+            return FWK_E_RANGE;
+        }
+
+        rates = NULL;
+        if (info.range.rate_count > 0) {
+            rates = fwk_mm_alloc(
+                (size_t)info.range.rate_count, sizeof(struct scmi_clock_rate));
+        }
+
+        for (i = 0; i < info.range.rate_count; i++) {
+            status = scmi_clock_ctx.clock_api->get_rate_from_index(
+                clock_dev_id, i, &rate);
+            if (status != FWK_SUCCESS) {
+                fwk_mm_free(rates);
+                return status;
+            }
+
+            rates[i].low = (uint32_t)rate;
+            rates[i].high = (uint32_t)(rate >> 32);
+        }
+
+        rate_table->format = SCMI_CLOCK_RATE_FORMAT_LIST;
+        rate_table->rate_count = (uint32_t)info.range.rate_count;
+    } else {
+        rates = fwk_mm_alloc(
+            SCMI_CLOCK_NUM_OF_RATES_RANGE, sizeof(struct scmi_clock_rate));
+
+        rates[0].low = (uint32_t)info.range.min;
+        rates[0].high = (uint32_t)(info.range.min >> 32);
+        rates[1].low = (uint32_t)info.range.max;
+        rates[1].high = (uint32_t)(info.range.max >> 32);
+        rates[2].low = (uint32_t)info.range.step;
+        rates[2].high = (uint32_t)(info.range.step >> 32);
+
+        rate_table->format = SCMI_CLOCK_RATE_FORMAT_RANGE;
+        rate_table->rate_count = SCMI_CLOCK_NUM_OF_RATES_RANGE;
+    }
+
+    rate_table->rates = rates;
+    rate_table->is_built = true;
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_clock_get_rate_table(
+    fwk_id_t clock_dev_id,
+    const struct clock_rate_table **rate_table)
+{
+    int status;
+
+    /* Build the table now if it could not be built at start */
+    status = scmi_clock_build_rate_table(clock_dev_id);
+    if (status != FWK_SUCCESS) {
+        return status;
+    }
+
+    *rate_table =
+        &scmi_clock_ctx.rate_tables[fwk_id_get_element_idx(clock_dev_id)];
+
+    return FWK_SUCCESS;
+}
+
 /*
  * Clock Describe Rates
  */
@@ -1205,16 +1494,12 @@ static int scmi_clock_describe_rates_handler(fwk_id_t service_id,
 {
     int status, respond_status;
     const struct mod_scmi_clock_device *clock_device;
-    unsigned int i;
     size_t max_payload_size;
     uint32_t payload_size;
     uint32_t index;
     unsigned int rate_count;
     unsigned int remaining_rates;
-    uint64_t rate;
-    struct scmi_clock_rate scmi_rate;
-    struct scmi_clock_rate clock_range[3];
-    struct mod_clock_info info;
+    const struct clock_rate_table *rate_table;
     const struct scmi_clock_describe_rates_a2p *parameters;
     struct scmi_clock_describe_rates_p2a return_values = {
         .status = (int32_t)SCMI_GENERIC_ERROR
@@ -1252,16 +1537,15 @@ static int scmi_clock_describe_rates_handler(fwk_id_t service_id,
         goto exit;
     }
 
-    status = scmi_clock_ctx.clock_api->get_info(clock_device->element_id,
-                                                &info);
+    status = scmi_clock_get_rate_table(clock_device->element_id, &rate_table);
     if (status != FWK_SUCCESS) {
         goto exit;
     }
 
-    if (info.range.rate_type == MOD_CLOCK_RATE_TYPE_DISCRETE) {
+    if (rate_table->format == SCMI_CLOCK_RATE_FORMAT_LIST) {
         /* The clock has a discrete list of frequencies */
 
-        if (index >= info.range.rate_count) {
+        if (index >= rate_table->rate_count) {
             return_values.status = (int32_t)SCMI_OUT_OF_RANGE;
             goto exit;
         }
@@ -1280,7 +1564,7 @@ static int scmi_clock_describe_rates_handler(fwk_id_t service_id,
          */
         rate_count = (unsigned int)FWK_MIN(
             SCMI_CLOCK_RATES_MAX(max_payload_size),
-            info.range.rate_count - index);
+            rate_table->rate_count - index);
 
         /*
          * Because the agent gives a starting index into the clock's rate list
@@ -1288,68 +1572,37 @@ static int scmi_clock_describe_rates_handler(fwk_id_t service_id,
          * the clock supports minus the index, with the number of rates being
          * returned in this payload subtracted.
          */
-        remaining_rates =
-            (unsigned int)(info.range.rate_count - index) - rate_count;
-
-        /* Give the number of rates sent in the message payload */
-        return_values.num_rates_flags =
-            SCMI_CLOCK_DESCRIBE_RATES_NUM_RATES_FLAGS(
-                rate_count,
-                SCMI_CLOCK_RATE_FORMAT_LIST,
-                remaining_rates
-            );
-
-        /* Set each rate entry in the payload to the associated frequency */
-        for (i = 0; i < rate_count;
-             i++, payload_size += (uint32_t)sizeof(struct scmi_clock_rate)) {
-            status = scmi_clock_ctx.clock_api->get_rate_from_index(
-                clock_device->element_id,
-                index + i,
-                &rate);
-            if (status != FWK_SUCCESS) {
-                goto exit;
-            }
-
-            scmi_rate.low = (uint32_t)rate;
-            scmi_rate.high = (uint32_t)(rate >> 32);
-
-            status = scmi_clock_ctx.scmi_api->write_payload(service_id,
-                payload_size, &scmi_rate, sizeof(scmi_rate));
-            if (status != FWK_SUCCESS) {
-                goto exit;
-            }
-        }
+        remaining_rates = (rate_table->rate_count - index) - rate_count;
     } else {
         /* The clock has a linear stepping */
 
         /* Is the payload area large enough to return the complete triplet? */
-        if (SCMI_CLOCK_RATES_MAX(max_payload_size) < 3) {
+        if (SCMI_CLOCK_RATES_MAX(max_payload_size) <
+            SCMI_CLOCK_NUM_OF_RATES_RANGE) {
             status = FWK_E_SIZE;
             goto exit;
         }
 
-        return_values.num_rates_flags =
-            SCMI_CLOCK_DESCRIBE_RATES_NUM_RATES_FLAGS(
-                SCMI_CLOCK_NUM_OF_RATES_RANGE,
-                SCMI_CLOCK_RATE_FORMAT_RANGE,
-                /* No further rates are available */
-                0U);
-
-        /* Store the range data in the range entry in the payload */
-        clock_range[0].low = (uint32_t)info.range.min;
-        clock_range[0].high = (uint32_t)(info.range.min >> 32);
-        clock_range[1].low = (uint32_t)info.range.max;
-        clock_range[1].high = (uint32_t)(info.range.max >> 32);
-        clock_range[2].low = (uint32_t)info.range.step;
-        clock_range[2].high = (uint32_t)(info.range.step >> 32);
-
-        status = scmi_clock_ctx.scmi_api->write_payload(service_id,
-            payload_size, &clock_range, sizeof(clock_range));
-        if (status != FWK_SUCCESS) {
-            goto exit;
-        }
-        payload_size += (uint32_t)sizeof(clock_range);
+        index = 0;
+        rate_count = SCMI_CLOCK_NUM_OF_RATES_RANGE;
+        /* No further rates are available */
+        remaining_rates = 0;
+    }
+
+    /* Give the number of rates sent in the message payload */
+    return_values.num_rates_flags = SCMI_CLOCK_DESCRIBE_RATES_NUM_RATES_FLAGS(
+        rate_count, rate_table->format, remaining_rates);
+
+    /* Copy the rate entries into the payload at once */
+    status = scmi_clock_ctx.scmi_api->write_payload(
+        service_id,
+        payload_size,
+        &rate_table->rates[index],
+        rate_count * sizeof(struct scmi_clock_rate));
+    if (status != FWK_SUCCESS) {
+        goto exit;
     }
+    payload_size += (uint32_t)(rate_count * sizeof(struct scmi_clock_rate));
 
     return_values.status = (int32_t)SCMI_SUCCESS;
     status = scmi_clock_ctx.scmi_api->write_payload(service_id, 0,
@@ -1447,6 +1700,23 @@ static int scmi_clock_init(fwk_id_t module_id, unsigned int element_count,
         scmi_clock_ctx.clock_ops[i].service_id = FWK_ID_NONE;
     }
 
+    /* Allocate the queues of clock operations */
+    scmi_clock_ctx.max_queued_operations = config->max_queued_operations;
+    if (scmi_clock_ctx.max_queued_operations > 0) {
+        scmi_clock_ctx.clock_ops_queue = fwk_mm_calloc(
+            (unsigned int)clock_devices, sizeof(struct clock_ops_queue));
+
+        for (unsigned int i = 0; i < (unsigned int)clock_devices; i++) {
+            scmi_clock_ctx.clock_ops_queue[i].entries = fwk_mm_calloc(
+                scmi_clock_ctx.max_queued_operations,
+                sizeof(struct clock_queued_operation));
+        }
+    }
+
+    /* Allocate the table of rate tables, built at start */
+    scmi_clock_ctx.rate_tables = fwk_mm_calloc(
+        (unsigned int)clock_devices, sizeof(struct clock_rate_table));
+
     /* Initialize clock reference counter table */
     clock_ref_count_allocate();
     clock_ref_count_init();
@@ -1483,6 +1753,31 @@ static int scmi_clock_bind(fwk_id_t id, unsigned int round)
         FWK_ID_API(FWK_MODULE_IDX_CLOCK, 0), &scmi_clock_ctx.clock_api);
 }
 
+static int scmi_clock_start(fwk_id_t id)
+{
+    int status;
+    unsigned int agent_id, clock_idx;
+    const struct mod_scmi_clock_agent *agent;
+
+    /* Build the rate tables of the clocks exposed to the agents */
+    for (agent_id = 0; agent_id < scmi_clock_ctx.config->agent_count;
+         agent_id++) {
+        agent = &scmi_clock_ctx.agent_table[agent_id];
+
+        for (clock_idx = 0; clock_idx < agent->device_count; clock_idx++) {
+            status = scmi_clock_build_rate_table(
+                agent->device_table[clock_idx].element_id);
+            if (status != FWK_SUCCESS) {
+                /* The table is built on the first request instead */
+                FWK_LOG_DEBUG(
+                    "[SCMI-CLK] Rate table of clock %u deferred", clock_idx);
+            }
+        }
+    }
+
+    return FWK_SUCCESS;
+}
+
 static int scmi_clock_process_bind_request(fwk_id_t source_id,
     fwk_id_t target_id, fwk_id_t api_id, const void **api)
 {
@@ -1537,6 +1832,7 @@ static int process_request_event(const struct fwk_event *event)
         if (status != FWK_PENDING) {
             /* Request completed */
             get_rate_respond(service_id, &rate, status);
+            status = FWK_SUCCESS;
         }
         break;
 
@@ -1643,9 +1939,11 @@ static int process_response_event(const struct fwk_event *event)
 static int scmi_clock_process_event(const struct fwk_event *event,
                                     struct fwk_event *resp_event)
 {
-    if (fwk_id_get_module_idx(event->source_id) ==
-        fwk_id_get_module_idx(fwk_module_id_scmi)) {
-        /* Request events */
+    if ((fwk_id_get_module_idx(event->source_id) ==
+         fwk_id_get_module_idx(fwk_module_id_scmi)) ||
+        (fwk_id_get_module_idx(event->source_id) ==
+         fwk_id_get_module_idx(fwk_module_id_scmi_clock))) {
+        /* Request events, posted on reception or dequeued */
         return process_request_event(event);
     }
 
@@ -1665,6 +1963,7 @@ const struct fwk_module module_scmi_clock = {
     .type = FWK_MODULE_TYPE_PROTOCOL,
     .init = scmi_clock_init,
     .bind = scmi_clock_bind,
+    .start = scmi_clock_start,
     .process_bind_request = scmi_clock_process_bind_request,
     .process_event = scmi_clock_process_event,
 };
@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2022-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2022-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -120,6 +120,10 @@ void setUp(void)
         scmi_clock_ctx.clock_ops[i].service_id = FWK_ID_NONE;
     }
 
+    scmi_clock_ctx.max_queued_operations = 0;
+    scmi_clock_ctx.clock_ops_queue = NULL;
+    scmi_clock_ctx.rate_tables = NULL;
+
     scmi_clock_ctx.scmi_api = &from_protocol_api;
     #if defined(BUILD_HAS_MOD_RESOURCE_PERMS)
         scmi_clock_ctx.res_perms_api = &perm_api;
@@ -148,6 +152,10 @@ void setUp(void)
 
 void tearDown(void)
 {
+    mod_scmi_from_protocol_api_respond_Stub(NULL);
+#ifndef TEST_ON_TARGET
+    __fwk_put_event_Stub(NULL);
+#endif
 }
 
 int fwk_put_event_callback(struct fwk_event *event, int numCalls)
@@ -207,6 +215,430 @@ void test_function_set_rate(void)
     TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
 }
 
+void test_create_event_request_queued_while_busy(void)
+{
+    int status;
+    struct clock_queued_operation entries[1];
+    struct clock_ops_queue queue_table[CLOCK_DEV_IDX_COUNT] = { 0 };
+    struct clock_ops_queue *queue = &queue_table[CLOCK_DEV_IDX_FAKE0];
+    fwk_id_t clock_id =
+        FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_CLOCK, CLOCK_DEV_IDX_FAKE0);
+    fwk_id_t service_id =
+        FWK_ID_ELEMENT_INIT(FAKE_MODULE_IDX, FAKE_SCMI_AGENT_IDX_OSPM0);
+    struct event_set_rate_request_data data = {
+        .rate = { 0x00000001, 0x00000001 },
+        .round_mode = MOD_CLOCK_ROUND_MODE_NEAREST,
+    };
+
+    queue->entries = entries;
+    scmi_clock_ctx.max_queued_operations = FWK_ARRAY_SIZE(entries);
+    scmi_clock_ctx.clock_ops_queue = queue_table;
+    scmi_clock_ctx.clock_ops[CLOCK_DEV_IDX_FAKE0].service_id = service_id;
+
+    /* The clock device is busy, the request is queued */
+    fwk_id_get_element_idx_ExpectAnyArgsAndReturn(CLOCK_DEV_IDX_FAKE0);
+    fwk_id_is_equal_ExpectAnyArgsAndReturn(false);
+
+    status = create_event_request(
+        clock_id,
+        service_id,
+        SCMI_CLOCK_REQUEST_SET_RATE,
+        &data,
+        CLOCK_DEV_IDX_FAKE0);
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+    TEST_ASSERT_EQUAL(1, queue->count);
+    TEST_ASSERT_EQUAL(SCMI_CLOCK_REQUEST_SET_RATE, entries[0].op.request);
+    TEST_ASSERT_EQUAL(
+        0x00000001, entries[0].params.request_data.set_rate_data.rate[1]);
+
+    /* The queue is full, the request is rejected */
+    fwk_id_get_element_idx_ExpectAnyArgsAndReturn(CLOCK_DEV_IDX_FAKE0);
+    fwk_id_is_equal_ExpectAnyArgsAndReturn(false);
+
+    status = create_event_request(
+        clock_id,
+        service_id,
+        SCMI_CLOCK_REQUEST_SET_RATE,
+        &data,
+        CLOCK_DEV_IDX_FAKE0);
+    TEST_ASSERT_EQUAL(FWK_E_BUSY, status);
+    TEST_ASSERT_EQUAL(1, queue->count);
+}
+
+void test_create_event_request_get_state_busy_without_queue(void)
+{
+    int status;
+    fwk_id_t clock_id =
+        FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_CLOCK, CLOCK_DEV_IDX_FAKE0);
+    fwk_id_t service_id =
+        FWK_ID_ELEMENT_INIT(FAKE_MODULE_IDX, FAKE_SCMI_AGENT_IDX_OSPM0);
+
+    scmi_clock_ctx.clock_ops[CLOCK_DEV_IDX_FAKE0].service_id = service_id;
+
+    /* Without queues, a busy clock device rejects the request */
+    fwk_id_get_element_idx_ExpectAnyArgsAndReturn(CLOCK_DEV_IDX_FAKE0);
+    fwk_id_is_equal_ExpectAnyArgsAndReturn(false);
+
+    status = create_event_request(
+        clock_id,
+        service_id,
+        SCMI_CLOCK_REQUEST_GET_STATE,
+        NULL,
+        SCMI_CLOCK_OSPM0_IDX0);
+    TEST_ASSERT_EQUAL(FWK_E_BUSY, status);
+}
+
+static unsigned int respond_count;
+static fwk_id_t respond_service_id;
+static uint32_t respond_payload[8];
+
+static int respond_callback(
+    fwk_id_t service_id,
+    const void *payload,
+    size_t size,
+    int cmock_num_calls)
+{
+    TEST_ASSERT_TRUE(size <= sizeof(respond_payload));
+
+    respond_count++;
+    respond_service_id = service_id;
+    memcpy(respond_payload, payload, size);
+
+    return FWK_SUCCESS;
+}
+
+static unsigned int put_event_count;
+static struct fwk_event put_events[2];
+
+static int put_event_callback(struct fwk_event *event, int cmock_num_calls)
+{
+    TEST_ASSERT_TRUE(put_event_count < FWK_ARRAY_SIZE(put_events));
+
+    put_events[put_event_count++] = *event;
+
+    return FWK_SUCCESS;
+}
+
+static int fake_clock_get_rate_error(fwk_id_t clock_id, uint64_t *rate)
+{
+    return FWK_E_DEVICE;
+}
+
+static int fake_clock_set_rate(
+    fwk_id_t clock_id,
+    uint64_t rate,
+    enum mod_clock_round_mode round_mode)
+{
+    return FWK_SUCCESS;
+}
+
+static const struct mod_clock_api fake_clock_ops_api = {
+    .set_rate = fake_clock_set_rate,
+    .get_rate = fake_clock_get_rate_error,
+};
+
+static void setup_clock_ops_queue(
+    struct clock_ops_queue *queue_table,
+    struct clock_queued_operation *entries,
+    unsigned int entry_count)
+{
+    memset(queue_table, 0, CLOCK_DEV_IDX_COUNT * sizeof(queue_table[0]));
+    queue_table[CLOCK_DEV_IDX_FAKE0].entries = entries;
+    scmi_clock_ctx.max_queued_operations = (uint8_t)entry_count;
+    scmi_clock_ctx.clock_ops_queue = queue_table;
+
+    respond_count = 0;
+    put_event_count = 0;
+    mod_scmi_from_protocol_api_respond_Stub(respond_callback);
+    __fwk_put_event_Stub(put_event_callback);
+}
+
+void test_clock_ops_get_target_state(void)
+{
+    int status;
+    unsigned int agent_id = FAKE_SCMI_AGENT_IDX_OSPM0;
+    struct clock_queued_operation entries[2];
+    struct clock_ops_queue queue_table[CLOCK_DEV_IDX_COUNT];
+    struct clock_ops_queue *queue = &queue_table[CLOCK_DEV_IDX_FAKE0];
+    struct scmi_clock_attributes_p2a *return_values =
+        (struct scmi_clock_attributes_p2a *)respond_payload;
+    fwk_id_t clock_id =
+        FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_CLOCK, CLOCK_DEV_IDX_FAKE0);
+    fwk_id_t service_id =
+        FWK_ID_ELEMENT_INIT(FAKE_MODULE_IDX, FAKE_SCMI_AGENT_IDX_OSPM0);
+    fwk_id_t other_service_id =
+        FWK_ID_ELEMENT_INIT(FAKE_MODULE_IDX, FAKE_SCMI_AGENT_IDX_OSPM1);
+
+    setup_clock_ops_queue(queue_table, entries, FWK_ARRAY_SIZE(entries));
+
+    /* The agent is stopping the clock, another agent will then start it */
+    clock_ops_set_busy(
+        CLOCK_DEV_IDX_FAKE0,
+        service_id,
+        SCMI_CLOCK_OSPM0_IDX0,
+        MOD_CLOCK_STATE_STOPPED,
+        SCMI_CLOCK_REQUEST_SET_STATE);
+    entries[0].op = (struct clock_operations){
+        .service_id = other_service_id,
+        .state = MOD_CLOCK_STATE_RUNNING,
+        .scmi_clock_idx = SCMI_CLOCK_OSPM0_IDX0,
+        .request = SCMI_CLOCK_REQUEST_SET_STATE,
+    };
+    queue->count = 1;
+
+    fwk_id_get_element_idx_ExpectAnyArgsAndReturn(CLOCK_DEV_IDX_FAKE0);
+    fwk_id_is_equal_ExpectAnyArgsAndReturn(false);
+    mod_scmi_from_protocol_api_get_agent_id_ExpectAnyArgsAndReturn(FWK_SUCCESS);
+    mod_scmi_from_protocol_api_get_agent_id_ReturnThruPtr_agent_id(&agent_id);
+    fwk_id_get_element_idx_ExpectAnyArgsAndReturn(CLOCK_DEV_IDX_FAKE0);
+    fwk_id_is_equal_ExpectAnyArgsAndReturn(true);
+    fwk_id_is_equal_ExpectAnyArgsAndReturn(false);
+    fwk_module_get_element_name_ExpectAnyArgsAndReturn("FAKE0");
+
+    status = create_event_request(
+        clock_id,
+        service_id,
+        SCMI_CLOCK_REQUEST_GET_STATE,
+        NULL,
+        SCMI_CLOCK_OSPM0_IDX0);
+
+    /* The request of the other agent does not affect the state reported */
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+    TEST_ASSERT_EQUAL(1, respond_count);
+    TEST_ASSERT_EQUAL(service_id.value, respond_service_id.value);
+    TEST_ASSERT_EQUAL(SCMI_SUCCESS, return_values->status);
+    TEST_ASSERT_EQUAL(0, return_values->attributes);
+    TEST_ASSERT_EQUAL(0, put_event_count);
+
+    /* The latest queued request of the agent is reported */
+    entries[1].op = (struct clock_operations){
+        .service_id = service_id,
+        .state = MOD_CLOCK_STATE_RUNNING,
+        .scmi_clock_idx = SCMI_CLOCK_OSPM0_IDX0,
+        .request = SCMI_CLOCK_REQUEST_SET_STATE,
+    };
+    queue->count = 2;
+
+    fwk_id_get_element_idx_ExpectAnyArgsAndReturn(CLOCK_DEV_IDX_FAKE0);
+    fwk_id_is_equal_ExpectAnyArgsAndReturn(false);
+    mod_scmi_from_protocol_api_get_agent_id_ExpectAnyArgsAndReturn(FWK_SUCCESS);
+    mod_scmi_from_protocol_api_get_agent_id_ReturnThruPtr_agent_id(&agent_id);
+    fwk_id_get_element_idx_ExpectAnyArgsAndReturn(CLOCK_DEV_IDX_FAKE0);
+    fwk_id_is_equal_ExpectAnyArgsAndReturn(true);
+    fwk_id_is_equal_ExpectAnyArgsAndReturn(false);
+    fwk_id_is_equal_ExpectAnyArgsAndReturn(true);
+    fwk_module_get_element_name_ExpectAnyArgsAndReturn("FAKE0");
+
+    status = create_event_request(
+        clock_id,
+        service_id,
+        SCMI_CLOCK_REQUEST_GET_STATE,
+        NULL,
+        SCMI_CLOCK_OSPM0_IDX0);
+
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+    TEST_ASSERT_EQUAL(2, respond_count);
+    TEST_ASSERT_EQUAL(
+        SCMI_CLOCK_ATTRIBUTES_ENABLED_MASK, return_values->attributes);
+    TEST_ASSERT_EQUAL(2, queue->count);
+}
+
+void test_clock_ops_start_next_after_clock_response(void)
+{
+    int status;
+    unsigned int i;
+    struct clock_queued_operation entries[2];
+    struct clock_ops_queue queue_table[CLOCK_DEV_IDX_COUNT];
+    struct clock_ops_queue *queue = &queue_table[CLOCK_DEV_IDX_FAKE0];
+    struct scmi_clock_event_request_params *params;
+    struct mod_clock_resp_params *resp_params;
+    struct fwk_event resp_event;
+    fwk_id_t clock_id =
+        FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_CLOCK, CLOCK_DEV_IDX_FAKE0);
+    fwk_id_t service_ids[] = {
+        FWK_ID_ELEMENT_INIT(FAKE_MODULE_IDX, FAKE_SCMI_AGENT_IDX_OSPM0),
+        FWK_ID_ELEMENT_INIT(FAKE_MODULE_IDX, FAKE_SCMI_AGENT_IDX_OSPM1),
+    };
+    struct event_set_rate_request_data data[] = {
+        { .rate = { 100, 0 }, .round_mode = MOD_CLOCK_ROUND_MODE_NEAREST },
+        { .rate = { 200, 0 }, .round_mode = MOD_CLOCK_ROUND_MODE_NEAREST },
+    };
+    fwk_id_t busy_service_id =
+        FWK_ID_ELEMENT_INIT(FAKE_MODULE_IDX, FAKE_SCMI_AGENT_IDX_PSCI);
+
+    setup_clock_ops_queue(queue_table, entries, FWK_ARRAY_SIZE(entries));
+    scmi_clock_ctx.clock_api = &fake_clock_ops_api;
+
+    clock_ops_set_busy(
+        CLOCK_DEV_IDX_FAKE0,
+        busy_service_id,
+        SCMI_CLOCK_OSPM0_IDX0,
+        MOD_CLOCK_STATE_COUNT,
+        SCMI_CLOCK_REQUEST_GET_RATE);
+
+    /* Two agents set the rate while the clock device is busy */
+    for (i = 0; i < FWK_ARRAY_SIZE(data); i++) {
+        fwk_id_get_element_idx_ExpectAnyArgsAndReturn(CLOCK_DEV_IDX_FAKE0);
+        fwk_id_is_equal_ExpectAnyArgsAndReturn(false);
+
+        status = create_event_request(
+            clock_id,
+            service_ids[i],
+            SCMI_CLOCK_REQUEST_SET_RATE,
+            &data[i],
+            SCMI_CLOCK_OSPM0_IDX0);
+        TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+    }
+    TEST_ASSERT_EQUAL(2, queue->count);
+    TEST_ASSERT_EQUAL(0, put_event_count);
+
+    /* The clock HAL completes the operation in progress */
+    resp_event = (struct fwk_event){
+        .source_id = clock_id,
+        .id = FWK_ID_EVENT_INIT(
+            FWK_MODULE_IDX_CLOCK, MOD_CLOCK_EVENT_IDX_GET_RATE_REQUEST),
+    };
+    resp_params = (struct mod_clock_resp_params *)resp_event.params;
+    resp_params->status = FWK_SUCCESS;
+    resp_params->value.rate = 50;
+
+    fwk_id_get_element_idx_ExpectAnyArgsAndReturn(CLOCK_DEV_IDX_FAKE0);
+    fwk_id_get_event_idx_ExpectAnyArgsAndReturn(
+        MOD_CLOCK_EVENT_IDX_GET_RATE_REQUEST);
+
+    status = process_response_event(&resp_event);
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+    TEST_ASSERT_EQUAL(1, respond_count);
+    TEST_ASSERT_EQUAL(busy_service_id.value, respond_service_id.value);
+
+    /* The queued requests are started one at a time, in order */
+    for (i = 0; i < FWK_ARRAY_SIZE(data); i++) {
+        TEST_ASSERT_EQUAL(i + 1, put_event_count);
+        TEST_ASSERT_EQUAL(
+            mod_scmi_clock_event_id_set_rate.value, put_events[i].id.value);
+        params =
+            (struct scmi_clock_event_request_params *)put_events[i].params;
+        TEST_ASSERT_EQUAL(
+            data[i].rate[0], params->request_data.set_rate_data.rate[0]);
+        TEST_ASSERT_EQUAL(
+            service_ids[i].value,
+            scmi_clock_ctx.clock_ops[CLOCK_DEV_IDX_FAKE0].service_id.value);
+        TEST_ASSERT_EQUAL(FWK_ARRAY_SIZE(data) - i - 1, queue->count);
+
+        fwk_id_get_element_idx_ExpectAnyArgsAndReturn(CLOCK_DEV_IDX_FAKE0);
+        fwk_id_get_event_idx_ExpectAnyArgsAndReturn(
+            SCMI_CLOCK_EVENT_IDX_SET_RATE);
+
+        status = process_request_event(&put_events[i]);
+        TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+        TEST_ASSERT_EQUAL(i + 2, respond_count);
+        TEST_ASSERT_EQUAL(service_ids[i].value, respond_service_id.value);
+    }
+
+    /* The clock device is available once the queue is drained */
+    TEST_ASSERT_EQUAL(FWK_ARRAY_SIZE(data), put_event_count);
+    TEST_ASSERT_EQUAL(
+        FWK_ID_NONE.value,
+        scmi_clock_ctx.clock_ops[CLOCK_DEV_IDX_FAKE0].service_id.value);
+}
+
+void test_process_request_event_get_rate_error_releases_clock(void)
+{
+    int status;
+    struct clock_queued_operation entries[1];
+    struct clock_ops_queue queue_table[CLOCK_DEV_IDX_COUNT];
+    struct scmi_clock_event_request_params *params;
+    struct fwk_event event;
+    fwk_id_t service_id =
+        FWK_ID_ELEMENT_INIT(FAKE_MODULE_IDX, FAKE_SCMI_AGENT_IDX_OSPM0);
+
+    setup_clock_ops_queue(queue_table, entries, FWK_ARRAY_SIZE(entries));
+    scmi_clock_ctx.clock_api = &fake_clock_ops_api;
+
+    clock_ops_set_busy(
+        CLOCK_DEV_IDX_FAKE0,
+        service_id,
+        SCMI_CLOCK_OSPM0_IDX0,
+        MOD_CLOCK_STATE_COUNT,
+        SCMI_CLOCK_REQUEST_GET_RATE);
+
+    event = (struct fwk_event){
+        .target_id = fwk_module_id_scmi_clock,
+        .id = mod_scmi_clock_event_id_get_rate,
+    };
+    params = (struct scmi_clock_event_request_params *)event.params;
+    params->clock_dev_id =
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_CLOCK, CLOCK_DEV_IDX_FAKE0);
+
+    fwk_id_get_element_idx_ExpectAnyArgsAndReturn(CLOCK_DEV_IDX_FAKE0);
+    fwk_id_get_event_idx_ExpectAnyArgsAndReturn(SCMI_CLOCK_EVENT_IDX_GET_RATE);
+
+    status = process_request_event(&event);
+
+    /* The error is reported to the agent and the clock device released */
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+    TEST_ASSERT_EQUAL(1, respond_count);
+    TEST_ASSERT_EQUAL(service_id.value, respond_service_id.value);
+    TEST_ASSERT_EQUAL(SCMI_GENERIC_ERROR, (int32_t)respond_payload[0]);
+    TEST_ASSERT_EQUAL(
+        FWK_ID_NONE.value,
+        scmi_clock_ctx.clock_ops[CLOCK_DEV_IDX_FAKE0].service_id.value);
+}
+
+static int fake_clock_get_info(fwk_id_t clock_id, struct mod_clock_info *info)
+{
+    info->range.rate_type = MOD_CLOCK_RATE_TYPE_DISCRETE;
+    info->range.rate_count = 2;
+
+    return FWK_SUCCESS;
+}
+
+static int fake_clock_get_rate_from_index(
+    fwk_id_t clock_id,
+    unsigned int rate_index,
+    uint64_t *rate)
+{
+    *rate = (UINT64_C(0x100000000) * (rate_index + 1)) + rate_index;
+
+    return FWK_SUCCESS;
+}
+
+static const struct mod_clock_api fake_clock_api = {
+    .get_info = fake_clock_get_info,
+    .get_rate_from_index = fake_clock_get_rate_from_index,
+};
+
+void test_scmi_clock_build_rate_table_discrete(void)
+{
+    int status;
+    struct scmi_clock_rate rates[2];
+    struct clock_rate_table rate_tables[CLOCK_DEV_IDX_COUNT] = { 0 };
+    struct clock_rate_table *rate_table = &rate_tables[CLOCK_DEV_IDX_FAKE1];
+    fwk_id_t clock_id =
+        FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_CLOCK, CLOCK_DEV_IDX_FAKE1);
+
+    scmi_clock_ctx.clock_api = &fake_clock_api;
+    scmi_clock_ctx.rate_tables = rate_tables;
+
+    fwk_id_get_element_idx_ExpectAnyArgsAndReturn(CLOCK_DEV_IDX_FAKE1);
+    fwk_mm_alloc_ExpectAndReturn(2, sizeof(struct scmi_clock_rate), rates);
+
+    status = scmi_clock_build_rate_table(clock_id);
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+    TEST_ASSERT_TRUE(rate_table->is_built);
+    TEST_ASSERT_EQUAL(SCMI_CLOCK_RATE_FORMAT_LIST, rate_table->format);
+    TEST_ASSERT_EQUAL(2, rate_table->rate_count);
+    TEST_ASSERT_EQUAL_PTR(rates, rate_table->rates);
+    TEST_ASSERT_EQUAL(1, rates[1].low);
+    TEST_ASSERT_EQUAL(2, rates[1].high);
+
+    /* The table is only built once */
+    fwk_id_get_element_idx_ExpectAnyArgsAndReturn(CLOCK_DEV_IDX_FAKE1);
+
+    status = scmi_clock_build_rate_table(clock_id);
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+}
+
 void test_set_rate_with_invalid_message_id_expect_SCMI_NOT_FOUND(void) {
     int status;
     int32_t return_value = SCMI_NOT_FOUND;
@@ -693,8 +1125,20 @@ int scmi_test_main(void)
     UNITY_BEGIN();
     #if defined(BUILD_HAS_MOD_RESOURCE_PERMS)
         RUN_TEST(test_function_set_rate);
+        RUN_TEST(test_create_event_request_queued_while_busy);
+        RUN_TEST(test_create_event_request_get_state_busy_without_queue);
+        RUN_TEST(test_clock_ops_get_target_state);
+        RUN_TEST(test_clock_ops_start_next_after_clock_response);
+        RUN_TEST(test_process_request_event_get_rate_error_releases_clock);
+        RUN_TEST(test_scmi_clock_build_rate_table_discrete);
     #else
         RUN_TEST(test_function_set_rate);
+        RUN_TEST(test_create_event_request_queued_while_busy);
+        RUN_TEST(test_create_event_request_get_state_busy_without_queue);
+        RUN_TEST(test_clock_ops_get_target_state);
+        RUN_TEST(test_clock_ops_start_next_after_clock_response);
+        RUN_TEST(test_process_request_event_get_rate_error_releases_clock);
+        RUN_TEST(test_scmi_clock_build_rate_table_discrete);
         RUN_TEST(test_set_rate_with_invalid_message_id_expect_SCMI_NOT_FOUND);
         RUN_TEST(
             test_set_rate_with_invalid_payload_size_expect_SCMI_PROTOCOL_ERROR);
@@ -0,0 +1,62 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2024, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *      SCMI latency statistics vendor protocol support.
+ */
+
+#ifndef INTERNAL_SCMI_LATENCY_STATS_H
+#define INTERNAL_SCMI_LATENCY_STATS_H
+
+#include <mod_scmi.h>
+
+#include <stdint.h>
+
+#define SCMI_PROTOCOL_VERSION_LATENCY_STATS UINT32_C(0x10000)
+
+/*
+ * PROTOCOL_ATTRIBUTES
+ */
+#define SCMI_LATENCY_STATS_PROTOCOL_ATTRIBUTES_MESSAGE_COUNT_POS  0U
+#define SCMI_LATENCY_STATS_PROTOCOL_ATTRIBUTES_BUCKET_COUNT_POS   8U
+
+#define SCMI_LATENCY_STATS_PROTOCOL_ATTRIBUTES_MESSAGE_COUNT_MASK 0xFFU
+#define SCMI_LATENCY_STATS_PROTOCOL_ATTRIBUTES_BUCKET_COUNT_MASK  0xFF00U
+
+#define SCMI_LATENCY_STATS_PROTOCOL_ATTRIBUTES(MESSAGE_COUNT, BUCKET_COUNT) \
+    ((((MESSAGE_COUNT) \
+       << SCMI_LATENCY_STATS_PROTOCOL_ATTRIBUTES_MESSAGE_COUNT_POS) & \
+      SCMI_LATENCY_STATS_PROTOCOL_ATTRIBUTES_MESSAGE_COUNT_MASK) | \
+     (((BUCKET_COUNT) \
+       << SCMI_LATENCY_STATS_PROTOCOL_ATTRIBUTES_BUCKET_COUNT_POS) & \
+      SCMI_LATENCY_STATS_PROTOCOL_ATTRIBUTES_BUCKET_COUNT_MASK))
+
+/*
+ * LATENCY_STATS_GET
+ */
+struct scmi_latency_stats_get_a2p {
+    uint32_t protocol_id;
+    uint32_t message_id;
+};
+
+struct scmi_latency_stats_get_p2a {
+    int32_t status;
+    uint32_t count;
+    uint32_t min_ns;
+    uint32_t avg_ns;
+    uint32_t max_ns;
+    uint32_t histogram[MOD_SCMI_LATENCY_STATS_BUCKET_COUNT];
+    uint32_t dropped_count;
+};
+
+/*
+ * LATENCY_STATS_RESET
+ */
+struct scmi_latency_stats_reset_p2a {
+    int32_t status;
+};
+
+#endif /* INTERNAL_SCMI_LATENCY_STATS_H */
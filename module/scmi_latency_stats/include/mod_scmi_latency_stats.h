@@ -0,0 +1,54 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2024, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *      SCMI latency statistics vendor protocol support.
+ */
+
+#ifndef MOD_SCMI_LATENCY_STATS_H
+#define MOD_SCMI_LATENCY_STATS_H
+
+#include <stdint.h>
+
+/*!
+ * \ingroup GroupModules Modules
+ * \defgroup GroupSCMI_LATENCY_STATS SCMI Latency Statistics Protocol
+ *
+ * \details Vendor protocol giving the agents access to the message handling
+ *      latency statistics collected by the SCMI module.
+ *
+ * \{
+ */
+
+/*!
+ * \brief SCMI latency statistics protocol message IDs.
+ */
+enum scmi_latency_stats_command_id {
+    MOD_SCMI_LATENCY_STATS_GET = 0x003,
+    MOD_SCMI_LATENCY_STATS_RESET = 0x004,
+    MOD_SCMI_LATENCY_STATS_COMMAND_COUNT,
+};
+
+/*!
+ * \brief SCMI latency statistics protocol configuration data.
+ */
+struct mod_scmi_latency_stats_config {
+    /*!
+     * \brief SCMI protocol identifier used to expose the statistics.
+     *
+     * \details The identifier must be within the range reserved for the
+     *      platform-specific protocols, see
+     *      ::MOD_SCMI_PLATFORM_PROTOCOL_ID_MIN and
+     *      ::MOD_SCMI_PLATFORM_PROTOCOL_ID_MAX.
+     */
+    uint8_t scmi_protocol_id;
+};
+
+/*!
+ * \}
+ */
+
+#endif /* MOD_SCMI_LATENCY_STATS_H */
@@ -0,0 +1,402 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2024, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     SCMI latency statistics vendor protocol support.
+ */
+
+#include <internal/scmi_latency_stats.h>
+
+#include <mod_scmi.h>
+#include <mod_scmi_latency_stats.h>
+
+#include <fwk_assert.h>
+#include <fwk_id.h>
+#include <fwk_log.h>
+#include <fwk_macros.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_status.h>
+
+#ifdef BUILD_HAS_MOD_RESOURCE_PERMS
+#    include <mod_resource_perms.h>
+#endif
+
+#include <stdint.h>
+
+struct scmi_latency_stats_ctx {
+    /* SCMI latency statistics module configuration */
+    const struct mod_scmi_latency_stats_config *config;
+
+    /* SCMI module API */
+    const struct mod_scmi_from_protocol_api *scmi_api;
+
+    /* SCMI module latency statistics API */
+    const struct mod_scmi_latency_stats_api *stats_api;
+
+#ifdef BUILD_HAS_MOD_RESOURCE_PERMS
+    /* SCMI Resource Permissions API */
+    const struct mod_res_permissions_api *res_perms_api;
+#endif
+};
+
+static int scmi_latency_stats_protocol_version_handler(
+    fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_latency_stats_protocol_attributes_handler(
+    fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_latency_stats_protocol_message_attributes_handler(
+    fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_latency_stats_get_handler(
+    fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_latency_stats_reset_handler(
+    fwk_id_t service_id,
+    const uint32_t *payload);
+
+/*
+ * Internal variables
+ */
+static struct scmi_latency_stats_ctx scmi_latency_stats_ctx;
+
+static int (*const handler_table[MOD_SCMI_LATENCY_STATS_COMMAND_COUNT])(
+    fwk_id_t,
+    const uint32_t *) = {
+    [MOD_SCMI_PROTOCOL_VERSION] = scmi_latency_stats_protocol_version_handler,
+    [MOD_SCMI_PROTOCOL_ATTRIBUTES] =
+        scmi_latency_stats_protocol_attributes_handler,
+    [MOD_SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] =
+        scmi_latency_stats_protocol_message_attributes_handler,
+    [MOD_SCMI_LATENCY_STATS_GET] = scmi_latency_stats_get_handler,
+    [MOD_SCMI_LATENCY_STATS_RESET] = scmi_latency_stats_reset_handler,
+};
+
+static const unsigned int
+    payload_size_table[MOD_SCMI_LATENCY_STATS_COMMAND_COUNT] = {
+        [MOD_SCMI_PROTOCOL_VERSION] = 0,
+        [MOD_SCMI_PROTOCOL_ATTRIBUTES] = 0,
+        [MOD_SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] =
+            (unsigned int)sizeof(struct scmi_protocol_message_attributes_a2p),
+        [MOD_SCMI_LATENCY_STATS_GET] =
+            (unsigned int)sizeof(struct scmi_latency_stats_get_a2p),
+        [MOD_SCMI_LATENCY_STATS_RESET] = 0,
+    };
+
+/*
+ * Latency statistics protocol implementation
+ */
+
+/*
+ * PROTOCOL_VERSION
+ */
+static int scmi_latency_stats_protocol_version_handler(
+    fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    struct scmi_protocol_version_p2a return_values = {
+        .status = (int32_t)SCMI_SUCCESS,
+        .version = SCMI_PROTOCOL_VERSION_LATENCY_STATS,
+    };
+
+    return scmi_latency_stats_ctx.scmi_api->respond(
+        service_id, &return_values, sizeof(return_values));
+}
+
+/*
+ * PROTOCOL_ATTRIBUTES
+ */
+static int scmi_latency_stats_protocol_attributes_handler(
+    fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    struct scmi_protocol_attributes_p2a return_values = {
+        .status = (int32_t)SCMI_SUCCESS,
+        .attributes = SCMI_LATENCY_STATS_PROTOCOL_ATTRIBUTES(
+            MOD_SCMI_LATENCY_STATS_MESSAGE_ID_COUNT,
+            MOD_SCMI_LATENCY_STATS_BUCKET_COUNT),
+    };
+
+    return scmi_latency_stats_ctx.scmi_api->respond(
+        service_id, &return_values, sizeof(return_values));
+}
+
+/*
+ * PROTOCOL_MESSAGE_ATTRIBUTES
+ */
+static int scmi_latency_stats_protocol_message_attributes_handler(
+    fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    const struct scmi_protocol_message_attributes_a2p *parameters;
+    struct scmi_protocol_message_attributes_p2a return_values = {
+        .status = (int32_t)SCMI_NOT_FOUND,
+    };
+
+    parameters = (const struct scmi_protocol_message_attributes_a2p *)payload;
+
+    if ((parameters->message_id < FWK_ARRAY_SIZE(handler_table)) &&
+        (handler_table[parameters->message_id] != NULL)) {
+        return_values.status = (int32_t)SCMI_SUCCESS;
+    }
+
+    return scmi_latency_stats_ctx.scmi_api->respond(
+        service_id,
+        &return_values,
+        (return_values.status == SCMI_SUCCESS) ? sizeof(return_values) :
+                                                 sizeof(return_values.status));
+}
+
+/*
+ * LATENCY_STATS_GET
+ */
+static int scmi_latency_stats_get_handler(
+    fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    int status;
+    const struct scmi_latency_stats_get_a2p *parameters;
+    struct scmi_latency_stats_get_p2a return_values = {
+        .status = (int32_t)SCMI_GENERIC_ERROR,
+    };
+    struct mod_scmi_latency_stats stats;
+    size_t max_payload_size;
+    unsigned int bucket;
+
+    parameters = (const struct scmi_latency_stats_get_a2p *)payload;
+
+    status = scmi_latency_stats_ctx.scmi_api->get_max_payload_size(
+        service_id, &max_payload_size);
+    if ((status != FWK_SUCCESS) ||
+        (max_payload_size < sizeof(return_values))) {
+        goto exit;
+    }
+
+    if ((parameters->protocol_id > MOD_SCMI_PROTOCOL_ID_MAX) ||
+        (parameters->message_id >= MOD_SCMI_LATENCY_STATS_MESSAGE_ID_COUNT)) {
+        return_values.status = (int32_t)SCMI_INVALID_PARAMETERS;
+        goto exit;
+    }
+
+    status = scmi_latency_stats_ctx.stats_api->get_stats(
+        (uint8_t)parameters->protocol_id,
+        (uint8_t)parameters->message_id,
+        &stats);
+    if (status == FWK_E_RANGE) {
+        return_values.status = (int32_t)SCMI_NOT_FOUND;
+        goto exit;
+    } else if (status != FWK_SUCCESS) {
+        goto exit;
+    }
+
+    return_values.status = (int32_t)SCMI_SUCCESS;
+    return_values.count = stats.count;
+    return_values.min_ns = stats.min_ns;
+    return_values.max_ns = stats.max_ns;
+    return_values.avg_ns =
+        (stats.count == 0) ? 0 : (uint32_t)(stats.total_ns / stats.count);
+
+    for (bucket = 0; bucket < MOD_SCMI_LATENCY_STATS_BUCKET_COUNT; bucket++) {
+        return_values.histogram[bucket] = stats.histogram[bucket];
+    }
+    return_values.dropped_count = stats.dropped_count;
+
+exit:
+    return scmi_latency_stats_ctx.scmi_api->respond(
+        service_id,
+        &return_values,
+        (return_values.status == SCMI_SUCCESS) ? sizeof(return_values) :
+                                                 sizeof(return_values.status));
+}
+
+/*
+ * LATENCY_STATS_RESET
+ */
+static int scmi_latency_stats_reset_handler(
+    fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    struct scmi_latency_stats_reset_p2a return_values = {
+        .status = (int32_t)SCMI_GENERIC_ERROR,
+    };
+
+    if (scmi_latency_stats_ctx.stats_api->reset_stats() == FWK_SUCCESS) {
+        return_values.status = (int32_t)SCMI_SUCCESS;
+    }
+
+    return scmi_latency_stats_ctx.scmi_api->respond(
+        service_id, &return_values, sizeof(return_values));
+}
+
+#ifdef BUILD_HAS_MOD_RESOURCE_PERMS
+/*
+ * SCMI Resource Permissions handler
+ */
+static int scmi_latency_stats_permissions_handler(
+    fwk_id_t service_id,
+    unsigned int message_id)
+{
+    enum mod_res_perms_permissions perms;
+    unsigned int agent_id;
+    int status;
+
+    status =
+        scmi_latency_stats_ctx.scmi_api->get_agent_id(service_id, &agent_id);
+    if (status != FWK_SUCCESS) {
+        return FWK_E_ACCESS;
+    }
+
+    if (message_id < 3) {
+        return FWK_SUCCESS;
+    }
+
+    perms =
+        scmi_latency_stats_ctx.res_perms_api->agent_has_message_permission(
+            agent_id,
+            scmi_latency_stats_ctx.config->scmi_protocol_id,
+            message_id);
+
+    if (perms == MOD_RES_PERMS_ACCESS_ALLOWED) {
+        return FWK_SUCCESS;
+    } else {
+        return FWK_E_ACCESS;
+    }
+}
+#endif
+
+/*
+ * SCMI module -> SCMI latency statistics module interface
+ */
+static int scmi_latency_stats_get_scmi_protocol_id(
+    fwk_id_t protocol_id,
+    uint8_t *scmi_protocol_id)
+{
+    *scmi_protocol_id = scmi_latency_stats_ctx.config->scmi_protocol_id;
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_latency_stats_message_handler(
+    fwk_id_t protocol_id,
+    fwk_id_t service_id,
+    const uint32_t *payload,
+    size_t payload_size,
+    unsigned int message_id)
+{
+    int32_t return_value;
+
+    static_assert(
+        FWK_ARRAY_SIZE(handler_table) == FWK_ARRAY_SIZE(payload_size_table),
+        "[SCMI] Latency statistics protocol table sizes not consistent");
+    fwk_assert(payload != NULL);
+
+    if (message_id >= FWK_ARRAY_SIZE(handler_table)) {
+        return_value = (int32_t)SCMI_NOT_FOUND;
+        goto error;
+    }
+
+    if (payload_size != payload_size_table[message_id]) {
+        return_value = (int32_t)SCMI_PROTOCOL_ERROR;
+        goto error;
+    }
+
+#ifdef BUILD_HAS_MOD_RESOURCE_PERMS
+    if (scmi_latency_stats_permissions_handler(service_id, message_id) !=
+        FWK_SUCCESS) {
+        return_value = (int32_t)SCMI_DENIED;
+        goto error;
+    }
+#endif
+
+    return handler_table[message_id](service_id, payload);
+
+error:
+    return scmi_latency_stats_ctx.scmi_api->respond(
+        service_id, &return_value, sizeof(return_value));
+}
+
+static struct mod_scmi_to_protocol_api
+    scmi_latency_stats_mod_scmi_to_protocol_api = {
+        .get_scmi_protocol_id = scmi_latency_stats_get_scmi_protocol_id,
+        .message_handler = scmi_latency_stats_message_handler,
+    };
+
+/*
+ * Framework handlers
+ */
+static int scmi_latency_stats_init(
+    fwk_id_t module_id,
+    unsigned int element_count,
+    const void *data)
+{
+    const struct mod_scmi_latency_stats_config *config = data;
+
+    if ((config == NULL) ||
+        (config->scmi_protocol_id < MOD_SCMI_PLATFORM_PROTOCOL_ID_MIN)) {
+        return FWK_E_PARAM;
+    }
+
+    scmi_latency_stats_ctx.config = config;
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_latency_stats_bind(fwk_id_t id, unsigned int round)
+{
+    int status;
+
+    if (round == 1) {
+        return FWK_SUCCESS;
+    }
+
+    status = fwk_module_bind(
+        FWK_ID_MODULE(FWK_MODULE_IDX_SCMI),
+        FWK_ID_API(FWK_MODULE_IDX_SCMI, MOD_SCMI_API_IDX_PROTOCOL),
+        &scmi_latency_stats_ctx.scmi_api);
+    if (status != FWK_SUCCESS) {
+        return status;
+    }
+
+#ifdef BUILD_HAS_MOD_RESOURCE_PERMS
+    status = fwk_module_bind(
+        FWK_ID_MODULE(FWK_MODULE_IDX_RESOURCE_PERMS),
+        FWK_ID_API(FWK_MODULE_IDX_RESOURCE_PERMS, MOD_RES_PERM_RESOURCE_PERMS),
+        &scmi_latency_stats_ctx.res_perms_api);
+    if (status != FWK_SUCCESS) {
+        return status;
+    }
+#endif
+
+    return fwk_module_bind(
+        FWK_ID_MODULE(FWK_MODULE_IDX_SCMI),
+        FWK_ID_API(FWK_MODULE_IDX_SCMI, MOD_SCMI_API_IDX_LATENCY_STATS),
+        &scmi_latency_stats_ctx.stats_api);
+}
+
+static int scmi_latency_stats_process_bind_request(
+    fwk_id_t source_id,
+    fwk_id_t target_id,
+    fwk_id_t api_id,
+    const void **api)
+{
+    if (!fwk_id_is_equal(source_id, FWK_ID_MODULE(FWK_MODULE_IDX_SCMI))) {
+        return FWK_E_ACCESS;
+    }
+
+    *api = &scmi_latency_stats_mod_scmi_to_protocol_api;
+
+    return FWK_SUCCESS;
+}
+
+/* SCMI Latency Statistics Protocol Definition */
+const struct fwk_module module_scmi_latency_stats = {
+    .api_count = 1,
+    .type = FWK_MODULE_TYPE_PROTOCOL,
+    .init = scmi_latency_stats_init,
+    .bind = scmi_latency_stats_bind,
+    .process_bind_request = scmi_latency_stats_process_bind_request,
+};
@@ -0,0 +1,281 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2024, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "scp_unity.h"
+#include "unity.h"
+
+#include <Mockfwk_id.h>
+#include <Mockfwk_module.h>
+
+#include <mod_scmi.h>
+
+#include <fwk_macros.h>
+
+#include UNIT_TEST_SRC
+
+#define FAKE_PROTOCOL_ID       0x80
+#define FAKE_MAX_PAYLOAD_SIZE  128
+
+static uint32_t respond_payload[FAKE_MAX_PAYLOAD_SIZE / sizeof(uint32_t)];
+static size_t respond_size;
+static unsigned int reset_count;
+
+static struct mod_scmi_latency_stats fake_stats;
+static int fake_get_stats_status;
+
+static const struct mod_scmi_latency_stats_config fake_config = {
+    .scmi_protocol_id = FAKE_PROTOCOL_ID,
+};
+
+static int fake_respond(fwk_id_t service_id, const void *payload, size_t size)
+{
+    TEST_ASSERT_TRUE(size <= sizeof(respond_payload));
+
+    memcpy(respond_payload, payload, size);
+    respond_size = size;
+
+    return FWK_SUCCESS;
+}
+
+static int fake_get_max_payload_size(fwk_id_t service_id, size_t *size)
+{
+    *size = FAKE_MAX_PAYLOAD_SIZE;
+
+    return FWK_SUCCESS;
+}
+
+static int fake_get_stats(
+    uint8_t scmi_protocol_id,
+    uint8_t scmi_message_id,
+    struct mod_scmi_latency_stats *stats)
+{
+    *stats = fake_stats;
+
+    return fake_get_stats_status;
+}
+
+static int fake_reset_stats(void)
+{
+    reset_count++;
+
+    return FWK_SUCCESS;
+}
+
+static const struct mod_scmi_from_protocol_api fake_scmi_api = {
+    .get_max_payload_size = fake_get_max_payload_size,
+    .respond = fake_respond,
+};
+
+static const struct mod_scmi_latency_stats_api fake_stats_api = {
+    .get_stats = fake_get_stats,
+    .reset_stats = fake_reset_stats,
+};
+
+void setUp(void)
+{
+    memset(respond_payload, 0, sizeof(respond_payload));
+    respond_size = 0;
+    reset_count = 0;
+
+    memset(&fake_stats, 0, sizeof(fake_stats));
+    fake_get_stats_status = FWK_SUCCESS;
+
+    scmi_latency_stats_ctx.config = &fake_config;
+    scmi_latency_stats_ctx.scmi_api = &fake_scmi_api;
+    scmi_latency_stats_ctx.stats_api = &fake_stats_api;
+}
+
+void tearDown(void)
+{
+}
+
+static int send_message(
+    unsigned int message_id,
+    const void *payload,
+    size_t payload_size)
+{
+    static const uint32_t empty_payload;
+
+    return scmi_latency_stats_message_handler(
+        fwk_module_id_scmi_latency_stats,
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_SCMI, 0),
+        (payload == NULL) ? &empty_payload : payload,
+        payload_size,
+        message_id);
+}
+
+void test_protocol_version(void)
+{
+    struct scmi_protocol_version_p2a *return_values =
+        (struct scmi_protocol_version_p2a *)respond_payload;
+
+    send_message(MOD_SCMI_PROTOCOL_VERSION, NULL, 0);
+
+    TEST_ASSERT_EQUAL(sizeof(*return_values), respond_size);
+    TEST_ASSERT_EQUAL(SCMI_SUCCESS, return_values->status);
+    TEST_ASSERT_EQUAL(
+        SCMI_PROTOCOL_VERSION_LATENCY_STATS, return_values->version);
+}
+
+void test_protocol_attributes(void)
+{
+    struct scmi_protocol_attributes_p2a *return_values =
+        (struct scmi_protocol_attributes_p2a *)respond_payload;
+
+    send_message(MOD_SCMI_PROTOCOL_ATTRIBUTES, NULL, 0);
+
+    TEST_ASSERT_EQUAL(SCMI_SUCCESS, return_values->status);
+    TEST_ASSERT_EQUAL(
+        SCMI_LATENCY_STATS_PROTOCOL_ATTRIBUTES(
+            MOD_SCMI_LATENCY_STATS_MESSAGE_ID_COUNT,
+            MOD_SCMI_LATENCY_STATS_BUCKET_COUNT),
+        return_values->attributes);
+}
+
+void test_protocol_message_attributes(void)
+{
+    struct scmi_protocol_message_attributes_a2p parameters = {
+        .message_id = MOD_SCMI_LATENCY_STATS_RESET,
+    };
+    struct scmi_protocol_message_attributes_p2a *return_values =
+        (struct scmi_protocol_message_attributes_p2a *)respond_payload;
+
+    send_message(
+        MOD_SCMI_PROTOCOL_MESSAGE_ATTRIBUTES, &parameters, sizeof(parameters));
+    TEST_ASSERT_EQUAL(SCMI_SUCCESS, return_values->status);
+
+    parameters.message_id = MOD_SCMI_LATENCY_STATS_COMMAND_COUNT;
+    send_message(
+        MOD_SCMI_PROTOCOL_MESSAGE_ATTRIBUTES, &parameters, sizeof(parameters));
+    TEST_ASSERT_EQUAL(SCMI_NOT_FOUND, return_values->status);
+    TEST_ASSERT_EQUAL(sizeof(int32_t), respond_size);
+}
+
+void test_latency_stats_get(void)
+{
+    struct scmi_latency_stats_get_a2p parameters = {
+        .protocol_id = MOD_SCMI_PROTOCOL_ID_PERF,
+        .message_id = 0x7,
+    };
+    struct scmi_latency_stats_get_p2a *return_values =
+        (struct scmi_latency_stats_get_p2a *)respond_payload;
+
+    fake_stats.count = 4;
+    fake_stats.min_ns = 1000;
+    fake_stats.max_ns = 9000;
+    fake_stats.total_ns = 16000;
+    fake_stats.histogram[1] = 1;
+    fake_stats.histogram[4] = 3;
+    fake_stats.dropped_count = 2;
+
+    send_message(MOD_SCMI_LATENCY_STATS_GET, &parameters, sizeof(parameters));
+
+    TEST_ASSERT_EQUAL(sizeof(*return_values), respond_size);
+    TEST_ASSERT_EQUAL(SCMI_SUCCESS, return_values->status);
+    TEST_ASSERT_EQUAL(4, return_values->count);
+    TEST_ASSERT_EQUAL(1000, return_values->min_ns);
+    TEST_ASSERT_EQUAL(4000, return_values->avg_ns);
+    TEST_ASSERT_EQUAL(9000, return_values->max_ns);
+    TEST_ASSERT_EQUAL(1, return_values->histogram[1]);
+    TEST_ASSERT_EQUAL(3, return_values->histogram[4]);
+    TEST_ASSERT_EQUAL(2, return_values->dropped_count);
+}
+
+void test_latency_stats_get_no_sample(void)
+{
+    struct scmi_latency_stats_get_a2p parameters = {
+        .protocol_id = MOD_SCMI_PROTOCOL_ID_PERF,
+        .message_id = 0x7,
+    };
+    struct scmi_latency_stats_get_p2a *return_values =
+        (struct scmi_latency_stats_get_p2a *)respond_payload;
+
+    send_message(MOD_SCMI_LATENCY_STATS_GET, &parameters, sizeof(parameters));
+
+    TEST_ASSERT_EQUAL(SCMI_SUCCESS, return_values->status);
+    TEST_ASSERT_EQUAL(0, return_values->count);
+    TEST_ASSERT_EQUAL(0, return_values->avg_ns);
+}
+
+void test_latency_stats_get_invalid_message_id(void)
+{
+    struct scmi_latency_stats_get_a2p parameters = {
+        .protocol_id = MOD_SCMI_PROTOCOL_ID_PERF,
+        .message_id = MOD_SCMI_LATENCY_STATS_MESSAGE_ID_COUNT,
+    };
+
+    send_message(MOD_SCMI_LATENCY_STATS_GET, &parameters, sizeof(parameters));
+
+    TEST_ASSERT_EQUAL(SCMI_INVALID_PARAMETERS, (int32_t)respond_payload[0]);
+    TEST_ASSERT_EQUAL(sizeof(int32_t), respond_size);
+}
+
+void test_latency_stats_get_protocol_not_found(void)
+{
+    struct scmi_latency_stats_get_a2p parameters = {
+        .protocol_id = MOD_SCMI_PROTOCOL_ID_SENSOR,
+        .message_id = 0x6,
+    };
+
+    fake_get_stats_status = FWK_E_RANGE;
+
+    send_message(MOD_SCMI_LATENCY_STATS_GET, &parameters, sizeof(parameters));
+
+    TEST_ASSERT_EQUAL(SCMI_NOT_FOUND, (int32_t)respond_payload[0]);
+}
+
+void test_latency_stats_reset(void)
+{
+    send_message(MOD_SCMI_LATENCY_STATS_RESET, NULL, 0);
+
+    TEST_ASSERT_EQUAL(1, reset_count);
+    TEST_ASSERT_EQUAL(SCMI_SUCCESS, (int32_t)respond_payload[0]);
+}
+
+void test_message_handler_invalid_payload_size(void)
+{
+    struct scmi_latency_stats_get_a2p parameters = { 0 };
+
+    send_message(
+        MOD_SCMI_LATENCY_STATS_GET, &parameters, sizeof(parameters) - 1);
+
+    TEST_ASSERT_EQUAL(SCMI_PROTOCOL_ERROR, (int32_t)respond_payload[0]);
+}
+
+void test_message_handler_unknown_message(void)
+{
+    send_message(MOD_SCMI_LATENCY_STATS_COMMAND_COUNT, NULL, 0);
+
+    TEST_ASSERT_EQUAL(SCMI_NOT_FOUND, (int32_t)respond_payload[0]);
+}
+
+int scmi_latency_stats_test_main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_protocol_version);
+    RUN_TEST(test_protocol_attributes);
+    RUN_TEST(test_protocol_message_attributes);
+
+    RUN_TEST(test_latency_stats_get);
+    RUN_TEST(test_latency_stats_get_no_sample);
+    RUN_TEST(test_latency_stats_get_invalid_message_id);
+    RUN_TEST(test_latency_stats_get_protocol_not_found);
+    RUN_TEST(test_latency_stats_reset);
+
+    RUN_TEST(test_message_handler_invalid_payload_size);
+    RUN_TEST(test_message_handler_unknown_message);
+
+    return UNITY_END();
+}
+
+#if !defined(TEST_ON_TARGET)
+int main(void)
+{
+    return scmi_latency_stats_test_main();
+}
+#endif
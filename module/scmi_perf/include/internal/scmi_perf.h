@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2015-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -63,6 +63,12 @@ struct perf_opp_table {
 
     /* The DVFS identifier for this OPP table */
     fwk_id_t dvfs_id;
+
+    /* The OPP levels are strictly increasing and can be bisected */
+    bool sorted;
+
+    /* Distance between two consecutive levels if they are evenly spaced */
+    uint32_t level_step;
 };
 
 #ifdef BUILD_HAS_MOD_TRANSPORT_FC
@@ -77,6 +83,37 @@ struct fast_channel_ctx {
 
 #endif
 
+#ifdef BUILD_HAS_SCMI_PERF_FAST_CHANNELS
+/* Shadow of the fast channel requests of a domain */
+struct perf_fch_shadow {
+    /* Level last read from the LEVEL_SET fast channel */
+    uint32_t level;
+
+    /* Limits last read from the LIMIT_SET fast channel */
+    uint32_t range_min;
+    uint32_t range_max;
+
+    /* The level request changed and is still to be applied */
+    bool level_dirty;
+
+    /* The limits request changed and is still to be applied */
+    bool limits_dirty;
+
+#    ifdef BUILD_HAS_SCMI_PERF_PLUGIN_HANDLER
+    /* The domain has been pushed through the plugins handler on this poll */
+    bool pushed;
+
+    /* Whether the applied level and limits below are valid */
+    bool applied;
+
+    /* Level and limits last applied through the plugins handler */
+    uint32_t applied_level;
+    uint32_t applied_min;
+    uint32_t applied_max;
+#    endif
+};
+#endif
+
 /*!
  * \brief Domain context.
  */
@@ -96,6 +133,11 @@ struct scmi_perf_domain_ctx {
     struct fast_channel_ctx fch_ctx[MOD_SCMI_PERF_FAST_CHANNEL_COUNT];
 
 #endif
+
+#ifdef BUILD_HAS_SCMI_PERF_FAST_CHANNELS
+    /* Fast channel requests taken into account on the last poll */
+    struct perf_fch_shadow fch_shadow;
+#endif
 };
 
 struct mod_scmi_perf_ctx {
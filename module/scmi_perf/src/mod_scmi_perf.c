@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2015-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -67,6 +67,77 @@ static inline int opp_for_level_found(
     return FWK_SUCCESS;
 }
 
+/*
+ * Index of the first OPP with a level greater than or equal to the given one,
+ * or the number of OPPs if there is none. The OPP table must be sorted.
+ */
+static size_t opp_table_lower_bound(
+    const struct perf_opp_table *opp_table,
+    uint32_t level)
+{
+    size_t low, high, mid;
+    uint32_t base;
+
+    if (opp_table->level_step != 0) {
+        base = opp_table->opps[0].level;
+        if (level <= base) {
+            return 0;
+        }
+
+        mid = ((level - base) + (opp_table->level_step - 1)) /
+            opp_table->level_step;
+
+        return FWK_MIN(mid, opp_table->opp_count);
+    }
+
+    low = 0;
+    high = opp_table->opp_count;
+
+    while (low < high) {
+        mid = low + ((high - low) / 2);
+
+        if (opp_table->opps[mid].level < level) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+static int find_opp_for_level_sorted(
+    struct perf_opp_table *opp_table,
+    uint32_t *level,
+    uint32_t limit_max,
+    bool use_nearest)
+{
+    size_t i;
+
+    i = opp_table_lower_bound(
+        opp_table, use_nearest ? FWK_MIN(*level, limit_max) : *level);
+
+    if (i == opp_table->opp_count) {
+        if (!use_nearest) {
+            return FWK_E_RANGE;
+        }
+
+        /* Approximate to the highest level */
+        return opp_for_level_found(level, opp_table, i - 1);
+    }
+
+    if (!use_nearest && (opp_table->opps[i].level != *level)) {
+        return FWK_E_RANGE;
+    }
+
+    /* Must be within limits */
+    if ((opp_table->opps[i].level > limit_max) && (i > 0)) {
+        i--;
+    }
+
+    return opp_for_level_found(level, opp_table, i);
+}
+
 static int find_opp_for_level(
     struct scmi_perf_domain_ctx *domain_ctx,
     uint32_t *level,
@@ -79,6 +150,11 @@ static int find_opp_for_level(
     opp_table = domain_ctx->opp_table;
     limit_max = domain_ctx->level_limits.maximum;
 
+    if (opp_table->sorted) {
+        return find_opp_for_level_sorted(
+            opp_table, level, limit_max, use_nearest);
+    }
+
     for (i = 0; i < opp_table->opp_count; i++) {
         opp_level = opp_table->opps[i].level;
 
@@ -504,6 +580,36 @@ static int scmi_perf_process_bind_request(fwk_id_t source_id,
 }
 
 
+static void perf_opp_table_init_lookup(struct perf_opp_table *opp_table)
+{
+    uint32_t step;
+    size_t i;
+
+    opp_table->sorted = true;
+    opp_table->level_step = 0;
+
+    for (i = 1; i < opp_table->opp_count; i++) {
+        if (opp_table->opps[i].level <= opp_table->opps[i - 1].level) {
+            opp_table->sorted = false;
+            return;
+        }
+    }
+
+    if (opp_table->opp_count < 2) {
+        return;
+    }
+
+    step = opp_table->opps[1].level - opp_table->opps[0].level;
+
+    for (i = 2; i < opp_table->opp_count; i++) {
+        if ((opp_table->opps[i].level - opp_table->opps[i - 1].level) != step) {
+            return;
+        }
+    }
+
+    opp_table->level_step = step;
+}
+
 static int scmi_perf_start(fwk_id_t id)
 {
     int status = FWK_SUCCESS;
@@ -540,6 +646,8 @@ static int scmi_perf_start(fwk_id_t id)
         opp_table->opps = &dvfs_config->opps[0];
         opp_table->opp_count = opp_count;
         opp_table->dvfs_id = domain_id;
+
+        perf_opp_table_init_lookup(opp_table);
     }
 
     /* Assign to each performance domain the correct OPP table */
@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2021-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2021-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -23,6 +23,7 @@
 #include <fwk_assert.h>
 #include <fwk_id.h>
 #include <fwk_log.h>
+#include <fwk_macros.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
@@ -44,6 +45,8 @@ struct perf_plugins_dev_ctx {
      * of domains.
      *
      * The last entry of each table is reserved for the physical domain.
+     *
+     * The tables are windows on the domain tables of the module context.
      */
     struct perf_plugins_perf_update perf_table;
 
@@ -73,6 +76,13 @@ struct perf_plugins_mod_ctx {
      */
     fwk_id_t *dep_id_table;
 
+    /*
+     * Levels and limits of all the logical and physical domains, stored as
+     * one contiguous table per field. The entries of each physical domain
+     * follow the ones of the previous physical domain.
+     */
+    struct perf_plugins_perf_update dom_table;
+
     struct perf_plugins_perf_update full_perf_table;
 
     size_t dvfs_doms_count;
@@ -152,9 +162,18 @@ static void write_back_adj_values(
     struct perf_plugins_dev_ctx *dev_ctx,
     size_t phy_dom_idx)
 {
-    for (unsigned int i = 0; i < (dev_ctx->log_dom_count + 1); i++) {
-        dev_ctx->perf_table.adj_min_limit[i] = dev_ctx->lmin;
-        dev_ctx->perf_table.adj_max_limit[i] = dev_ctx->lmax;
+    uint32_t *restrict adj_min_limit_table = dev_ctx->perf_table.adj_min_limit;
+    uint32_t *restrict adj_max_limit_table = dev_ctx->perf_table.adj_max_limit;
+    unsigned int count = dev_ctx->log_dom_count + 1;
+    uint32_t lmin = dev_ctx->lmin;
+    uint32_t lmax = dev_ctx->lmax;
+
+    for (unsigned int i = 0; i < count; i++) {
+        adj_min_limit_table[i] = lmin;
+    }
+
+    for (unsigned int i = 0; i < count; i++) {
+        adj_max_limit_table[i] = lmax;
     }
 
     perf_plugins_ctx.full_perf_table.adj_min_limit[phy_dom_idx] = dev_ctx->lmin;
@@ -191,27 +210,24 @@ static void plugins_policy_sync_level_limits(
         needle_lim_min = min_limit_table[phy_dom];
         needle_lim_max = max_limit_table[phy_dom];
 
-        /* Find min/max on adjusted values, physical included */
+        /*
+         * Find min/max on adjusted values, physical included. The reductions
+         * are kept in separate branchless loops so they can be vectorized.
+         */
         for (unsigned int i = 0; i < (phy_dom + 1); i++) {
-            if (adj_min_limit_table[i] >= needle_lim_min) {
-                needle_lim_min = adj_min_limit_table[i];
-            }
+            needle_lim_min = FWK_MAX(needle_lim_min, adj_min_limit_table[i]);
+        }
 
-            if (adj_max_limit_table[i] <= needle_lim_max) {
-                needle_lim_max = adj_max_limit_table[i];
-            }
+        for (unsigned int i = 0; i < (phy_dom + 1); i++) {
+            needle_lim_max = FWK_MIN(needle_lim_max, adj_max_limit_table[i]);
         }
 
         /*
          * Now we apply the same policy against the temporary results for the
          * plugins updates so far.
          */
-        if (needle_lim_min > dev_ctx->lmin) {
-            dev_ctx->lmin = needle_lim_min;
-        }
-        if (needle_lim_max < dev_ctx->lmax) {
-            dev_ctx->lmax = needle_lim_max;
-        }
+        dev_ctx->lmin = FWK_MAX(dev_ctx->lmin, needle_lim_min);
+        dev_ctx->lmax = FWK_MIN(dev_ctx->lmax, needle_lim_max);
 
         dev_ctx->max = level_table[phy_dom];
 
@@ -228,12 +244,8 @@ static void plugins_policy_sync_level_limits(
             dev_ctx = perf_ph_get_ctx(FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, i));
 
             /* Update with adjusted min-max */
-            if (adj_min_lim_full_table[i] > dev_ctx->lmin) {
-                dev_ctx->lmin = adj_min_lim_full_table[i];
-            }
-            if (adj_max_lim_full_table[i] < dev_ctx->lmax) {
-                dev_ctx->lmax = adj_max_lim_full_table[i];
-            }
+            dev_ctx->lmin = FWK_MAX(dev_ctx->lmin, adj_min_lim_full_table[i]);
+            dev_ctx->lmax = FWK_MIN(dev_ctx->lmax, adj_max_lim_full_table[i]);
 
             dev_ctx->max = perf_plugins_ctx.full_perf_table.level[i];
 
@@ -340,17 +352,11 @@ static inline void domain_aggregate(
      * - pick the max for the min limit
      * - pick the min for the max limit
      */
-    if (this_dom->level[0] > phy_dom->level[0]) {
-        phy_dom->level[0] = this_dom->level[0];
-    }
-
-    if (this_dom->max_limit[0] < phy_dom->max_limit[0]) {
-        phy_dom->max_limit[0] = this_dom->max_limit[0];
-    }
-
-    if (this_dom->min_limit[0] > phy_dom->min_limit[0]) {
-        phy_dom->min_limit[0] = this_dom->min_limit[0];
-    }
+    phy_dom->level[0] = FWK_MAX(phy_dom->level[0], this_dom->level[0]);
+    phy_dom->max_limit[0] =
+        FWK_MIN(phy_dom->max_limit[0], this_dom->max_limit[0]);
+    phy_dom->min_limit[0] =
+        FWK_MAX(phy_dom->min_limit[0], this_dom->min_limit[0]);
 }
 
 static void store_and_aggregate(struct fc_perf_update *fc_update)
@@ -547,8 +553,9 @@ int perf_plugins_handler_init(const struct mod_scmi_perf_config *config)
     const struct mod_scmi_perf_domain_config *domain;
     int dvfs_doms_count;
     struct perf_plugins_dev_ctx *dev_ctx;
+    struct perf_plugins_perf_update *table;
     unsigned int pgroup, ldom = 0;
-    size_t all_doms_count;
+    size_t all_doms_count, offset;
     unsigned int phy_group;
     bool has_phy_group;
 
@@ -582,18 +589,34 @@ int perf_plugins_handler_init(const struct mod_scmi_perf_config *config)
     }
 
     /*
-     * Allocate a table for each of the physical domain to contain the
-     * requested levels/limits by each of its logical domains.
+     * Each physical domain has a table containing the requested levels/limits
+     * by each of its logical domains.
      * The size will be: number of logical domains + 1 (for physical domain).
      *
-     * At the same time, initialise min and max.
+     * The tables of all the physical domains are allocated contiguously so the
+     * aggregation walks linear memory.
      */
+    all_doms_count = 0;
+    for (size_t i = 0; i < perf_plugins_ctx.dvfs_doms_count; i++) {
+        dev_ctx = &perf_plugins_ctx.dev_ctx[i];
+        all_doms_count += (size_t)(dev_ctx->log_dom_count + 1);
+    }
+
+    perf_plugins_alloc_tables(&perf_plugins_ctx.dom_table, all_doms_count);
+
+    /* Assign each physical domain its window and initialise min and max */
+    offset = 0;
     for (size_t i = 0; i < perf_plugins_ctx.dvfs_doms_count; i++) {
         dev_ctx = &perf_plugins_ctx.dev_ctx[i];
+        table = &perf_plugins_ctx.dom_table;
 
-        all_doms_count = (size_t)(dev_ctx->log_dom_count + 1);
+        dev_ctx->perf_table.level = &table->level[offset];
+        dev_ctx->perf_table.max_limit = &table->max_limit[offset];
+        dev_ctx->perf_table.adj_max_limit = &table->adj_max_limit[offset];
+        dev_ctx->perf_table.min_limit = &table->min_limit[offset];
+        dev_ctx->perf_table.adj_min_limit = &table->adj_min_limit[offset];
 
-        perf_plugins_alloc_tables(&dev_ctx->perf_table, all_doms_count);
+        offset += (size_t)(dev_ctx->log_dom_count + 1);
 
         dev_ctx->lmin = 0;
         dev_ctx->lmax = UINT32_MAX;
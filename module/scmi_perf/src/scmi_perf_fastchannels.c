@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2015-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -535,80 +535,156 @@ static inline void load_tlevel(
     *tlevel = (set_level != NULL) ? *set_level : domain_ctx->curr_level;
 }
 
-#ifdef BUILD_HAS_SCMI_PERF_PLUGIN_HANDLER
-static void perf_fch_process_plugins_handler(void)
+/*
+ * Read the requests posted on the fast channels of a domain into its shadow.
+ * The fast channels are read once per poll and the return value tells whether
+ * any request is still to be applied.
+ */
+static bool perf_fch_fetch_requests(
+    unsigned int domain_idx,
+    struct scmi_perf_domain_ctx *domain_ctx)
 {
-    struct mod_scmi_perf_fast_channel_limit *set_limit;
-    struct scmi_perf_domain_ctx *domain_ctx;
-    uint32_t *set_level;
+    struct perf_fch_shadow *shadow = &domain_ctx->fch_shadow;
     uint32_t tlevel, tmax, tmin;
-    unsigned int i;
-    int status;
 
-    struct mod_scmi_perf_ctx *perf_ctx = perf_fch_ctx.perf_ctx;
+    load_tlimits(get_fc_set_limit_addr(domain_idx), &tmax, &tmin, domain_ctx);
+    load_tlevel(get_fc_set_level_addr(domain_idx), &tlevel, domain_ctx);
+
+    if (tlevel != shadow->level) {
+        shadow->level = tlevel;
+        shadow->level_dirty = true;
+    }
+
+    if ((tmax != shadow->range_max) || (tmin != shadow->range_min)) {
+        shadow->range_max = tmax;
+        shadow->range_min = tmin;
+        shadow->limits_dirty = true;
+    }
+
+    return shadow->level_dirty || shadow->limits_dirty;
+}
+
+#ifdef BUILD_HAS_SCMI_PERF_PLUGIN_HANDLER
+static void perf_fch_push_requests(unsigned int domain_idx)
+{
+    struct perf_fch_shadow *shadow;
     struct fc_perf_update update;
 
-    for (i = 0; i < perf_ctx->domain_count; i++) {
-        if (perf_fch_domain_has_fastchannels(i)) {
-            set_limit = get_fc_set_limit_addr(i);
-            set_level = get_fc_set_level_addr(i);
+    shadow = &perf_fch_ctx.perf_ctx->domain_ctx_table[domain_idx].fch_shadow;
 
-            domain_ctx = &perf_ctx->domain_ctx_table[i];
-            load_tlimits(set_limit, &tmax, &tmin, domain_ctx);
+    update = (struct fc_perf_update){
+        .domain_id = get_dependency_id(domain_idx),
+        .level = shadow->level,
+        .max_limit = shadow->range_max,
+        .min_limit = shadow->range_min,
+    };
 
-            load_tlevel(set_level, &tlevel, domain_ctx);
+    perf_plugins_handler_update(domain_idx, &update);
 
-            update = (struct fc_perf_update){
-                .domain_id = get_dependency_id(i),
-                .level = tlevel,
-                .max_limit = tmax,
-                .min_limit = tmin,
-            };
+    shadow->pushed = true;
+}
 
-            perf_plugins_handler_update(i, &update);
-        }
-    }
+static void perf_fch_apply_requests(unsigned int domain_idx)
+{
+    struct perf_fch_shadow *shadow;
+    struct fc_perf_update update;
+    uint32_t tlevel, tmax, tmin;
+    int status;
 
-    for (i = 0; i < perf_ctx->domain_count; i++) {
-        if (perf_fch_domain_has_fastchannels(i)) {
-            set_limit = get_fc_set_limit_addr(i);
-            set_level = get_fc_set_level_addr(i);
+    shadow = &perf_fch_ctx.perf_ctx->domain_ctx_table[domain_idx].fch_shadow;
+    shadow->pushed = false;
 
-            domain_ctx = &perf_ctx->domain_ctx_table[i];
+    update = (struct fc_perf_update){
+        .domain_id = get_dependency_id(domain_idx),
+        .level = shadow->level,
+        .max_limit = shadow->range_max,
+        .min_limit = shadow->range_min,
+    };
 
-            load_tlimits(set_limit, &tmax, &tmin, domain_ctx);
+    perf_plugins_handler_get(domain_idx, &update);
 
-            load_tlevel(set_level, &tlevel, domain_ctx);
+    tlevel = update.level;
+    tmax = update.adj_max_limit;
+    tmin = update.adj_min_limit;
+
+    /* Nothing to do if the outcome is the one applied on a previous poll */
+    if (shadow->applied && (tlevel == shadow->applied_level) &&
+        (tmax == shadow->applied_max) && (tmin == shadow->applied_min)) {
+        shadow->level_dirty = false;
+        shadow->limits_dirty = false;
+        return;
+    }
+
+    perf_eval_performance(
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_SCMI_PERF, domain_idx),
+        &((struct mod_scmi_perf_level_limits){
+            .minimum = tmin,
+            .maximum = tmax,
+        }),
+        &tlevel);
+
+    status = perf_fch_ctx.perf_ctx->dvfs_api->set_level(
+        get_dependency_id(domain_idx), 0, tlevel);
+    if ((status != FWK_SUCCESS) && (status != FWK_PENDING)) {
+        /* Keep the requests dirty, they will be applied on the next poll */
+        FWK_LOG_DEBUG("[SCMI-PERF] %s @%d", __func__, __LINE__);
+        shadow->applied = false;
+        return;
+    }
 
-            update = (struct fc_perf_update){
-                .domain_id = get_dependency_id(i),
-                .level = tlevel,
-                .max_limit = tmax,
-                .min_limit = tmin,
-            };
+    shadow->applied = true;
+    shadow->applied_level = update.level;
+    shadow->applied_max = tmax;
+    shadow->applied_min = tmin;
+    shadow->level_dirty = false;
+    shadow->limits_dirty = false;
+}
 
-            perf_plugins_handler_get(i, &update);
+static void perf_fch_process_plugins_handler(void)
+{
+    struct mod_scmi_perf_ctx *perf_ctx = perf_fch_ctx.perf_ctx;
+    unsigned int first, last, i;
+    unsigned int phy_dom_idx;
+    bool dirty;
 
-            tlevel = update.level;
-            tmax = update.adj_max_limit;
-            tmin = update.adj_min_limit;
+    /*
+     * The performance domains of a physical domain are grouped and ordered
+     * together, and must be pushed through the plugins handler together.
+     * Plugins can change the performance of any domain on any poll, so all the
+     * domains are pushed when there are plugins. Otherwise, only the physical
+     * domains with a new request are pushed.
+     */
+    for (first = 0; first < perf_ctx->domain_count; first = last) {
+        phy_dom_idx = fwk_id_get_element_idx(get_dependency_id(first));
+        dirty = (perf_ctx->config->plugins_count != 0);
+
+        for (last = first; (last < perf_ctx->domain_count) &&
+             (fwk_id_get_element_idx(get_dependency_id(last)) == phy_dom_idx);
+             last++) {
+            if (perf_fch_domain_has_fastchannels(last) &&
+                perf_fch_fetch_requests(
+                    last, &perf_ctx->domain_ctx_table[last])) {
+                dirty = true;
+            }
+        }
 
-            perf_eval_performance(
-                FWK_ID_ELEMENT(FWK_MODULE_IDX_SCMI_PERF, i),
-                &((struct mod_scmi_perf_level_limits){
-                    .minimum = tmin,
-                    .maximum = tmax,
-                }),
-                &tlevel);
+        if (!dirty) {
+            continue;
+        }
 
-            status = perf_fch_ctx.perf_ctx->dvfs_api->set_level(
-                get_dependency_id(i), 0, tlevel);
-            if (status != FWK_SUCCESS) {
-                FWK_LOG_DEBUG("[SCMI-PERF] %s @%d", __func__, __LINE__);
+        for (i = first; i < last; i++) {
+            if (perf_fch_domain_has_fastchannels(i)) {
+                perf_fch_push_requests(i);
             }
         }
     }
 
+    for (i = 0; i < perf_ctx->domain_count; i++) {
+        if (perf_ctx->domain_ctx_table[i].fch_shadow.pushed) {
+            perf_fch_apply_requests(i);
+        }
+    }
+
     decrement_pending_req_count();
 }
 #endif
@@ -616,48 +692,59 @@ static void perf_fch_process_plugins_handler(void)
 #ifndef BUILD_HAS_SCMI_PERF_PLUGIN_HANDLER
 static void perf_fch_process(void)
 {
-    struct mod_scmi_perf_fast_channel_limit *set_limit;
     struct scmi_perf_domain_ctx *domain_ctx;
-    uint32_t *set_level;
-    uint32_t tlevel, tmax, tmin;
+    struct perf_fch_shadow *shadow;
     unsigned int i;
     int status;
 
     struct mod_scmi_perf_ctx *perf_ctx = perf_fch_ctx.perf_ctx;
 
     for (i = 0; i < perf_ctx->domain_count; i++) {
-        if (perf_fch_domain_has_fastchannels(i)) {
-            set_limit = get_fc_set_limit_addr(i);
-            set_level = get_fc_set_level_addr(i);
-
-            domain_ctx = &perf_ctx->domain_ctx_table[i];
+        if (!perf_fch_domain_has_fastchannels(i)) {
+            continue;
+        }
 
-            load_tlimits(set_limit, &tmax, &tmin, domain_ctx);
+        domain_ctx = &perf_ctx->domain_ctx_table[i];
+        shadow = &domain_ctx->fch_shadow;
 
-            load_tlevel(set_level, &tlevel, domain_ctx);
+        /* Only the domains with a new request are processed */
+        if (!perf_fch_fetch_requests(i, domain_ctx)) {
+            continue;
+        }
 
-            if (set_level != NULL && tlevel > 0) {
-                status = perf_fch_ctx.api_fch_stub->perf_set_level(
-                    get_dependency_id(i), 0, tlevel);
-                if (status != FWK_SUCCESS) {
-                    FWK_LOG_DEBUG("[SCMI-PERF] %s @%d", __func__, __LINE__);
-                }
-            }
-            if (set_limit != NULL) {
-                if ((tmax == 0) && (tmin == 0)) {
-                    continue;
-                }
+        if (shadow->limits_dirty) {
+            if ((get_fc_set_limit_addr(i) != NULL) &&
+                ((shadow->range_max != 0) || (shadow->range_min != 0))) {
                 status = perf_fch_ctx.api_fch_stub->perf_set_limits(
                     get_dependency_id(i),
                     0,
                     &((struct mod_scmi_perf_level_limits){
-                        .minimum = tmin,
-                        .maximum = tmax,
+                        .minimum = shadow->range_min,
+                        .maximum = shadow->range_max,
                     }));
-                if (status != FWK_SUCCESS) {
+                if ((status != FWK_SUCCESS) && (status != FWK_PENDING)) {
                     FWK_LOG_DEBUG("[SCMI-PERF] %s @%d", __func__, __LINE__);
+                    continue;
                 }
             }
+
+            shadow->limits_dirty = false;
+
+            /* A level restricted by the previous limits may now be reached */
+            shadow->level_dirty = true;
+        }
+
+        if (shadow->level_dirty) {
+            if ((get_fc_set_level_addr(i) != NULL) && (shadow->level > 0)) {
+                status = perf_fch_ctx.api_fch_stub->perf_set_level(
+                    get_dependency_id(i), 0, shadow->level);
+                if ((status != FWK_SUCCESS) && (status != FWK_PENDING)) {
+                    FWK_LOG_DEBUG("[SCMI-PERF] %s @%d", __func__, __LINE__);
+                    continue;
+                }
+            }
+
+            shadow->level_dirty = false;
         }
     }
 
@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2022-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2022-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -538,6 +538,172 @@ void utest_perf_fch_init_success(void)
         SCMI_PERF_FC_MIN_RATE_LIMIT, perf_fch_ctx.fast_channels_rate_limit);
 }
 
+/*
+ * Fast channel processing helpers.
+ *
+ * A single performance domain is set up with LEVEL_SET and LIMIT_SET fast
+ * channels, and the requests forwarded by perf_fch_process() to the SCMI
+ * Performance stub are recorded in order.
+ */
+#define FCH_PROCESS_MAX_CALLS 4
+
+enum fch_process_call {
+    FCH_PROCESS_CALL_SET_LIMITS,
+    FCH_PROCESS_CALL_SET_LEVEL,
+};
+
+static uint32_t fch_process_level;
+static struct mod_scmi_perf_fast_channel_limit fch_process_limit;
+static struct scmi_perf_domain_ctx fch_process_domain_ctx;
+
+static enum fch_process_call fch_process_calls[FCH_PROCESS_MAX_CALLS];
+static unsigned int fch_process_call_count;
+static uint32_t fch_process_set_level;
+
+#ifndef BUILD_HAS_MOD_TRANSPORT_FC
+static uint64_t fch_process_addr_scp[MOD_SCMI_PERF_FAST_CHANNEL_COUNT];
+
+static const struct mod_scmi_perf_domain_config fch_process_domains[] = {
+    {
+        .fast_channels_addr_scp = fch_process_addr_scp,
+    },
+};
+
+static const struct mod_scmi_perf_config fch_process_config = {
+    .domains = &fch_process_domains,
+    .perf_doms_count = FWK_ARRAY_SIZE(fch_process_domains),
+    .fast_channels_alarm_id = FWK_ID_NONE_INIT,
+};
+#endif
+
+static int fch_process_perf_set_level(
+    fwk_id_t domain_id,
+    unsigned int agent_id,
+    uint32_t perf_level)
+{
+    TEST_ASSERT_LESS_THAN(FCH_PROCESS_MAX_CALLS, fch_process_call_count);
+
+    fch_process_calls[fch_process_call_count++] = FCH_PROCESS_CALL_SET_LEVEL;
+    fch_process_set_level = perf_level;
+
+    return FWK_SUCCESS;
+}
+
+static int fch_process_perf_set_limits(
+    fwk_id_t domain_id,
+    unsigned int agent_id,
+    const struct mod_scmi_perf_level_limits *limits)
+{
+    TEST_ASSERT_LESS_THAN(FCH_PROCESS_MAX_CALLS, fch_process_call_count);
+
+    fch_process_calls[fch_process_call_count++] = FCH_PROCESS_CALL_SET_LIMITS;
+
+    return FWK_SUCCESS;
+}
+
+static struct mod_scmi_perf_private_api_perf_stub fch_process_api = {
+    .perf_set_level = fch_process_perf_set_level,
+    .perf_set_limits = fch_process_perf_set_limits,
+};
+
+static void fch_process_setup(void)
+{
+    memset(&fch_process_domain_ctx, 0, sizeof(fch_process_domain_ctx));
+    fch_process_call_count = 0;
+    fch_process_set_level = 0;
+
+    fch_process_level = 300 * 1000000UL;
+    fch_process_limit.range_min = 100 * 1000000UL;
+    fch_process_limit.range_max = 500 * 1000000UL;
+
+#ifdef BUILD_HAS_MOD_TRANSPORT_FC
+    fch_process_domain_ctx.fch_ctx[MOD_SCMI_PERF_FAST_CHANNEL_LEVEL_SET]
+        .fch_address.local_view_address = (uintptr_t)&fch_process_level;
+    fch_process_domain_ctx.fch_ctx[MOD_SCMI_PERF_FAST_CHANNEL_LIMIT_SET]
+        .fch_address.local_view_address = (uintptr_t)&fch_process_limit;
+#else
+    fch_process_addr_scp[MOD_SCMI_PERF_FAST_CHANNEL_LEVEL_SET] =
+        (uintptr_t)&fch_process_level;
+    fch_process_addr_scp[MOD_SCMI_PERF_FAST_CHANNEL_LIMIT_SET] =
+        (uintptr_t)&fch_process_limit;
+
+    scmi_perf_ctx.config = &fch_process_config;
+#endif
+
+    scmi_perf_ctx.domain_count = 1;
+    scmi_perf_ctx.domain_ctx_table = &fch_process_domain_ctx;
+    perf_fch_ctx.api_fch_stub = &fch_process_api;
+}
+
+/*
+ * Test that a domain whose fast channels did not change since the previous
+ * poll is not processed again.
+ */
+void utest_perf_fch_process_unchanged_no_request(void)
+{
+    fch_process_setup();
+
+    perf_fch_process();
+    TEST_ASSERT_EQUAL(2, fch_process_call_count);
+
+    fch_process_call_count = 0;
+    perf_fch_process();
+    TEST_ASSERT_EQUAL(0, fch_process_call_count);
+}
+
+/*
+ * Test that the limits are applied before the level, and that a new limits
+ * request also applies the level again.
+ */
+void utest_perf_fch_process_limits_then_level(void)
+{
+    fch_process_setup();
+
+    perf_fch_process();
+    TEST_ASSERT_EQUAL(2, fch_process_call_count);
+    TEST_ASSERT_EQUAL(FCH_PROCESS_CALL_SET_LIMITS, fch_process_calls[0]);
+    TEST_ASSERT_EQUAL(FCH_PROCESS_CALL_SET_LEVEL, fch_process_calls[1]);
+    TEST_ASSERT_EQUAL(fch_process_level, fch_process_set_level);
+
+    fch_process_call_count = 0;
+    fch_process_set_level = 0;
+    fch_process_limit.range_max = 400 * 1000000UL;
+
+    perf_fch_process();
+    TEST_ASSERT_EQUAL(2, fch_process_call_count);
+    TEST_ASSERT_EQUAL(FCH_PROCESS_CALL_SET_LIMITS, fch_process_calls[0]);
+    TEST_ASSERT_EQUAL(FCH_PROCESS_CALL_SET_LEVEL, fch_process_calls[1]);
+    TEST_ASSERT_EQUAL(fch_process_level, fch_process_set_level);
+}
+
+/*
+ * Test that a level set through an SCMI message is not overridden on the next
+ * poll by the unchanged value of the LEVEL_SET fast channel.
+ */
+void utest_perf_fch_process_scmi_level_survives(void)
+{
+    fch_process_setup();
+
+    perf_fch_process();
+    TEST_ASSERT_EQUAL(2, fch_process_call_count);
+
+    /* Level set by an agent through the PERFORMANCE_LEVEL_SET message */
+    fch_process_domain_ctx.curr_level = 400 * 1000000UL;
+
+    fch_process_call_count = 0;
+    perf_fch_process();
+    TEST_ASSERT_EQUAL(0, fch_process_call_count);
+    TEST_ASSERT_EQUAL(400 * 1000000UL, fch_process_domain_ctx.curr_level);
+
+    /* A new fast channel request is still taken into account */
+    fch_process_level = 200 * 1000000UL;
+
+    perf_fch_process();
+    TEST_ASSERT_EQUAL(1, fch_process_call_count);
+    TEST_ASSERT_EQUAL(FCH_PROCESS_CALL_SET_LEVEL, fch_process_calls[0]);
+    TEST_ASSERT_EQUAL(fch_process_level, fch_process_set_level);
+}
+
 int scmi_perf_fch_test_main(void)
 {
     UNITY_BEGIN();
@@ -554,6 +720,10 @@ int scmi_perf_fch_test_main(void)
 
     RUN_TEST(utest_perf_fch_init_success);
 
+    RUN_TEST(utest_perf_fch_process_unchanged_no_request);
+    RUN_TEST(utest_perf_fch_process_limits_then_level);
+    RUN_TEST(utest_perf_fch_process_scmi_level_survives);
+
     return UNITY_END();
 }
 
@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2022-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2022-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -380,6 +380,7 @@ void utest_perf_plugins_handler_init_success(void)
 {
     struct perf_plugins_dev_ctx dev_ctx[DVFS_ELEMENT_IDX_COUNT];
     fwk_id_t dep_id_table[SCMI_PERF_ELEMENT_IDX_COUNT];
+    struct perf_plugins_perf_update dom_table;
     int status;
 
     memset(dev_ctx, 0, sizeof(*dev_ctx) * DVFS_ELEMENT_IDX_COUNT);
@@ -391,8 +392,8 @@ void utest_perf_plugins_handler_init_success(void)
         sizeof(struct perf_plugins_dev_ctx),
         &dev_ctx[0]);
 
-    malloc_perf_plugins_alloc_tables(2, &dev_ctx[0].perf_table);
-    malloc_perf_plugins_alloc_tables(3, &dev_ctx[1].perf_table);
+    /* One contiguous table for 1 + 2 logical domains and 2 physical domains */
+    malloc_perf_plugins_alloc_tables(5, &dom_table);
 
     malloc_perf_plugins_alloc_tables(
         DVFS_ELEMENT_IDX_COUNT, &perf_plugins_ctx.full_perf_table);
@@ -421,9 +422,15 @@ void utest_perf_plugins_handler_init_success(void)
     status = perf_plugins_handler_init(config_scmi_perf.data);
     TEST_ASSERT_EQUAL(status, FWK_SUCCESS);
 
-    for (size_t i = 0; i < DVFS_ELEMENT_IDX_COUNT; i++) {
-        dealloc_perf_plugins_alloc_tables(&dev_ctx[i].perf_table);
-    }
+    /* Each physical domain has a window on the contiguous table */
+    TEST_ASSERT_EQUAL_PTR(&dom_table.level[0], dev_ctx[0].perf_table.level);
+    TEST_ASSERT_EQUAL_PTR(
+        &dom_table.adj_min_limit[0], dev_ctx[0].perf_table.adj_min_limit);
+    TEST_ASSERT_EQUAL_PTR(&dom_table.level[2], dev_ctx[1].perf_table.level);
+    TEST_ASSERT_EQUAL_PTR(
+        &dom_table.max_limit[2], dev_ctx[1].perf_table.max_limit);
+
+    dealloc_perf_plugins_alloc_tables(&dom_table);
     dealloc_perf_plugins_alloc_tables(&perf_plugins_ctx.full_perf_table);
 }
 
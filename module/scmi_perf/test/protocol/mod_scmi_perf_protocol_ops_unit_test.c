@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2022-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2022-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -858,6 +858,53 @@ void utest_find_opp_for_level_use_nearest(void)
     TEST_ASSERT_EQUAL(level_limits.maximum, approximate_level);
 }
 
+/*
+ * Test the find_opp_for_level function on a table prepared for bisection. The
+ * results must match the ones of the linear search.
+ */
+void utest_find_opp_for_level_sorted_table(void)
+{
+    int status;
+    unsigned int i;
+    uint32_t level, expected_level;
+    bool use_nearest;
+
+    struct perf_opp_table opp_table = {
+        .opps = test_dvfs_config.opps,
+        .opp_count = TEST_OPP_COUNT,
+    };
+
+    struct perf_opp_table sorted_opp_table = opp_table;
+
+    struct scmi_perf_domain_ctx domain_ctx = {
+        .level_limits = {
+            .minimum = test_dvfs_config.opps[0].level,
+            .maximum = test_dvfs_config.opps[TEST_OPP_COUNT - 2].level,
+        },
+        .opp_table = &opp_table,
+    };
+
+    struct scmi_perf_domain_ctx sorted_domain_ctx = domain_ctx;
+
+    perf_opp_table_init_lookup(&sorted_opp_table);
+    TEST_ASSERT_TRUE(sorted_opp_table.sorted);
+    sorted_domain_ctx.opp_table = &sorted_opp_table;
+
+    for (i = 0; i < (2 * TEST_OPP_COUNT); i++) {
+        use_nearest = (i % 2) != 0;
+
+        /* Exact levels, then levels in between OPPs */
+        expected_level = test_dvfs_config.opps[i / 2].level + (i % 2);
+        level = expected_level;
+
+        status = find_opp_for_level(&domain_ctx, &expected_level, use_nearest);
+        TEST_ASSERT_EQUAL(
+            status,
+            find_opp_for_level(&sorted_domain_ctx, &level, use_nearest));
+        TEST_ASSERT_EQUAL(expected_level, level);
+    }
+}
+
 /*
  * Test the validate_new_limits function with a valid set of limits, without
  * approximating the level.
@@ -1034,6 +1081,7 @@ int scmi_perf_protocol_ops_test_main(void)
     RUN_TEST(utest_find_opp_for_level_valid_level);
     RUN_TEST(utest_find_opp_for_level_invalid_level);
     RUN_TEST(utest_find_opp_for_level_use_nearest);
+    RUN_TEST(utest_find_opp_for_level_sorted_table);
 
     RUN_TEST(utest_validate_new_limits_valid_limits);
     RUN_TEST(utest_validate_new_limits_invalid_limits);
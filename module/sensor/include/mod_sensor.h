@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2015-2022, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -370,6 +370,29 @@ struct mod_sensor_dev_config {
     /*! Sensor timestamp default values configuration */
     struct mod_sensor_timestamp_info timestamp;
 #endif
+
+    /*!
+     * \brief Maximum age of a reading, in microseconds.
+     *
+     * \details Requests received within this window of the last successful
+     *      reading are answered synchronously with that reading instead of
+     *      querying the driver again. A value of zero disables the behaviour
+     *      and every request reaches the driver.
+     */
+    uint32_t max_age_us;
+
+    /*!
+     * \brief Identifier of the group of the sensor (optional).
+     *
+     * \details Sensors that share the same group identifier are read
+     *      together by a single call to the
+     *      ::mod_sensor_driver_api::get_group_values driver function, which
+     *      refreshes the readings of all of them. The identifier is opaque to
+     *      this module and is only passed to the driver. All the sensors of a
+     *      group must be bound to the same driver API and must be
+     *      single-axis. Leave undefined for the sensor to be read on its own.
+     */
+    fwk_optional_id_t group_id;
 };
 
 /*!
@@ -445,6 +468,31 @@ struct mod_sensor_driver_api {
      */
     int (*get_info)(fwk_id_t id, struct mod_sensor_info *info);
 
+    /*!
+     * \brief Get the values of a group of sensors.
+     *
+     * \details Reads the values of all the sensors of a group in a single
+     *      device transaction. This function is only required from drivers of
+     *      sensors that have a group configured. When the request is pending,
+     *      the driver must fill \p values before reporting completion through
+     *      ::mod_sensor_driver_response_api::group_reading_complete.
+     *
+     * \param group_id Group identifier, as configured for its sensors.
+     * \param driver_ids Driver identifiers of the sensors of the group.
+     * \param[out] values Sensor values, in the same order as \p driver_ids.
+     * \param count Number of sensors in the group.
+     *
+     * \retval ::FWK_PENDING The request is pending. The driver will provide the
+     *      requested values later through the driver response API.
+     * \retval ::FWK_SUCCESS The values were read successfully.
+     * \return One of the standard framework error codes.
+     */
+    int (*get_group_values)(
+        fwk_id_t group_id,
+        const fwk_id_t *driver_ids,
+        mod_sensor_value_t *values,
+        unsigned int count);
+
 #ifdef BUILD_HAS_SENSOR_MULTI_AXIS
     /*!
      * \brief Get number of axis.
@@ -622,6 +670,18 @@ struct mod_sensor_driver_response_api {
      */
     void (*reading_complete)(fwk_id_t id,
                              struct mod_sensor_driver_resp_params *response);
+
+    /*!
+     * \brief Inform the completion of a sensor group reading.
+     *
+     * \details The readings of all the sensors of the group are refreshed
+     *      from the values filled by the driver, and every pending request on
+     *      any of them is completed.
+     *
+     * \param id Specific sensor device identifier of any sensor of the group.
+     * \param status Status of the group reading.
+     */
+    void (*group_reading_complete)(fwk_id_t id, int status);
 };
 
 /*!
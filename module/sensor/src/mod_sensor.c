@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2015-2022, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -21,6 +21,7 @@
 #include <fwk_module_idx.h>
 #include <fwk_status.h>
 #include <fwk_string.h>
+#include <fwk_time.h>
 
 #include <stdbool.h>
 #include <stddef.h>
@@ -107,6 +108,39 @@ static bool trip_point_evaluate(
 }
 #endif
 
+/*
+ * Record the time of a successful reading so that requests received within
+ * the configured maximum age can be answered from it.
+ */
+static void sensor_last_read_update_time(struct sensor_dev_ctx *ctx)
+{
+    if (ctx->config->max_age_us != 0) {
+        ctx->last_read_time = fwk_time_current();
+    }
+}
+
+static bool sensor_last_read_is_fresh(struct sensor_dev_ctx *ctx)
+{
+    fwk_timestamp_t now;
+
+    if ((ctx->config->max_age_us == 0) ||
+        (ctx->last_read.status != FWK_SUCCESS)) {
+        return false;
+    }
+
+    /* Without a time source the age of the reading cannot be known */
+    now = fwk_time_current();
+    if ((now == 0) || (ctx->last_read_time == 0)) {
+        return false;
+    }
+
+    if (now <= ctx->last_read_time) {
+        return true;
+    }
+
+    return (now - ctx->last_read_time) < FWK_US(ctx->config->max_age_us);
+}
+
 #ifdef BUILD_HAS_SCMI_SENSOR_EVENTS
 static void trip_point_process(fwk_id_t id, struct mod_sensor_data *data)
 {
@@ -131,6 +165,71 @@ static void trip_point_process(fwk_id_t id, struct mod_sensor_data *data)
 }
 #endif
 
+/*
+ * Refresh the reading of one sensor of a group from the value provided by the
+ * driver.
+ */
+static void sensor_group_update_member(
+    unsigned int element_idx,
+    int status,
+    mod_sensor_value_t value)
+{
+    struct sensor_dev_ctx *ctx = &ctx_table[element_idx];
+#if defined(BUILD_HAS_SCMI_SENSOR_EVENTS) || defined(BUILD_HAS_SENSOR_TIMESTAMP)
+    fwk_id_t dev_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_SENSOR, element_idx);
+#endif
+
+    ctx->last_read.status = status;
+    if (status != FWK_SUCCESS) {
+        return;
+    }
+
+    ctx->last_read.value = value;
+#ifdef BUILD_HAS_SCMI_SENSOR_EVENTS
+    trip_point_process(dev_id, &ctx->last_read);
+#endif
+#ifdef BUILD_HAS_SENSOR_TIMESTAMP
+    ctx->last_read.timestamp = sensor_get_timestamp(dev_id);
+#endif
+    sensor_last_read_update_time(ctx);
+}
+
+static void sensor_group_update(struct sensor_group_ctx *group, int status)
+{
+    unsigned int i;
+
+    for (i = 0; i < group->member_count; i++) {
+        sensor_group_update_member(
+            group->members[i], status, group->values[i]);
+    }
+}
+
+/*
+ * Read all the sensors of a group with a single driver call. A reading that is
+ * already in progress for another sensor of the group is shared.
+ */
+static int sensor_group_read(struct sensor_group_ctx *group)
+{
+    int status;
+
+    if (group->reading) {
+        return FWK_PENDING;
+    }
+
+    status = group->driver_api->get_group_values(
+        group->group_id,
+        group->driver_ids,
+        group->values,
+        group->member_count);
+    if (status == FWK_PENDING) {
+        group->reading = true;
+    } else {
+        sensor_group_update(group, status);
+    }
+
+    return status;
+}
+
 /*
  * Module API
  */
@@ -155,7 +254,23 @@ static int get_data(fwk_id_t id, struct mod_sensor_data *data)
         return ctx->last_read.status;
     }
 
-    if (ctx->concurrency_readings.pending_requests == 0) {
+    if (sensor_last_read_is_fresh(ctx)) {
+        /* The last reading is recent enough, share it with this request */
+        sensor_data_copy(data, &ctx->last_read);
+        return FWK_SUCCESS;
+    }
+
+    if ((ctx->concurrency_readings.pending_requests == 0) &&
+        (ctx->group != NULL)) {
+        status = sensor_group_read(ctx->group);
+        if (status == FWK_SUCCESS) {
+            sensor_data_copy(data, &ctx->last_read);
+
+            return status;
+        } else if (status != FWK_PENDING) {
+            return status;
+        }
+    } else if (ctx->concurrency_readings.pending_requests == 0) {
         status = ctx->driver_api->get_value(
             ctx->config->driver_id, &ctx->last_read.value);
         ctx->last_read.status = status;
@@ -166,6 +281,7 @@ static int get_data(fwk_id_t id, struct mod_sensor_data *data)
 #ifdef BUILD_HAS_SENSOR_TIMESTAMP
             ctx->last_read.timestamp = sensor_get_timestamp(id);
 #endif
+            sensor_last_read_update_time(ctx);
             sensor_data_copy(data, &ctx->last_read);
 
             return status;
@@ -337,6 +453,9 @@ static void reading_complete(fwk_id_t dev_id,
 #ifdef BUILD_HAS_SCMI_SENSOR_EVENTS
         trip_point_process(dev_id, &ctx->last_read);
 #endif
+        if (response->status == FWK_SUCCESS) {
+            sensor_last_read_update_time(ctx);
+        }
     } else {
         ctx->last_read.status = FWK_E_DEVICE;
     }
@@ -347,8 +466,50 @@ static void reading_complete(fwk_id_t dev_id,
     fwk_assert(status == FWK_SUCCESS);
 }
 
+static void group_reading_complete(fwk_id_t dev_id, int status)
+{
+    int put_status;
+    unsigned int i;
+    struct fwk_event event;
+    struct sensor_dev_ctx *ctx;
+    struct sensor_group_ctx *group;
+
+    if (!fwk_expect(fwk_id_get_module_idx(dev_id) == FWK_MODULE_IDX_SENSOR)) {
+        return;
+    }
+
+    group = ctx_table[fwk_id_get_element_idx(dev_id)].group;
+    if (!fwk_expect((group != NULL) && group->reading)) {
+        return;
+    }
+
+    group->reading = false;
+    sensor_group_update(group, status);
+
+    /* Complete the requests pending on every sensor of the group */
+    for (i = 0; i < group->member_count; i++) {
+        ctx = &ctx_table[group->members[i]];
+        if (ctx->concurrency_readings.pending_requests == 0) {
+            continue;
+        }
+
+        event = (struct fwk_event){
+            .id = mod_sensor_event_id_read_complete,
+            .source_id = ctx->config->driver_id,
+            .target_id =
+                FWK_ID_ELEMENT(FWK_MODULE_IDX_SENSOR, group->members[i]),
+        };
+
+        ctx->concurrency_readings.dequeuing = true;
+
+        put_status = fwk_put_event(&event);
+        fwk_assert(put_status == FWK_SUCCESS);
+    }
+}
+
 static struct mod_sensor_driver_response_api sensor_driver_response_api = {
     .reading_complete = reading_complete,
+    .group_reading_complete = group_reading_complete,
 };
 
 /*
@@ -404,6 +565,60 @@ static int sensor_dev_init(fwk_id_t element_id,
 #endif
 }
 
+static bool sensor_is_in_group(
+    const struct sensor_dev_ctx *ctx,
+    fwk_id_t group_id)
+{
+    return fwk_optional_id_is_defined(ctx->config->group_id) &&
+        fwk_id_is_equal(ctx->config->group_id, group_id);
+}
+
+static int sensor_post_init(fwk_id_t module_id)
+{
+    unsigned int i, j, member_idx;
+    unsigned int element_count;
+    unsigned int member_count;
+    struct sensor_dev_ctx *ctx;
+    struct sensor_group_ctx *group;
+
+    element_count = (unsigned int)fwk_module_get_element_count(module_id);
+
+    for (i = 0; i < element_count; i++) {
+        ctx = &ctx_table[i];
+        if ((ctx->group != NULL) ||
+            !fwk_optional_id_is_defined(ctx->config->group_id)) {
+            continue;
+        }
+
+        member_count = 0;
+        for (j = i; j < element_count; j++) {
+            if (sensor_is_in_group(&ctx_table[j], ctx->config->group_id)) {
+                member_count++;
+            }
+        }
+
+        group = fwk_mm_calloc(1, sizeof(*group));
+        group->group_id = ctx->config->group_id;
+        group->member_count = member_count;
+        group->members = fwk_mm_calloc(member_count, sizeof(group->members[0]));
+        group->driver_ids =
+            fwk_mm_calloc(member_count, sizeof(group->driver_ids[0]));
+        group->values = fwk_mm_calloc(member_count, sizeof(group->values[0]));
+
+        member_idx = 0;
+        for (j = i; j < element_count; j++) {
+            if (sensor_is_in_group(&ctx_table[j], group->group_id)) {
+                group->members[member_idx] = j;
+                group->driver_ids[member_idx] = ctx_table[j].config->driver_id;
+                ctx_table[j].group = group;
+                member_idx++;
+            }
+        }
+    }
+
+    return FWK_SUCCESS;
+}
+
 static int sensor_bind(fwk_id_t id, unsigned int round)
 {
     struct sensor_dev_ctx *ctx;
@@ -449,6 +664,19 @@ static int sensor_bind(fwk_id_t id, unsigned int round)
         return FWK_E_DATA;
     }
 
+    /* All the sensors of a group are read through the same driver API */
+    if (ctx->group != NULL) {
+        if (driver->get_group_values == NULL) {
+            return FWK_E_DATA;
+        }
+
+        if (ctx->group->driver_api == NULL) {
+            ctx->group->driver_api = driver;
+        } else if (ctx->group->driver_api != driver) {
+            return FWK_E_DATA;
+        }
+    }
+
     ctx->driver_api = driver;
 
     return FWK_SUCCESS;
@@ -618,6 +846,7 @@ const struct fwk_module module_sensor = {
     .type = FWK_MODULE_TYPE_HAL,
     .init = sensor_init,
     .element_init = sensor_dev_init,
+    .post_init = sensor_post_init,
     .bind = sensor_bind,
 #ifdef BUILD_HAS_SENSOR_MULTI_AXIS
     .start = sensor_start,
@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2019-2022, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2019-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -11,7 +11,9 @@
 #include <mod_sensor.h>
 
 #include <fwk_id.h>
+#include <fwk_time.h>
 
+#include <stdbool.h>
 #include <stdint.h>
 
 /*!
@@ -37,6 +39,32 @@ struct sensor_trip_point_ctx {
     bool enabled;
 };
 
+/*
+ * Sensor group context
+ */
+struct sensor_group_ctx {
+    /* Group identifier, passed to the driver */
+    fwk_id_t group_id;
+
+    /* Driver API shared by the sensors of the group */
+    struct mod_sensor_driver_api *driver_api;
+
+    /* Number of sensors in the group */
+    unsigned int member_count;
+
+    /* Element index of each sensor of the group */
+    unsigned int *members;
+
+    /* Driver identifier of each sensor of the group */
+    fwk_id_t *driver_ids;
+
+    /* Values filled by the driver, one per sensor of the group */
+    mod_sensor_value_t *values;
+
+    /* A group reading is in progress */
+    bool reading;
+};
+
 /*
  * Sensor element context
  */
@@ -55,6 +83,12 @@ struct sensor_dev_ctx {
 
     struct mod_sensor_data last_read;
 
+    /* Group of the sensor, NULL when the sensor is read on its own */
+    struct sensor_group_ctx *group;
+
+    /* Time of the last successful reading, used with config->max_age_us */
+    fwk_timestamp_t last_read_time;
+
     unsigned int axis_count;
 
 #ifdef BUILD_HAS_SENSOR_TIMESTAMP
@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2021-2022, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2021-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -132,6 +132,12 @@ int sensor_axis_start(fwk_id_t id)
     } else {
         ctx->axis_count = 1;
     }
+
+    /* Group readings only carry scalar values */
+    if ((ctx->group != NULL) && (ctx->axis_count > 1)) {
+        return FWK_E_DATA;
+    }
+
     ctx->last_read.axis_value =
         fwk_mm_calloc(ctx->axis_count, sizeof(uint64_t));
     ctx->last_read.axis_count = ctx->axis_count;
@@ -13,6 +13,7 @@
 #include <Mockfwk_mm.h>
 #include <Mockfwk_module.h>
 #include <Mockfwk_string.h>
+#include <Mockfwk_time.h>
 #include <internal/Mockfwk_core_internal.h>
 
 #include <fwk_assert.h>
@@ -44,6 +45,17 @@ static int sensor_driver_get_value(fwk_id_t id, mod_sensor_value_t *value)
     return FWK_SUCCESS;
 }
 
+static unsigned int sensor_driver_get_value_calls;
+
+static int sensor_driver_get_value_counted(
+    fwk_id_t id,
+    mod_sensor_value_t *value)
+{
+    sensor_driver_get_value_calls++;
+    *value = FAKE_RETURN_VALUE;
+    return FWK_SUCCESS;
+}
+
 static int sensor_driver_get_info(fwk_id_t id, struct mod_sensor_info *info)
 {
     return FWK_SUCCESS;
@@ -66,6 +78,34 @@ static struct mod_sensor_driver_api sensor_driver_api = {
     .get_info = sensor_driver_get_info,
 };
 
+static struct mod_sensor_driver_api sensor_driver_api_counted = {
+    .get_value = sensor_driver_get_value_counted,
+    .get_info = sensor_driver_get_info,
+};
+
+static unsigned int sensor_driver_get_group_values_calls;
+
+static int sensor_driver_get_group_values(
+    fwk_id_t group_id,
+    const fwk_id_t *driver_ids,
+    mod_sensor_value_t *values,
+    unsigned int count)
+{
+    unsigned int i;
+
+    sensor_driver_get_group_values_calls++;
+    for (i = 0; i < count; i++) {
+        values[i] = FAKE_RETURN_VALUE + i;
+    }
+    return FWK_SUCCESS;
+}
+
+static struct mod_sensor_driver_api sensor_driver_api_group = {
+    .get_value = sensor_driver_get_value_error,
+    .get_info = sensor_driver_get_info,
+    .get_group_values = sensor_driver_get_group_values,
+};
+
 static struct mod_sensor_driver_api sensor_driver_api_error = {
     .get_value = sensor_driver_get_value_error,
     .get_info = sensor_driver_get_info_error,
@@ -188,6 +228,111 @@ void utest_sensor_dev_init_non_zero_trip_point_count(void)
     TEST_ASSERT_EQUAL(status, FWK_SUCCESS);
 }
 
+void utest_sensor_post_init_group(void)
+{
+    int status;
+    struct mod_sensor_dev_config dev_config[SENSOR_ELEMENT_COUNT];
+    struct sensor_group_ctx group;
+    unsigned int members[SENSOR_ELEMENT_COUNT];
+    fwk_id_t driver_ids[SENSOR_ELEMENT_COUNT];
+    mod_sensor_value_t values[SENSOR_ELEMENT_COUNT];
+    fwk_id_t group_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_REG_SENSOR, 0);
+    unsigned int i, j;
+
+    memset(&group, 0, sizeof(group));
+    for (i = 0; i < SENSOR_ELEMENT_COUNT; i++) {
+        dev_config[i] = *ctx_table[i].config;
+        dev_config[i].group_id = group_id;
+        ctx_table[i].config = &dev_config[i];
+    }
+
+    fwk_module_get_element_count_ExpectAndReturn(
+        fwk_module_id_sensor, SENSOR_ELEMENT_COUNT);
+
+    /* The first sensor of the group looks up the other members */
+    fwk_optional_id_is_defined_ExpectAndReturn(group_id, true);
+    for (j = 0; j < SENSOR_ELEMENT_COUNT; j++) {
+        fwk_optional_id_is_defined_ExpectAndReturn(group_id, true);
+        fwk_id_is_equal_ExpectAndReturn(group_id, group_id, true);
+    }
+
+    fwk_mm_calloc_ExpectAndReturn(
+        1, sizeof(struct sensor_group_ctx), (void *)&group);
+    fwk_mm_calloc_ExpectAndReturn(
+        SENSOR_ELEMENT_COUNT, sizeof(members[0]), (void *)members);
+    fwk_mm_calloc_ExpectAndReturn(
+        SENSOR_ELEMENT_COUNT, sizeof(driver_ids[0]), (void *)driver_ids);
+    fwk_mm_calloc_ExpectAndReturn(
+        SENSOR_ELEMENT_COUNT, sizeof(values[0]), (void *)values);
+
+    for (j = 0; j < SENSOR_ELEMENT_COUNT; j++) {
+        fwk_optional_id_is_defined_ExpectAndReturn(group_id, true);
+        fwk_id_is_equal_ExpectAndReturn(group_id, group_id, true);
+    }
+
+    /* The second sensor already belongs to the group and is skipped */
+
+    status = sensor_post_init(fwk_module_id_sensor);
+
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+    TEST_ASSERT_EQUAL_PTR(&group, ctx_table[SENSOR_FAKE_INDEX_0].group);
+    TEST_ASSERT_EQUAL_PTR(&group, ctx_table[SENSOR_FAKE_INDEX_1].group);
+    TEST_ASSERT_EQUAL(SENSOR_ELEMENT_COUNT, group.member_count);
+    TEST_ASSERT_EQUAL(SENSOR_FAKE_INDEX_0, group.members[0]);
+    TEST_ASSERT_EQUAL(SENSOR_FAKE_INDEX_1, group.members[1]);
+    TEST_ASSERT_FALSE(group.reading);
+}
+
+void utest_sensor_post_init_group_excludes_ungrouped_sensor(void)
+{
+    int status;
+    struct mod_sensor_dev_config dev_config[SENSOR_ELEMENT_COUNT];
+    struct sensor_group_ctx group;
+    unsigned int members[1];
+    fwk_id_t driver_ids[1];
+    mod_sensor_value_t values[1];
+    fwk_id_t group_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_REG_SENSOR, 0);
+    unsigned int i;
+
+    memset(&group, 0, sizeof(group));
+    for (i = 0; i < SENSOR_ELEMENT_COUNT; i++) {
+        dev_config[i] = *ctx_table[i].config;
+        ctx_table[i].config = &dev_config[i];
+    }
+    dev_config[SENSOR_FAKE_INDEX_0].group_id = group_id;
+    dev_config[SENSOR_FAKE_INDEX_1].group_id = FWK_ID_NONE;
+
+    fwk_module_get_element_count_ExpectAndReturn(
+        fwk_module_id_sensor, SENSOR_ELEMENT_COUNT);
+
+    fwk_optional_id_is_defined_ExpectAndReturn(group_id, true);
+    fwk_optional_id_is_defined_ExpectAndReturn(group_id, true);
+    fwk_id_is_equal_ExpectAndReturn(group_id, group_id, true);
+    fwk_optional_id_is_defined_ExpectAndReturn(FWK_ID_NONE, false);
+
+    fwk_mm_calloc_ExpectAndReturn(
+        1, sizeof(struct sensor_group_ctx), (void *)&group);
+    fwk_mm_calloc_ExpectAndReturn(1, sizeof(members[0]), (void *)members);
+    fwk_mm_calloc_ExpectAndReturn(
+        1, sizeof(driver_ids[0]), (void *)driver_ids);
+    fwk_mm_calloc_ExpectAndReturn(1, sizeof(values[0]), (void *)values);
+
+    fwk_optional_id_is_defined_ExpectAndReturn(group_id, true);
+    fwk_id_is_equal_ExpectAndReturn(group_id, group_id, true);
+    fwk_optional_id_is_defined_ExpectAndReturn(FWK_ID_NONE, false);
+
+    /* The second sensor has no group and is read on its own */
+    fwk_optional_id_is_defined_ExpectAndReturn(FWK_ID_NONE, false);
+
+    status = sensor_post_init(fwk_module_id_sensor);
+
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+    TEST_ASSERT_EQUAL_PTR(&group, ctx_table[SENSOR_FAKE_INDEX_0].group);
+    TEST_ASSERT_NULL(ctx_table[SENSOR_FAKE_INDEX_1].group);
+    TEST_ASSERT_EQUAL(1, group.member_count);
+    TEST_ASSERT_EQUAL(SENSOR_FAKE_INDEX_0, group.members[0]);
+}
+
 static int bind_callback_fail(
     fwk_id_t target_id,
     fwk_id_t api_id,
@@ -286,6 +431,81 @@ void utest_sensor_bind_type_mismatch_driver_bind_idx_0_success(void)
     TEST_ASSERT_EQUAL(ctx_table[SENSOR_FAKE_INDEX_1].driver_api, NULL);
 }
 
+static struct mod_sensor_driver_api *bind_driver_api;
+
+static int bind_callback_driver_api(
+    fwk_id_t target_id,
+    fwk_id_t api_id,
+    const void *api,
+    int cmock_num_calls)
+{
+    const struct mod_sensor_driver_api **sensor_api =
+        (const struct mod_sensor_driver_api **)api;
+
+    *sensor_api = bind_driver_api;
+
+    return FWK_SUCCESS;
+}
+
+void utest_sensor_bind_group_no_group_values(void)
+{
+    int status;
+    struct sensor_group_ctx group = { 0 };
+    fwk_id_t elem_id =
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_SENSOR, SENSOR_FAKE_INDEX_0);
+
+    ctx_table[SENSOR_FAKE_INDEX_0].group = &group;
+    bind_driver_api = &sensor_driver_api;
+
+    fwk_id_get_element_idx_ExpectAndReturn(elem_id, SENSOR_FAKE_INDEX_0);
+    fwk_id_is_type_ExpectAndReturn(elem_id, FWK_ID_TYPE_MODULE, false);
+
+    fwk_module_bind_StubWithCallback(bind_callback_driver_api);
+
+    status = sensor_bind(elem_id, SENSOR_ROUND_0);
+
+    TEST_ASSERT_EQUAL(FWK_E_DATA, status);
+    TEST_ASSERT_NULL(group.driver_api);
+    TEST_ASSERT_NULL(ctx_table[SENSOR_FAKE_INDEX_0].driver_api);
+}
+
+void utest_sensor_bind_group_mixed_drivers(void)
+{
+    int status;
+    struct sensor_group_ctx group = { 0 };
+    struct mod_sensor_driver_api other_driver_api = sensor_driver_api_group;
+    fwk_id_t elem_id_0 =
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_SENSOR, SENSOR_FAKE_INDEX_0);
+    fwk_id_t elem_id_1 =
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_SENSOR, SENSOR_FAKE_INDEX_1);
+
+    ctx_table[SENSOR_FAKE_INDEX_0].group = &group;
+    ctx_table[SENSOR_FAKE_INDEX_1].group = &group;
+
+    fwk_module_bind_StubWithCallback(bind_callback_driver_api);
+
+    /* The first sensor of the group selects the driver API of the group */
+    bind_driver_api = &sensor_driver_api_group;
+    fwk_id_get_element_idx_ExpectAndReturn(elem_id_0, SENSOR_FAKE_INDEX_0);
+    fwk_id_is_type_ExpectAndReturn(elem_id_0, FWK_ID_TYPE_MODULE, false);
+
+    status = sensor_bind(elem_id_0, SENSOR_ROUND_0);
+
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+    TEST_ASSERT_EQUAL_PTR(&sensor_driver_api_group, group.driver_api);
+
+    /* Another sensor of the group cannot be read through another driver */
+    bind_driver_api = &other_driver_api;
+    fwk_id_get_element_idx_ExpectAndReturn(elem_id_1, SENSOR_FAKE_INDEX_1);
+    fwk_id_is_type_ExpectAndReturn(elem_id_1, FWK_ID_TYPE_MODULE, false);
+
+    status = sensor_bind(elem_id_1, SENSOR_ROUND_0);
+
+    TEST_ASSERT_EQUAL(FWK_E_DATA, status);
+    TEST_ASSERT_EQUAL_PTR(&sensor_driver_api_group, group.driver_api);
+    TEST_ASSERT_NULL(ctx_table[SENSOR_FAKE_INDEX_1].driver_api);
+}
+
 void utest_sensor_process_module_bind_request(void)
 {
     int status;
@@ -671,6 +891,206 @@ void utest_sensor_get_data_valid_call_zero_pending_requests(void)
     TEST_ASSERT_EQUAL(status, FWK_SUCCESS);
 }
 
+void utest_sensor_get_data_max_age(void)
+{
+    int status;
+    struct mod_sensor_data returned_data;
+    struct mod_sensor_dev_config dev_config;
+    struct sensor_dev_ctx *ctx = &ctx_table[SENSOR_FAKE_INDEX_0];
+    fwk_id_t elem_id =
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_SENSOR, SENSOR_FAKE_INDEX_0);
+
+    memset(&returned_data, 0, sizeof(returned_data));
+    dev_config = *ctx->config;
+    dev_config.max_age_us = 1000;
+    ctx->config = &dev_config;
+    ctx->driver_api = &sensor_driver_api_counted;
+    sensor_driver_get_value_calls = 0;
+
+    fwk_str_memcpy_StubWithCallback(memcpy_callback);
+
+    /* First reading reaches the driver and records its time */
+    fwk_id_get_element_idx_ExpectAndReturn(elem_id, SENSOR_FAKE_INDEX_0);
+    fwk_time_current_ExpectAndReturn(FWK_US(2000));
+    fwk_time_current_ExpectAndReturn(FWK_US(2000));
+
+    status = get_data(elem_id, &returned_data);
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+    TEST_ASSERT_EQUAL(1, sensor_driver_get_value_calls);
+
+    /* Second reading within the window is served from the last reading */
+    fwk_id_get_element_idx_ExpectAndReturn(elem_id, SENSOR_FAKE_INDEX_0);
+    fwk_time_current_ExpectAndReturn(FWK_US(2500));
+
+    status = get_data(elem_id, &returned_data);
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+    TEST_ASSERT_EQUAL(FAKE_RETURN_VALUE, returned_data.value);
+    TEST_ASSERT_EQUAL(1, sensor_driver_get_value_calls);
+
+    /* Once the reading is too old the driver is queried again */
+    fwk_id_get_element_idx_ExpectAndReturn(elem_id, SENSOR_FAKE_INDEX_0);
+    fwk_time_current_ExpectAndReturn(FWK_US(3000));
+    fwk_time_current_ExpectAndReturn(FWK_US(3000));
+
+    status = get_data(elem_id, &returned_data);
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+    TEST_ASSERT_EQUAL(2, sensor_driver_get_value_calls);
+}
+
+void utest_sensor_get_data_group(void)
+{
+    int status;
+    struct mod_sensor_data returned_data;
+    unsigned int members[] = { SENSOR_FAKE_INDEX_0, SENSOR_FAKE_INDEX_1 };
+    fwk_id_t driver_ids[FWK_ARRAY_SIZE(members)];
+    mod_sensor_value_t values[FWK_ARRAY_SIZE(members)];
+    struct sensor_group_ctx group = {
+        .driver_api = &sensor_driver_api_group,
+        .member_count = FWK_ARRAY_SIZE(members),
+        .members = members,
+        .driver_ids = driver_ids,
+        .values = values,
+    };
+    fwk_id_t elem_id =
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_SENSOR, SENSOR_FAKE_INDEX_1);
+
+    memset(&returned_data, 0, sizeof(returned_data));
+    ctx_table[SENSOR_FAKE_INDEX_0].group = &group;
+    ctx_table[SENSOR_FAKE_INDEX_1].group = &group;
+    sensor_driver_get_group_values_calls = 0;
+
+    fwk_str_memcpy_StubWithCallback(memcpy_callback);
+    fwk_id_get_element_idx_ExpectAndReturn(elem_id, SENSOR_FAKE_INDEX_1);
+
+    status = get_data(elem_id, &returned_data);
+
+    /* One driver call refreshes the readings of the whole group */
+    TEST_ASSERT_EQUAL(FWK_SUCCESS, status);
+    TEST_ASSERT_EQUAL(1, sensor_driver_get_group_values_calls);
+    TEST_ASSERT_EQUAL(FAKE_RETURN_VALUE + 1, returned_data.value);
+    TEST_ASSERT_EQUAL(
+        FWK_SUCCESS, ctx_table[SENSOR_FAKE_INDEX_0].last_read.status);
+    TEST_ASSERT_EQUAL(
+        FAKE_RETURN_VALUE, ctx_table[SENSOR_FAKE_INDEX_0].last_read.value);
+}
+
+void utest_sensor_get_data_group_read_in_flight(void)
+{
+    int status;
+    struct mod_sensor_data returned_data;
+    unsigned int members[] = { SENSOR_FAKE_INDEX_0, SENSOR_FAKE_INDEX_1 };
+    fwk_id_t driver_ids[FWK_ARRAY_SIZE(members)];
+    mod_sensor_value_t values[FWK_ARRAY_SIZE(members)];
+    struct sensor_group_ctx group = {
+        .driver_api = &sensor_driver_api_group,
+        .member_count = FWK_ARRAY_SIZE(members),
+        .members = members,
+        .driver_ids = driver_ids,
+        .values = values,
+        .reading = true,
+    };
+    fwk_id_t elem_id =
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_SENSOR, SENSOR_FAKE_INDEX_1);
+
+    memset(&returned_data, 0, sizeof(returned_data));
+    ctx_table[SENSOR_FAKE_INDEX_0].group = &group;
+    ctx_table[SENSOR_FAKE_INDEX_1].group = &group;
+    ctx_table[SENSOR_FAKE_INDEX_0].concurrency_readings.pending_requests = 1;
+    sensor_driver_get_group_values_calls = 0;
+
+    fwk_id_get_element_idx_ExpectAndReturn(elem_id, SENSOR_FAKE_INDEX_1);
+    __fwk_put_event_ExpectAnyArgsAndReturn(FWK_SUCCESS);
+
+    status = get_data(elem_id, &returned_data);
+
+    /* The request waits for the group reading started by the first sensor */
+    TEST_ASSERT_EQUAL(FWK_PENDING, status);
+    TEST_ASSERT_EQUAL(0, sensor_driver_get_group_values_calls);
+    TEST_ASSERT_TRUE(group.reading);
+    TEST_ASSERT_EQUAL(
+        1,
+        ctx_table[SENSOR_FAKE_INDEX_1].concurrency_readings.pending_requests);
+}
+
+void utest_sensor_group_reading_complete(void)
+{
+    unsigned int members[] = { SENSOR_FAKE_INDEX_0, SENSOR_FAKE_INDEX_1 };
+    fwk_id_t driver_ids[FWK_ARRAY_SIZE(members)];
+    mod_sensor_value_t values[] = { FAKE_RETURN_VALUE, FAKE_RETURN_VALUE + 1 };
+    struct sensor_group_ctx group = {
+        .driver_api = &sensor_driver_api_group,
+        .member_count = FWK_ARRAY_SIZE(members),
+        .members = members,
+        .driver_ids = driver_ids,
+        .values = values,
+        .reading = true,
+    };
+    fwk_id_t elem_id =
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_SENSOR, SENSOR_FAKE_INDEX_0);
+    unsigned int i;
+
+    for (i = 0; i < FWK_ARRAY_SIZE(members); i++) {
+        ctx_table[members[i]].group = &group;
+        ctx_table[members[i]].concurrency_readings.pending_requests = 1;
+    }
+
+    fwk_id_get_module_idx_ExpectAndReturn(elem_id, FWK_MODULE_IDX_SENSOR);
+    fwk_id_get_element_idx_ExpectAndReturn(elem_id, SENSOR_FAKE_INDEX_0);
+
+    /* One read complete event per sensor of the group */
+    __fwk_put_event_ExpectAnyArgsAndReturn(FWK_SUCCESS);
+    __fwk_put_event_ExpectAnyArgsAndReturn(FWK_SUCCESS);
+
+    sensor_driver_response_api.group_reading_complete(elem_id, FWK_SUCCESS);
+
+    TEST_ASSERT_FALSE(group.reading);
+    for (i = 0; i < FWK_ARRAY_SIZE(members); i++) {
+        TEST_ASSERT_TRUE(
+            ctx_table[members[i]].concurrency_readings.dequeuing);
+        TEST_ASSERT_EQUAL(FWK_SUCCESS, ctx_table[members[i]].last_read.status);
+        TEST_ASSERT_EQUAL(values[i], ctx_table[members[i]].last_read.value);
+    }
+}
+
+void utest_sensor_group_reading_complete_no_pending_request(void)
+{
+    unsigned int members[] = { SENSOR_FAKE_INDEX_0, SENSOR_FAKE_INDEX_1 };
+    fwk_id_t driver_ids[FWK_ARRAY_SIZE(members)];
+    mod_sensor_value_t values[FWK_ARRAY_SIZE(members)];
+    struct sensor_group_ctx group = {
+        .driver_api = &sensor_driver_api_group,
+        .member_count = FWK_ARRAY_SIZE(members),
+        .members = members,
+        .driver_ids = driver_ids,
+        .values = values,
+        .reading = true,
+    };
+    fwk_id_t elem_id =
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_SENSOR, SENSOR_FAKE_INDEX_1);
+
+    ctx_table[SENSOR_FAKE_INDEX_0].group = &group;
+    ctx_table[SENSOR_FAKE_INDEX_1].group = &group;
+    ctx_table[SENSOR_FAKE_INDEX_1].concurrency_readings.pending_requests = 1;
+
+    fwk_id_get_module_idx_ExpectAndReturn(elem_id, FWK_MODULE_IDX_SENSOR);
+    fwk_id_get_element_idx_ExpectAndReturn(elem_id, SENSOR_FAKE_INDEX_1);
+
+    /* Only the sensor with a pending request is completed */
+    __fwk_put_event_ExpectAnyArgsAndReturn(FWK_SUCCESS);
+
+    sensor_driver_response_api.group_reading_complete(elem_id, FWK_E_DEVICE);
+
+    TEST_ASSERT_FALSE(group.reading);
+    TEST_ASSERT_FALSE(
+        ctx_table[SENSOR_FAKE_INDEX_0].concurrency_readings.dequeuing);
+    TEST_ASSERT_TRUE(
+        ctx_table[SENSOR_FAKE_INDEX_1].concurrency_readings.dequeuing);
+    TEST_ASSERT_EQUAL(
+        FWK_E_DEVICE, ctx_table[SENSOR_FAKE_INDEX_0].last_read.status);
+    TEST_ASSERT_EQUAL(
+        FWK_E_DEVICE, ctx_table[SENSOR_FAKE_INDEX_1].last_read.status);
+}
+
 void utest_sensor_get_info_get_ctx_if_valid_call_returns_error(void)
 {
     int status = FWK_SUCCESS;
@@ -842,11 +1262,15 @@ int sensor_test_main(void)
     RUN_TEST(utest_sensor_init);
     RUN_TEST(utest_sensor_dev_init_zero_trip_point_count);
     RUN_TEST(utest_sensor_dev_init_non_zero_trip_point_count);
+    RUN_TEST(utest_sensor_post_init_group);
+    RUN_TEST(utest_sensor_post_init_group_excludes_ungrouped_sensor);
 
     RUN_TEST(utest_sensor_bind_round_1_success);
     RUN_TEST(utest_sensor_bind_id_type_module_config_not_null);
     RUN_TEST(utest_sensor_bind_element_bind_fails);
     RUN_TEST(utest_sensor_bind_type_mismatch_driver_bind_idx_0_success);
+    RUN_TEST(utest_sensor_bind_group_no_group_values);
+    RUN_TEST(utest_sensor_bind_group_mixed_drivers);
 
     RUN_TEST(utest_sensor_process_module_bind_request);
     RUN_TEST(utest_sensor_process_bind_request_from_driver);
@@ -863,6 +1287,11 @@ int sensor_test_main(void)
     RUN_TEST(utest_sensor_get_data_not_valid);
     RUN_TEST(utest_sensor_get_data_valid_dequeue);
     RUN_TEST(utest_sensor_get_data_valid_call_zero_pending_requests);
+    RUN_TEST(utest_sensor_get_data_max_age);
+    RUN_TEST(utest_sensor_get_data_group);
+    RUN_TEST(utest_sensor_get_data_group_read_in_flight);
+    RUN_TEST(utest_sensor_group_reading_complete);
+    RUN_TEST(utest_sensor_group_reading_complete_no_pending_request);
 
     RUN_TEST(utest_sensor_get_info_get_ctx_if_valid_call_returns_error);
     RUN_TEST(utest_sensor_get_info_driver_api_get_info_returns_error);
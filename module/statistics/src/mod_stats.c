@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2020-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2020-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -52,7 +52,7 @@ static struct mod_stats_info *get_module_stats_info(fwk_id_t module_id)
     }
 
     if (fwk_id_get_module_idx(module_id) ==
-        fwk_id_get_module_idx(fwk_module_id_scmi_power_domain)) {
+        fwk_id_get_module_idx(fwk_module_id_power_domain)) {
         return stats_ctx.power_stats;
     }
 
@@ -72,7 +72,7 @@ static int set_module_stats_info(fwk_id_t module_id,
     }
 
     if (fwk_id_get_module_idx(module_id) ==
-        fwk_id_get_module_idx(fwk_module_id_scmi_power_domain)) {
+        fwk_id_get_module_idx(fwk_module_id_power_domain)) {
         stats_ctx.power_stats = stats;
         stats->type_signature = STATS_SIGN_POWR;
         ret = FWK_SUCCESS;
@@ -487,7 +487,7 @@ static void periodic_update_callback(uintptr_t param)
     update_all_domains_current_level(fwk_module_id_scmi_perf);
 
     /* Update current level stats in all tracked domains in the power module */
-    update_all_domains_current_level(fwk_module_id_scmi_power_domain);
+    update_all_domains_current_level(fwk_module_id_power_domain);
 }
 
 static int register_module_stats(fwk_id_t module_id)
@@ -589,10 +589,10 @@ static int process_bind_request(fwk_id_t source_id,
         return register_module_stats(fwk_module_id_scmi_perf);
     }
 
-    /* Request from SCMI Power domain statistics*/
+    /* Request from Power domain statistics */
     if (fwk_id_get_module_idx(source_id) ==
-        fwk_id_get_module_idx(fwk_module_id_scmi_power_domain)) {
-        return register_module_stats(fwk_module_id_scmi_power_domain);
+        fwk_id_get_module_idx(fwk_module_id_power_domain)) {
+        return register_module_stats(fwk_module_id_power_domain);
     }
 
     return FWK_E_PARAM;
@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2022-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2022-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -58,6 +58,25 @@ struct mod_transport_buffer {
     uint32_t payload[];
 };
 
+/*!
+ * \brief Header of an out-band message ring.
+ *
+ * \details The header is followed by the slots of the ring. Each slot is a
+ *      mailbox of `out_band_mailbox_size` bytes starting with a
+ *      ::mod_transport_buffer, and is owned by the requester or the completer
+ *      according to its status like a single out-band mailbox. The indices
+ *      are free-running: the slot of a message is its index modulo the
+ *      number of slots.
+ */
+struct mod_transport_ring {
+    /*! Index of the next message to be posted, written by the requester */
+    volatile uint32_t producer_index;
+    /*! Index of the next message to be completed, written by the completer */
+    volatile uint32_t consumer_index;
+    /*! Reserved fields, must be zero */
+    uint32_t reserved[2];
+};
+
 /*! Interrupt mode enable flag position */
 #define MOD_TRANSPORT_FLAGS_IENABLED_POS 0
 /*! Interrupt mode enable bit mask */
@@ -85,6 +104,19 @@ struct mod_transport_buffer {
  */
 #define MOD_TRANSPORT_POLICY_INIT_MAILBOX ((uint32_t)(1U << 1))
 
+/*!
+ * Messages are handled in place in the shared mailbox: the payload of a
+ * received message is read directly from the mailbox and the response is
+ * written directly to it, instead of going through the local read and write
+ * buffers. Only relevant for out-band and out-band ring type transport
+ * channels.
+ *
+ * \note As the request and the response share the same memory, the services
+ *      bound to the channel must have read all the parameters of a message
+ *      before writing any part of its response.
+ */
+#define MOD_TRANSPORT_POLICY_ZERO_COPY ((uint32_t)(1U << 2))
+
 /*!
  * @}
  */
@@ -114,6 +146,9 @@ enum mod_transport_channel_transport_type {
 #ifdef BUILD_HAS_OUTBAND_MSG_SUPPORT
     /*! Out-band transport - SMT */
     MOD_TRANSPORT_CHANNEL_TRANSPORT_TYPE_OUT_BAND,
+
+    /*! Out-band transport - Ring of SMT mailboxes */
+    MOD_TRANSPORT_CHANNEL_TRANSPORT_TYPE_OUT_BAND_RING,
 #endif
 
 #ifdef BUILD_HAS_INBAND_MSG_SUPPORT
@@ -200,16 +235,24 @@ struct mod_transport_channel_config {
 
     /*!
      * Out-band shared mailbox address. Only relevant for out-band
-     * transport type.
+     * transport type. For the out-band ring transport type, address of the
+     * ::mod_transport_ring header.
      */
     uintptr_t out_band_mailbox_address;
 
     /*!
      * Out-band shared mailbox size in bytes. Only relevant for out-band
-     * transport type.
+     * transport type. For the out-band ring transport type, size of each
+     * slot of the ring, which must be a multiple of 8 bytes.
      */
     size_t out_band_mailbox_size;
 
+    /*!
+     * Number of slots of the ring, which must be a power of two. Only
+     * relevant for out-band ring transport type.
+     */
+    unsigned int ring_slot_count;
+
     /*!
      * Internal read & write mailbox size in bytes. Only relevant for
      * in-band transport type.
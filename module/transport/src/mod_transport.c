@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2022-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2022-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -58,6 +58,27 @@ struct transport_channel_ctx {
     /* Maximum payload size of the channel */
     size_t max_payload_size;
 
+    /* Payload size of the message being processed, as verified */
+    size_t payload_size;
+
+#if defined(BUILD_HAS_OUTBAND_MSG_SUPPORT)
+    /*
+     * Flag indicating the read and write buffers are the shared mailbox
+     * itself (MOD_TRANSPORT_POLICY_ZERO_COPY)
+     */
+    bool zero_copy;
+
+    /*
+     * Ring index of the message being processed or to be processed next.
+     * On a completer channel this is the consumer index of the ring, on a
+     * requester channel the index of the next response to be read.
+     */
+    uint32_t ring_index;
+
+    /* Flag indicating a completed ring message requested an interrupt */
+    bool ring_event_pending;
+#endif
+
     /* Service bound to the channel */
     fwk_id_t service_id;
 
@@ -97,6 +118,103 @@ struct transport_context {
 
 static struct transport_context transport_ctx;
 
+static int transport_message_handler(struct transport_channel_ctx *channel_ctx);
+
+#if defined(BUILD_HAS_OUTBAND_MSG_SUPPORT)
+/*
+ * Out-band helpers
+ */
+static bool transport_is_out_band(
+    const struct transport_channel_ctx *channel_ctx)
+{
+    return (channel_ctx->config->transport_type ==
+            MOD_TRANSPORT_CHANNEL_TRANSPORT_TYPE_OUT_BAND) ||
+        (channel_ctx->config->transport_type ==
+         MOD_TRANSPORT_CHANNEL_TRANSPORT_TYPE_OUT_BAND_RING);
+}
+
+static bool transport_is_ring(const struct transport_channel_ctx *channel_ctx)
+{
+    return channel_ctx->config->transport_type ==
+        MOD_TRANSPORT_CHANNEL_TRANSPORT_TYPE_OUT_BAND_RING;
+}
+
+static struct mod_transport_ring *transport_get_ring(
+    const struct transport_channel_ctx *channel_ctx)
+{
+    return (struct mod_transport_ring *)
+        channel_ctx->config->out_band_mailbox_address;
+}
+
+/*
+ * Get the shared mailbox holding the message of a given ring index. Out-band
+ * channels have a single mailbox and ignore the index.
+ */
+static struct mod_transport_buffer *transport_get_shared_mailbox(
+    const struct transport_channel_ctx *channel_ctx,
+    uint32_t ring_index)
+{
+    uintptr_t slot_address;
+    uint32_t slot;
+
+    if (!transport_is_ring(channel_ctx)) {
+        return (struct mod_transport_buffer *)
+            channel_ctx->config->out_band_mailbox_address;
+    }
+
+    slot = ring_index & (channel_ctx->config->ring_slot_count - 1U);
+    slot_address = channel_ctx->config->out_band_mailbox_address +
+        sizeof(struct mod_transport_ring) +
+        ((uintptr_t)slot * channel_ctx->config->out_band_mailbox_size);
+
+    return (struct mod_transport_buffer *)slot_address;
+}
+
+/* Check whether a ring has a message waiting to be processed */
+static bool transport_ring_has_message(
+    const struct transport_channel_ctx *channel_ctx)
+{
+    const struct mod_transport_ring *ring = transport_get_ring(channel_ctx);
+
+    if (channel_ctx->config->channel_type ==
+        MOD_TRANSPORT_CHANNEL_TYPE_COMPLETER) {
+        return ring->producer_index != channel_ctx->ring_index;
+    }
+
+    return ring->consumer_index != channel_ctx->ring_index;
+}
+
+/*
+ * Recover a completer ring the requester has posted too many messages to. The
+ * oldest messages have been overwritten by newer ones and cannot be answered:
+ * they are dropped by moving the consumer index past them, and the messages
+ * still held by the slots are processed.
+ */
+static void transport_ring_resync(struct transport_channel_ctx *channel_ctx)
+{
+    struct mod_transport_ring *ring = transport_get_ring(channel_ctx);
+    uint32_t producer_index = ring->producer_index;
+    uint32_t slot_count = channel_ctx->config->ring_slot_count;
+    unsigned int dropped_count;
+
+    if ((producer_index - channel_ctx->ring_index) <= slot_count) {
+        return;
+    }
+
+    dropped_count =
+        (unsigned int)(producer_index - slot_count - channel_ctx->ring_index);
+
+    FWK_LOG_ERR(
+        "%s Ring overflow on completer channel %u, %u messages dropped",
+        MOD_NAME,
+        fwk_id_get_element_idx(channel_ctx->id),
+        dropped_count);
+
+    channel_ctx->ring_index = producer_index - slot_count;
+    ring->consumer_index = channel_ctx->ring_index;
+}
+#endif
+
 /*
  * SCMI module Transport API
  */
@@ -186,7 +304,7 @@ static int transport_get_payload(
 
     *payload = channel_ctx->in->payload;
 
-    *size = channel_ctx->in->length - sizeof(channel_ctx->in->message_header);
+    *size = channel_ctx->payload_size;
 
     return FWK_SUCCESS;
 }
@@ -241,23 +359,33 @@ static int transport_respond(
     fwk_assert(transport_type != MOD_TRANSPORT_CHANNEL_TRANSPORT_TYPE_NONE);
 
 #if defined(BUILD_HAS_OUTBAND_MSG_SUPPORT)
-    if (transport_type == MOD_TRANSPORT_CHANNEL_TRANSPORT_TYPE_OUT_BAND) {
+    if (transport_is_out_band(channel_ctx)) {
         /* Use shared mailbox for out-band messages */
-        buffer = ((struct mod_transport_buffer *)
-                      channel_ctx->config->out_band_mailbox_address);
+        buffer = transport_get_shared_mailbox(
+            channel_ctx, channel_ctx->ring_index);
 
-        /* Copy the header and other fields from the write buffer */
-        fwk_str_memcpy(
-            buffer, channel_ctx->out, sizeof(struct mod_transport_buffer));
+        if (channel_ctx->zero_copy) {
+            /*
+             * The header and any payload already written are in place, only
+             * the payload parameter has to be copied.
+             */
+            if (payload != NULL) {
+                fwk_str_memcpy(buffer->payload, payload, size);
+            }
+        } else {
+            /* Copy the header and other fields from the write buffer */
+            fwk_str_memcpy(
+                buffer, channel_ctx->out, sizeof(struct mod_transport_buffer));
 
-        /*
-         * Copy the payload from either the write buffer or the payload
-         * parameter.
-         */
-        fwk_str_memcpy(
-            buffer->payload,
-            (payload == NULL ? channel_ctx->out->payload : payload),
-            size);
+            /*
+             * Copy the payload from either the write buffer or the payload
+             * parameter.
+             */
+            fwk_str_memcpy(
+                buffer->payload,
+                (payload == NULL ? channel_ctx->out->payload : payload),
+                size);
+        }
     }
 #else
 #    if defined(BUILD_HAS_INBAND_MSG_SUPPORT)
@@ -286,6 +414,14 @@ static int transport_respond(
      * period anyway, but this guard is included to protect against a
      * misbehaving agent.
      */
+#if defined(BUILD_HAS_OUTBAND_MSG_SUPPORT)
+    /* The slot must not be accessed once it is handed back to the requester */
+    if (transport_is_ring(channel_ctx) &&
+        ((buffer->flags & MOD_TRANSPORT_MAILBOX_FLAGS_IENABLED_MASK) != 0)) {
+        channel_ctx->ring_event_pending = true;
+    }
+#endif
+
     flags = fwk_interrupt_global_disable();
 
     channel_ctx->locked = false;
@@ -293,8 +429,37 @@ static int transport_respond(
     /* The mailbox status is relevant for out-band transport only */
     buffer->status |= MOD_TRANSPORT_MAILBOX_STATUS_FREE_MASK;
 
+#if defined(BUILD_HAS_OUTBAND_MSG_SUPPORT)
+    if (transport_is_ring(channel_ctx)) {
+        /* Hand the slot back to the requester */
+        transport_get_ring(channel_ctx)->consumer_index =
+            ++channel_ctx->ring_index;
+    }
+#endif
+
     fwk_interrupt_global_enable(flags);
 
+#if defined(BUILD_HAS_OUTBAND_MSG_SUPPORT)
+    if (transport_is_ring(channel_ctx)) {
+        /*
+         * Process the messages posted in the meantime without waiting for a
+         * doorbell. The requester is only interrupted once the ring has been
+         * drained, for all the messages completed in the batch.
+         */
+        if (transport_ring_has_message(channel_ctx)) {
+            return transport_message_handler(channel_ctx);
+        }
+
+        if (channel_ctx->ring_event_pending) {
+            channel_ctx->ring_event_pending = false;
+            status = channel_ctx->driver_api->trigger_event(
+                channel_ctx->config->driver_id);
+        }
+
+        return status;
+    }
+#endif
+
 #if defined(BUILD_HAS_INBAND_MSG_SUPPORT)
     if (transport_type == MOD_TRANSPORT_CHANNEL_TRANSPORT_TYPE_IN_BAND) {
         /* Send the response message using driver module API */
@@ -326,6 +491,10 @@ static int transport_transmit(
     struct mod_transport_buffer *buffer = NULL;
 #if defined(BUILD_HAS_INBAND_MSG_SUPPORT)
     int status;
+#endif
+#if defined(BUILD_HAS_OUTBAND_MSG_SUPPORT)
+    struct mod_transport_ring *ring = NULL;
+    uint32_t ring_index = 0;
 #endif
     enum mod_transport_channel_transport_type transport_type;
 
@@ -337,10 +506,20 @@ static int transport_transmit(
     fwk_assert(transport_type != MOD_TRANSPORT_CHANNEL_TRANSPORT_TYPE_NONE);
 
 #if defined(BUILD_HAS_OUTBAND_MSG_SUPPORT)
-    if (transport_type == MOD_TRANSPORT_CHANNEL_TRANSPORT_TYPE_OUT_BAND) {
+    if (transport_is_out_band(channel_ctx)) {
+        if (transport_is_ring(channel_ctx)) {
+            ring = transport_get_ring(channel_ctx);
+            ring_index = ring->producer_index;
+
+            /* All the slots hold messages whose response is yet to be read */
+            if ((ring_index - channel_ctx->ring_index) >=
+                channel_ctx->config->ring_slot_count) {
+                return FWK_E_BUSY;
+            }
+        }
+
         /* Use shared mailbox for out-band messages */
-        buffer = ((struct mod_transport_buffer *)
-                      channel_ctx->config->out_band_mailbox_address);
+        buffer = transport_get_shared_mailbox(channel_ctx, ring_index);
         /*
          * If the agent/platform has not yet read the previous message we
          * abandon this transmission. We don't want to poll on the BUSY/FREE
@@ -391,6 +570,13 @@ static int transport_transmit(
     /* The mailbox status is relevant for out-band transport only */
     buffer->status &= ~MOD_TRANSPORT_MAILBOX_STATUS_FREE_MASK;
 
+#if defined(BUILD_HAS_OUTBAND_MSG_SUPPORT)
+    if (ring != NULL) {
+        /* Post the message once its slot is complete */
+        ring->producer_index = ring_index + 1U;
+    }
+#endif
+
 #if defined(BUILD_HAS_INBAND_MSG_SUPPORT)
     /* Send the SCMI message using driver module API */
     status = channel_ctx->driver_api->send_message(
@@ -423,6 +609,21 @@ static int transport_release_channel_lock(fwk_id_t channel_id)
      * transport_respond() function that releases the channel context.
      */
     channel_ctx->locked = false;
+
+#if defined(BUILD_HAS_OUTBAND_MSG_SUPPORT)
+    if (transport_is_ring(channel_ctx) &&
+        (channel_ctx->config->channel_type ==
+         MOD_TRANSPORT_CHANNEL_TYPE_REQUESTER)) {
+        /* The response has been read, its slot can be used again */
+        channel_ctx->ring_index++;
+
+        /* Process the responses received in the meantime */
+        if (transport_ring_has_message(channel_ctx)) {
+            return transport_message_handler(channel_ctx);
+        }
+    }
+#endif
+
     return FWK_SUCCESS;
 }
 
@@ -589,26 +790,45 @@ static int transport_message_handler(struct transport_channel_ctx *channel_ctx)
     struct mod_transport_buffer *in, *out;
     int status;
 
+    uint32_t length;
+
 #if defined(BUILD_HAS_OUTBAND_MSG_SUPPORT)
     struct mod_transport_buffer *shared_memory;
-    size_t payload_size;
 #endif
 
-    enum mod_transport_channel_transport_type transport_type;
+#if defined(BUILD_HAS_OUTBAND_MSG_SUPPORT)
+    if (transport_is_ring(channel_ctx)) {
+        /*
+         * The messages of a ring are processed one after the other. Once the
+         * message being processed is complete, the next ones are processed
+         * without waiting for another doorbell.
+         */
+        if (channel_ctx->locked || !transport_ring_has_message(channel_ctx)) {
+            return FWK_SUCCESS;
+        }
+
+        if (channel_ctx->config->channel_type ==
+            MOD_TRANSPORT_CHANNEL_TYPE_COMPLETER) {
+            transport_ring_resync(channel_ctx);
+        }
+    }
+#endif
 
     /* Check if we are already processing */
     if (channel_ctx->locked) {
         return FWK_E_STATE;
     }
 
-    in = channel_ctx->in;
-    out = channel_ctx->out;
-
-    transport_type = channel_ctx->config->transport_type;
 #if defined(BUILD_HAS_OUTBAND_MSG_SUPPORT)
-    if (transport_type == MOD_TRANSPORT_CHANNEL_TRANSPORT_TYPE_OUT_BAND) {
-        shared_memory = ((struct mod_transport_buffer *)
-                             channel_ctx->config->out_band_mailbox_address);
+    if (transport_is_out_band(channel_ctx)) {
+        shared_memory = transport_get_shared_mailbox(
+            channel_ctx, channel_ctx->ring_index);
+
+        if (channel_ctx->zero_copy) {
+            /* Read and answer the message in place */
+            channel_ctx->in = shared_memory;
+            channel_ctx->out = shared_memory;
+        }
 
         if (channel_ctx->config->channel_type ==
             MOD_TRANSPORT_CHANNEL_TYPE_COMPLETER) {
@@ -651,11 +871,19 @@ static int transport_message_handler(struct transport_channel_ctx *channel_ctx)
          * Copy the contents from shared mailbox to internal read buffer.
          * note: payload is not copied yet.
          */
-        fwk_str_memcpy(in, shared_memory, sizeof(struct mod_transport_buffer));
+        if (!channel_ctx->zero_copy) {
+            fwk_str_memcpy(
+                channel_ctx->in,
+                shared_memory,
+                sizeof(struct mod_transport_buffer));
+        }
     }
 
 #endif
 
+    in = channel_ctx->in;
+    out = channel_ctx->out;
+
     /*
      * Set the channel context as locked until the bound service completes
      * processing the message.
@@ -663,14 +891,17 @@ static int transport_message_handler(struct transport_channel_ctx *channel_ctx)
     channel_ctx->locked = true;
 
 #if defined(BUILD_HAS_INBAND_MSG_SUPPORT)
-    if (transport_type == MOD_TRANSPORT_CHANNEL_TRANSPORT_TYPE_IN_BAND) {
+    if (channel_ctx->config->transport_type ==
+        MOD_TRANSPORT_CHANNEL_TRANSPORT_TYPE_IN_BAND) {
         /* get the message from the driver */
         channel_ctx->driver_api->get_message(
             in, channel_ctx->config->driver_id);
     }
 #endif
     /* mirror contents in the read & write buffers (Payload not copied) */
-    fwk_str_memcpy(out, in, sizeof(struct mod_transport_buffer));
+    if (out != in) {
+        fwk_str_memcpy(out, in, sizeof(struct mod_transport_buffer));
+    }
 
     /* Ensure error bit is not set */
     out->status &= ~MOD_TRANSPORT_MAILBOX_STATUS_ERROR_MASK;
@@ -683,8 +914,9 @@ static int transport_message_handler(struct transport_channel_ctx *channel_ctx)
      *
      * Note: the payload size is permitted to be of size zero.
      */
-    if ((in->length < sizeof(in->message_header)) ||
-        ((in->length - sizeof(in->message_header)) >
+    length = in->length;
+    if ((length < sizeof(in->message_header)) ||
+        ((length - sizeof(in->message_header)) >
          channel_ctx->max_payload_size)) {
         out->status |= MOD_TRANSPORT_MAILBOX_STATUS_ERROR_MASK;
 
@@ -703,17 +935,26 @@ static int transport_message_handler(struct transport_channel_ctx *channel_ctx)
                 channel_ctx->transport_signal.firmware_signal_api->signal_error(
                     channel_ctx->service_id);
         }
+
+        /* The message has been dropped, nothing else to do */
+        return status;
     }
 
-#if defined(BUILD_HAS_OUTBAND_MSG_SUPPORT)
-    if (transport_type == MOD_TRANSPORT_CHANNEL_TRANSPORT_TYPE_OUT_BAND) {
-        shared_memory = ((struct mod_transport_buffer *)
-                             channel_ctx->config->out_band_mailbox_address);
+    /*
+     * The length is read only once so that the payload size given to the
+     * bound service is the one verified above, even if the payload is read
+     * in place.
+     */
+    channel_ctx->payload_size = length - sizeof(in->message_header);
 
-        payload_size = in->length - sizeof(in->message_header);
-        if (payload_size != 0) {
+#if defined(BUILD_HAS_OUTBAND_MSG_SUPPORT)
+    if (transport_is_out_band(channel_ctx) && !channel_ctx->zero_copy) {
+        if (channel_ctx->payload_size != 0) {
             /* Copy payload from shared memory to read buffer */
-            fwk_str_memcpy(in->payload, shared_memory->payload, payload_size);
+            fwk_str_memcpy(
+                in->payload,
+                shared_memory->payload,
+                channel_ctx->payload_size);
         }
     }
 #endif
@@ -769,8 +1010,7 @@ static int transport_signal_message(fwk_id_t channel_id)
     }
 
 #if defined(BUILD_HAS_OUTBAND_MSG_SUPPORT)
-    if (channel_ctx->config->transport_type ==
-        MOD_TRANSPORT_CHANNEL_TRANSPORT_TYPE_OUT_BAND) {
+    if (transport_is_out_band(channel_ctx)) {
         if (!channel_ctx->out_band_mailbox_ready) {
             /* Discard any message in the mailbox when not ready */
             FWK_LOG_ERR("%s Out-band message not valid", MOD_NAME);
@@ -790,20 +1030,42 @@ static const struct mod_transport_driver_input_api driver_input_api = {
 static int transport_mailbox_init(struct transport_channel_ctx *channel_ctx)
 {
     int status = FWK_SUCCESS;
+    uint32_t slot_count = 1;
+    uint32_t slot;
+    size_t mailbox_offset = 0;
 
     if ((channel_ctx->config->policies & MOD_TRANSPORT_POLICY_INIT_MAILBOX) !=
         (uint32_t)0) {
         unsigned int notifications_sent;
 
+#if defined(BUILD_HAS_OUTBAND_MSG_SUPPORT)
+        if (transport_is_ring(channel_ctx)) {
+            slot_count = channel_ctx->config->ring_slot_count;
+            mailbox_offset = sizeof(struct mod_transport_ring);
+            channel_ctx->ring_index = 0;
+            channel_ctx->ring_event_pending = false;
+        }
+#endif
+
         /* Only the completer channel should initialize the shared mailbox */
         if (channel_ctx->config->channel_type ==
             MOD_TRANSPORT_CHANNEL_TYPE_COMPLETER) {
-            /* Initialize mailbox such that the requester has ownership */
-            *((struct mod_transport_buffer *)
-                  channel_ctx->config->out_band_mailbox_address) =
-                (struct mod_transport_buffer){
-                    .status = (1U << MOD_TRANSPORT_MAILBOX_STATUS_FREE_POS)
-                };
+#if defined(BUILD_HAS_OUTBAND_MSG_SUPPORT)
+            if (transport_is_ring(channel_ctx)) {
+                *transport_get_ring(channel_ctx) =
+                    (struct mod_transport_ring){ 0 };
+            }
+#endif
+
+            /* Initialize mailboxes such that the requester has ownership */
+            for (slot = 0; slot < slot_count; slot++) {
+                *((struct mod_transport_buffer *)(channel_ctx->config
+                        ->out_band_mailbox_address + mailbox_offset)) =
+                    (struct mod_transport_buffer){
+                        .status = (1U << MOD_TRANSPORT_MAILBOX_STATUS_FREE_POS)
+                    };
+                mailbox_offset += channel_ctx->config->out_band_mailbox_size;
+            }
         }
         /* Notify that this mailbox is initialized */
         struct fwk_event transport_channel_initialized_notification = {
@@ -856,13 +1118,23 @@ static int transport_channel_init(
 
 #if defined(BUILD_HAS_OUTBAND_MSG_SUPPORT)
     /* Validate out-band mailbox address and size */
-    if ((channel_ctx->config->transport_type ==
-         MOD_TRANSPORT_CHANNEL_TRANSPORT_TYPE_OUT_BAND) &&
+    if (transport_is_out_band(channel_ctx) &&
         ((channel_ctx->config->out_band_mailbox_address == 0) ||
          (channel_ctx->config->out_band_mailbox_size == 0))) {
         fwk_unexpected();
         return FWK_E_DATA;
     }
+
+    /* Validate the ring geometry */
+    if (transport_is_ring(channel_ctx) &&
+        ((channel_ctx->config->ring_slot_count == 0) ||
+         ((channel_ctx->config->ring_slot_count &
+           (channel_ctx->config->ring_slot_count - 1U)) != 0) ||
+         ((channel_ctx->config->out_band_mailbox_size % sizeof(uint64_t)) !=
+          0))) {
+        fwk_unexpected();
+        return FWK_E_DATA;
+    }
 #endif
 
 #if defined(BUILD_HAS_INBAND_MSG_SUPPORT)
@@ -879,10 +1151,20 @@ static int transport_channel_init(
     switch (channel_ctx->config->transport_type) {
 #if defined(BUILD_HAS_OUTBAND_MSG_SUPPORT)
     case MOD_TRANSPORT_CHANNEL_TRANSPORT_TYPE_OUT_BAND:
-        channel_ctx->in =
-            fwk_mm_alloc(1, channel_ctx->config->out_band_mailbox_size);
-        channel_ctx->out =
-            fwk_mm_alloc(1, channel_ctx->config->out_band_mailbox_size);
+    case MOD_TRANSPORT_CHANNEL_TRANSPORT_TYPE_OUT_BAND_RING:
+        channel_ctx->zero_copy =
+            ((channel_ctx->config->policies & MOD_TRANSPORT_POLICY_ZERO_COPY) !=
+             (uint32_t)0);
+        if (channel_ctx->zero_copy) {
+            /* Messages are read and answered in place */
+            channel_ctx->in = transport_get_shared_mailbox(channel_ctx, 0);
+            channel_ctx->out = channel_ctx->in;
+        } else {
+            channel_ctx->in =
+                fwk_mm_alloc(1, channel_ctx->config->out_band_mailbox_size);
+            channel_ctx->out =
+                fwk_mm_alloc(1, channel_ctx->config->out_band_mailbox_size);
+        }
         channel_ctx->max_payload_size =
             channel_ctx->config->out_band_mailbox_size -
             sizeof(struct mod_transport_buffer);
@@ -1085,8 +1367,7 @@ static int transport_start(fwk_id_t id)
     config = channel_ctx->config;
     channel_ctx->wait_on_notifications = 0;
 
-    if (channel_ctx->config->transport_type ==
-        MOD_TRANSPORT_CHANNEL_TRANSPORT_TYPE_OUT_BAND) {
+    if (transport_is_out_band(channel_ctx)) {
 #ifdef BUILD_HAS_MOD_POWER_DOMAIN
         if (fwk_id_type_is_valid(channel_ctx->config->pd_source_id)) {
             /* Register for power domain state transition notifications */
@@ -0,0 +1,89 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2024, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "clock_soc.h"
+#include "tc2_amu.h"
+#include "tc2_dvfs.h"
+
+#include <mod_amu_mmap.h>
+#include <mod_perf_governor.h>
+
+#include <fwk_element.h>
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+
+enum cpu_idx {
+    CORE0_IDX,
+    CORE1_IDX,
+    CORE2_IDX,
+    CORE3_IDX,
+    HAYES_CORE_COUNT,
+};
+
+static const struct mod_perf_gov_core_config
+    hayes_core_config[HAYES_CORE_COUNT] = {
+    [CORE0_IDX] = {
+        .pd_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_POWER_DOMAIN, CORE0_IDX),
+        .core_starts_online = true,
+        .cycle_counter_id = FWK_ID_SUB_ELEMENT_INIT(
+            FWK_MODULE_IDX_AMU_MMAP, CORE0_IDX, HUNTER_AMEVCNTR0_CORE),
+    },
+    [CORE1_IDX] = {
+        .pd_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_POWER_DOMAIN, CORE1_IDX),
+        .core_starts_online = false,
+        .cycle_counter_id = FWK_ID_SUB_ELEMENT_INIT(
+            FWK_MODULE_IDX_AMU_MMAP, CORE1_IDX, HUNTER_AMEVCNTR0_CORE),
+    },
+    [CORE2_IDX] = {
+        .pd_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_POWER_DOMAIN, CORE2_IDX),
+        .core_starts_online = false,
+        .cycle_counter_id = FWK_ID_SUB_ELEMENT_INIT(
+            FWK_MODULE_IDX_AMU_MMAP, CORE2_IDX, HUNTER_AMEVCNTR0_CORE),
+    },
+    [CORE3_IDX] = {
+        .pd_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_POWER_DOMAIN, CORE3_IDX),
+        .core_starts_online = false,
+        .cycle_counter_id = FWK_ID_SUB_ELEMENT_INIT(
+            FWK_MODULE_IDX_AMU_MMAP, CORE3_IDX, HUNTER_AMEVCNTR0_CORE),
+    },
+};
+
+static const struct mod_perf_gov_domain_config hayes_domain_config = {
+    .perf_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_DVFS, DVFS_ELEMENT_IDX_HAYES),
+    .core_config = hayes_core_config,
+    .up_threshold = 80,
+    .down_threshold = 40,
+    .ramp_up = MOD_PERF_GOV_RAMP_PROPORTIONAL,
+    .ramp_down = MOD_PERF_GOV_RAMP_STEP,
+};
+
+static const struct fwk_element element_table[2] = {
+    [0] = {
+        .name = "PGOV_HAYES",
+        .sub_element_count = HAYES_CORE_COUNT,
+        .data = &hayes_domain_config,
+    },
+    [1] = { 0 },
+};
+
+static const struct fwk_element *pgov_get_element_table(fwk_id_t module_id)
+{
+    return element_table;
+}
+
+const struct fwk_module_config config_perf_governor = {
+    .data = &((struct mod_perf_gov_config){
+        .amu_api_id = FWK_ID_API_INIT(
+            FWK_MODULE_IDX_AMU_MMAP,
+            MOD_AMU_MMAP_API_IDX_AMU),
+        /* The AMU constant counter runs at the reference clock rate */
+        .const_counter_freq = CLOCK_RATE_REFCLK,
+    }),
+    .elements = FWK_MODULE_DYNAMIC_ELEMENTS(pgov_get_element_table),
+};
@@ -1,6 +1,6 @@
 /*
  * Arm SCP/MCP Software
- * Copyright (c) 2022-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2022-2024, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -144,6 +144,10 @@ static const struct mod_scmi_plugin_config plugins_table[] = {
         .id = FWK_ID_MODULE_INIT(FWK_MODULE_IDX_THERMAL_MGMT),
         .dom_type = PERF_PLUGIN_DOM_TYPE_FULL,
     },
+    [3] = {
+        .id = FWK_ID_MODULE_INIT(FWK_MODULE_IDX_PERF_GOVERNOR),
+        .dom_type = PERF_PLUGIN_DOM_TYPE_PHYSICAL,
+    },
 };
 #endif
 